@@ -10,6 +10,24 @@
 #include <freertos/semphr.h>
 #include "posthog/parsers/InsightParser.h"
 
+/**
+ * @brief Compile-time switch for event bus tracing
+ *
+ * Set -DEVENT_QUEUE_TRACING=1 in build_flags to record enqueue timestamps,
+ * per-callback execution times, queue high-water mark and drop counts.
+ * When 0 (the default) none of the tracing code or fields are compiled in.
+ */
+#ifndef EVENT_QUEUE_TRACING
+#define EVENT_QUEUE_TRACING 0
+#endif
+
+/**
+ * @brief Interval for the periodic serial trace dump in milliseconds (0 disables)
+ */
+#ifndef EVENT_QUEUE_TRACE_DUMP_INTERVAL_MS
+#define EVENT_QUEUE_TRACE_DUMP_INTERVAL_MS 30000
+#endif
+
 /**
  * @brief Event types in the system
  */
@@ -37,6 +55,9 @@ struct Event {
     std::shared_ptr<InsightParser> parser;  // Optional parsed insight data
     String jsonData;                        // Raw JSON data for insights
     String title;                           // Title/name for card title updates
+#if EVENT_QUEUE_TRACING
+    uint32_t enqueuedAtUs = 0;              // micros() when the event entered the queue
+#endif
     
     Event() {}
     
@@ -63,6 +84,32 @@ struct Event {
  */
 using EventCallback = std::function<void(const Event&)>;
 
+#if EVENT_QUEUE_TRACING
+/**
+ * @brief One processed event as recorded in the trace ring buffer
+ */
+struct EventTraceRecord {
+    EventType type;           // Type of the processed event
+    uint32_t waitUs;          // Time between enqueue and dequeue
+    uint32_t dispatchUs;      // Total time spent in all callbacks
+    uint32_t slowestUs;       // Time spent in the slowest callback
+    uint8_t slowestCallback;  // Subscription index of the slowest callback
+    uint8_t depthAtDequeue;   // Events still waiting when this one was dequeued
+};
+
+/**
+ * @brief Execution-time histogram for a single subscribed callback
+ *
+ * Buckets are upper bounds in microseconds, see EventQueue::TRACE_BUCKET_LIMITS_US.
+ */
+struct CallbackTraceStats {
+    uint32_t buckets[8];      // Invocation counts per duration bucket
+    uint32_t calls;           // Total invocations
+    uint32_t maxUs;           // Slowest invocation seen
+    uint64_t totalUs;         // Sum of all invocation times
+};
+#endif
+
 /**
  * @brief Thread-safe event queue for handling system events
  */
@@ -75,6 +122,29 @@ private:
     static void eventProcessingTask(void* parameter);
     TaskHandle_t taskHandle;
     bool isRunning;
+
+#if EVENT_QUEUE_TRACING
+    static const size_t TRACE_RING_SIZE = 32;          // Processed events kept in the ring buffer
+    static const size_t MAX_TRACED_CALLBACKS = 16;     // Subscriptions with their own histogram
+    static const size_t TRACE_BUCKET_COUNT = 8;
+    static const uint32_t TRACE_BUCKET_LIMITS_US[TRACE_BUCKET_COUNT];
+
+    mutable portMUX_TYPE traceLock;                    // Guards all trace state below
+    size_t queueCapacity;                              // Capacity the queue was created with
+    uint32_t publishedCount;                           // Events accepted by the queue
+    uint32_t droppedCount;                             // Events rejected because the queue was full
+    uint32_t highWaterMark;                            // Deepest queue depth observed
+    EventTraceRecord traceRing[TRACE_RING_SIZE];       // Most recent processed events
+    size_t traceHead;                                  // Next write position in traceRing
+    size_t traceCount;                                 // Valid records in traceRing
+    CallbackTraceStats callbackStats[MAX_TRACED_CALLBACKS];
+    uint32_t lastTraceDumpMs;
+
+    void recordPublish(bool accepted);
+    void recordCallback(size_t index, uint32_t durationUs);
+    void recordProcessed(const EventTraceRecord& record);
+    static size_t bucketFor(uint32_t durationUs);
+#endif
     
 public:
     EventQueue(size_t queueSize = 10);
@@ -137,4 +207,30 @@ public:
      * @brief Stop the event processing task
      */
     void end();
+
+    /**
+     * @brief Number of events waiting to be processed
+     */
+    size_t getQueueDepth() const { return eventQueue ? uxQueueMessagesWaiting(eventQueue) : 0; }
+
+#if EVENT_QUEUE_TRACING
+    /**
+     * @brief Print queue counters, callback histograms and the trace ring to a stream
+     *
+     * @param out Destination stream, typically Serial
+     */
+    void dumpTrace(Print& out) const;
+
+    /**
+     * @brief Serialize the current trace state as JSON
+     *
+     * @param root Object to fill with counters, callback stats and recent events
+     */
+    void writeTraceJson(JsonObject root) const;
+
+    /**
+     * @brief Clear all counters, histograms and recorded events
+     */
+    void resetTrace();
+#endif
 }; 
\ No newline at end of file
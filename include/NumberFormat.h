@@ -4,43 +4,136 @@
 
 class NumberFormat {
 public:
+    // Separators used by every formatter below; defaults to "1,234.5"
+    static void setSeparators(char thousands, char decimal) {
+        separators().thousands = thousands;
+        separators().decimal = decimal;
+    }
+
+    static char thousandsSeparator() { return separators().thousands; }
+    static char decimalSeparator() { return separators().decimal; }
+
     // Format a number with thousands separators
     static void addThousandsSeparators(char* buffer, size_t bufferSize, uint32_t number) {
-        // Convert to string first to get length
-        char tempBuffer[16];
-        snprintf(tempBuffer, sizeof(tempBuffer), "%u", number);
-        size_t len = strlen(tempBuffer);
-        
-        // Calculate how many thousands separators we'll need
-        size_t separatorCount = (len - 1) / 3;
-        
-        // Check if we have enough space in the buffer
-        if (len + separatorCount + 1 > bufferSize) {
-            // If not enough space, just copy without separators
-            strncpy(buffer, tempBuffer, bufferSize);
-            buffer[bufferSize - 1] = '\0';
-            return;
-        }
-        
-        // Add thousands separators
-        size_t sourceIndex = len;
-        size_t targetIndex = len + separatorCount;
-        buffer[targetIndex] = '\0';
-        
-        int digitCount = 0;
-        while (sourceIndex > 0) {
-            sourceIndex--;
-            if (digitCount > 0 && digitCount % 3 == 0) {
-                targetIndex--;
-                buffer[targetIndex] = ',';
+        formatInteger(buffer, bufferSize, number);
+    }
+
+    // Format an integer with thousands separators, without printf; returns the length.
+    // Falls back to plain digits if the separators don't fit, and "" if the digits don't.
+    static size_t formatInteger(char* buffer, size_t bufferSize, int64_t value) {
+        if (bufferSize == 0) return 0;
+
+        // Digits in reverse; 20 covers the magnitude of INT64_MIN
+        char digits[20];
+        size_t digitCount = 0;
+        uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+        do {
+            digits[digitCount++] = '0' + (char)(magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude > 0);
+
+        size_t signLength = value < 0 ? 1 : 0;
+        size_t separatorCount = separators().thousands ? (digitCount - 1) / 3 : 0;
+        if (signLength + digitCount + separatorCount + 1 > bufferSize) {
+            separatorCount = 0;
+        }
+        size_t length = signLength + digitCount + separatorCount;
+        if (length + 1 > bufferSize) {
+            buffer[0] = '\0';
+            return 0;
+        }
+
+        char* out = buffer;
+        if (signLength) *out++ = '-';
+        for (size_t i = digitCount; i > 0; i--) {
+            *out++ = digits[i - 1];
+            if (separatorCount && i > 1 && (i - 1) % 3 == 0) {
+                *out++ = separators().thousands;
             }
-            targetIndex--;
-            buffer[targetIndex] = tempBuffer[sourceIndex];
-            digitCount++;
         }
+        *out = '\0';
+        return length;
+    }
+
+    // Format with a fixed number of decimals and a grouped integer part; returns the length
+    static size_t formatDecimal(char* buffer, size_t bufferSize, double value, uint8_t decimals) {
+        if (bufferSize == 0) return 0;
+
+        uint32_t scale = 1;
+        for (uint8_t i = 0; i < decimals && i < 9; i++) scale *= 10;
+
+        double scaled = fabs(value) * scale;
+        if (!(scaled < 9.0e18)) {
+            // Out of integer range, or NaN; let printf deal with it
+            int written = snprintf(buffer, bufferSize, "%.*f", decimals, value);
+            if (written < 0) return 0;
+            return (size_t)written < bufferSize ? (size_t)written : bufferSize - 1;
+        }
+
+        uint64_t rounded = (uint64_t)llround(scaled);
+        uint64_t whole = rounded / scale;
+        uint32_t fraction = (uint32_t)(rounded % scale);
+
+        // Keep the sign only if something non-zero survives rounding
+        int64_t signedWhole = (int64_t)whole;
+        bool negative = value < 0 && rounded != 0;
+        size_t length = 0;
+        if (negative && whole == 0) {
+            if (bufferSize < 2) { buffer[0] = '\0'; return 0; }
+            buffer[length++] = '-';
+            buffer[length] = '\0';
+        } else if (negative) {
+            signedWhole = -signedWhole;
+        }
+        length += formatInteger(buffer + length, bufferSize - length, signedWhole);
+
+        if (decimals == 0 || length == 0) return length;
+        if (length + 1 + decimals + 1 > bufferSize) return length;
+
+        buffer[length++] = separators().decimal;
+        for (uint32_t divisor = scale / 10; divisor > 0; divisor /= 10) {
+            buffer[length++] = '0' + (char)((fraction / divisor) % 10);
+        }
+        buffer[length] = '\0';
+        return length;
+    }
+
+    // Compact display form: whole numbers below a million in full, otherwise
+    // one decimal with a K or M suffix; returns the length
+    static size_t formatCompact(char* buffer, size_t bufferSize, double value) {
+        if (bufferSize == 0) return 0;
+
+        double shown = value;
+        char unit = '\0';
+        if (value >= 1000000.0) {
+            shown = value / 1000000.0;
+            unit = 'M';
+        } else if (value >= 0 && value == (double)(uint32_t)value) {
+            return formatInteger(buffer, bufferSize, (int64_t)value);
+        } else if (value >= 1000.0 || (value <= -1000.0 && value > -1000000.0)) {
+            shown = value / 1000.0;
+            unit = 'K';
+        }
+
+        size_t length = formatDecimal(buffer, bufferSize, shown, 1);
+        if (unit && length > 0 && length + 2 <= bufferSize) {
+            buffer[length++] = unit;
+            buffer[length] = '\0';
+        }
+        return length;
     }
 
 private:
+    struct Separators {
+        char thousands;
+        char decimal;
+    };
+
+    static Separators& separators() {
+        static Separators current = {',', '.'};
+        return current;
+    }
+
     // Private constructor to prevent instantiation
     NumberFormat() {}
-}; 
\ No newline at end of file
+};
@@ -553,7 +553,7 @@
 /*==================
  * OTHERS
  *==================*/
-#define LV_USE_SNAPSHOT 0 // Default
+#define LV_USE_SNAPSHOT 1 // Card transitions slide cached snapshots
 #define LV_USE_SYSMON   0 // Keep disabled (old perf/mem monitors were 0)
 #if LV_USE_SYSMON
     #define LV_SYSMON_GET_IDLE lv_os_get_idle_percent // Default
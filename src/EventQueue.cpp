@@ -1,11 +1,42 @@
 #include "EventQueue.h"
 
+#if EVENT_QUEUE_TRACING
+const uint32_t EventQueue::TRACE_BUCKET_LIMITS_US[EventQueue::TRACE_BUCKET_COUNT] = {
+    100, 500, 1000, 5000, 10000, 50000, 100000, UINT32_MAX
+};
+
+static const char* eventTypeToString(EventType type) {
+    switch (type) {
+        case EventType::INSIGHT_DATA_RECEIVED: return "INSIGHT_DATA_RECEIVED";
+        case EventType::INSIGHT_FORCE_REFRESH: return "INSIGHT_FORCE_REFRESH";
+        case EventType::WIFI_CREDENTIALS_FOUND: return "WIFI_CREDENTIALS_FOUND";
+        case EventType::NEED_WIFI_CREDENTIALS: return "NEED_WIFI_CREDENTIALS";
+        case EventType::WIFI_CONNECTING: return "WIFI_CONNECTING";
+        case EventType::WIFI_CONNECTED: return "WIFI_CONNECTED";
+        case EventType::WIFI_CONNECTION_FAILED: return "WIFI_CONNECTION_FAILED";
+        case EventType::WIFI_AP_STARTED: return "WIFI_AP_STARTED";
+        case EventType::OTA_PROCESS_START: return "OTA_PROCESS_START";
+        case EventType::OTA_PROCESS_END: return "OTA_PROCESS_END";
+        case EventType::CARD_CONFIG_CHANGED: return "CARD_CONFIG_CHANGED";
+        case EventType::CARD_TITLE_UPDATED: return "CARD_TITLE_UPDATED";
+        default: return "UNKNOWN";
+    }
+}
+#endif
+
 EventQueue::EventQueue(size_t queueSize) : isRunning(false), taskHandle(nullptr) {
     // Create the event queue
     eventQueue = xQueueCreate(queueSize, sizeof(Event));
     
     // Create mutex for callback access
     callbackMutex = xSemaphoreCreateMutex();
+
+#if EVENT_QUEUE_TRACING
+    traceLock = portMUX_INITIALIZER_UNLOCKED;
+    queueCapacity = queueSize;
+    lastTraceDumpMs = 0;
+    resetTrace();
+#endif
 }
 
 EventQueue::~EventQueue() {
@@ -45,11 +76,20 @@ bool EventQueue::publishEvent(EventType eventType, const String& insightId, cons
 }
 
 bool EventQueue::publishEvent(const Event& event) {
+#if EVENT_QUEUE_TRACING
+    // Stamp a copy so the caller's event stays untouched
+    Event stamped = event;
+    stamped.enqueuedAtUs = micros();
+    bool accepted = xQueueSend(eventQueue, &stamped, 0) == pdPASS;
+    recordPublish(accepted);
+    return accepted;
+#else
     // Add the event to the queue
     if (xQueueSend(eventQueue, &event, 0) == pdPASS) {
         return true;
     }
     return false;
+#endif
 }
 
 void EventQueue::subscribe(EventCallback callback) {
@@ -96,18 +136,209 @@ void EventQueue::eventProcessingTask(void* parameter) {
     while (self->isRunning) {
         // Wait for an event (block until an event arrives)
         if (xQueueReceive(self->eventQueue, &event, pdMS_TO_TICKS(100)) == pdPASS) {
+#if EVENT_QUEUE_TRACING
+            EventTraceRecord record = {};
+            record.type = event.type;
+            record.waitUs = micros() - event.enqueuedAtUs;
+            record.depthAtDequeue = static_cast<uint8_t>(uxQueueMessagesWaiting(self->eventQueue));
+#endif
             // Process the event by calling all registered callbacks
             if (xSemaphoreTake(self->callbackMutex, portMAX_DELAY) == pdTRUE) {
+#if EVENT_QUEUE_TRACING
+                for (size_t i = 0; i < self->eventCallbacks.size(); i++) {
+                    uint32_t start = micros();
+                    self->eventCallbacks[i](event);
+                    uint32_t duration = micros() - start;
+
+                    self->recordCallback(i, duration);
+                    record.dispatchUs += duration;
+                    if (duration > record.slowestUs) {
+                        record.slowestUs = duration;
+                        record.slowestCallback = static_cast<uint8_t>(i);
+                    }
+                }
+#else
                 for (const auto& callback : self->eventCallbacks) {
                     callback(event);
                 }
+#endif
                 xSemaphoreGive(self->callbackMutex);
             }
+#if EVENT_QUEUE_TRACING
+            self->recordProcessed(record);
+#endif
+        }
+#if EVENT_QUEUE_TRACING && EVENT_QUEUE_TRACE_DUMP_INTERVAL_MS > 0
+        if (millis() - self->lastTraceDumpMs >= EVENT_QUEUE_TRACE_DUMP_INTERVAL_MS) {
+            self->lastTraceDumpMs = millis();
+            self->dumpTrace(Serial);
         }
+#endif
         // Small delay to prevent CPU hogging
         vTaskDelay(1);
     }
     
     // Task cleanup
     vTaskDelete(NULL);
-} 
\ No newline at end of file
+}
+
+#if EVENT_QUEUE_TRACING
+size_t EventQueue::bucketFor(uint32_t durationUs) {
+    for (size_t i = 0; i < TRACE_BUCKET_COUNT; i++) {
+        if (durationUs < TRACE_BUCKET_LIMITS_US[i]) {
+            return i;
+        }
+    }
+    return TRACE_BUCKET_COUNT - 1;
+}
+
+void EventQueue::recordPublish(bool accepted) {
+    uint32_t depth = uxQueueMessagesWaiting(eventQueue);
+
+    portENTER_CRITICAL(&traceLock);
+    if (accepted) {
+        publishedCount++;
+    } else {
+        droppedCount++;
+    }
+    if (depth > highWaterMark) {
+        highWaterMark = depth;
+    }
+    portEXIT_CRITICAL(&traceLock);
+}
+
+void EventQueue::recordCallback(size_t index, uint32_t durationUs) {
+    if (index >= MAX_TRACED_CALLBACKS) {
+        return;
+    }
+
+    portENTER_CRITICAL(&traceLock);
+    CallbackTraceStats& stats = callbackStats[index];
+    stats.buckets[bucketFor(durationUs)]++;
+    stats.calls++;
+    stats.totalUs += durationUs;
+    if (durationUs > stats.maxUs) {
+        stats.maxUs = durationUs;
+    }
+    portEXIT_CRITICAL(&traceLock);
+}
+
+void EventQueue::recordProcessed(const EventTraceRecord& record) {
+    portENTER_CRITICAL(&traceLock);
+    traceRing[traceHead] = record;
+    traceHead = (traceHead + 1) % TRACE_RING_SIZE;
+    if (traceCount < TRACE_RING_SIZE) {
+        traceCount++;
+    }
+    portEXIT_CRITICAL(&traceLock);
+}
+
+void EventQueue::resetTrace() {
+    portENTER_CRITICAL(&traceLock);
+    publishedCount = 0;
+    droppedCount = 0;
+    highWaterMark = 0;
+    traceHead = 0;
+    traceCount = 0;
+    memset(traceRing, 0, sizeof(traceRing));
+    memset(callbackStats, 0, sizeof(callbackStats));
+    portEXIT_CRITICAL(&traceLock);
+}
+
+void EventQueue::dumpTrace(Print& out) const {
+    // Copy under the lock, print without it
+    EventTraceRecord ring[TRACE_RING_SIZE];
+    CallbackTraceStats callbacks[MAX_TRACED_CALLBACKS];
+    uint32_t published, dropped, highWater;
+    size_t head, count;
+
+    portENTER_CRITICAL(&traceLock);
+    memcpy(ring, traceRing, sizeof(ring));
+    memcpy(callbacks, callbackStats, sizeof(callbacks));
+    published = publishedCount;
+    dropped = droppedCount;
+    highWater = highWaterMark;
+    head = traceHead;
+    count = traceCount;
+    portEXIT_CRITICAL(&traceLock);
+
+    out.printf("[EventTrace] published=%u dropped=%u high_water=%u/%u\n",
+               published, dropped, highWater, (unsigned)queueCapacity);
+
+    for (size_t i = 0; i < MAX_TRACED_CALLBACKS; i++) {
+        const CallbackTraceStats& stats = callbacks[i];
+        if (stats.calls == 0) continue;
+        out.printf("[EventTrace] cb#%u calls=%u avg=%uus max=%uus hist=",
+                   (unsigned)i, stats.calls, (unsigned)(stats.totalUs / stats.calls), stats.maxUs);
+        for (size_t b = 0; b < TRACE_BUCKET_COUNT; b++) {
+            out.printf(b == 0 ? "%u" : "/%u", stats.buckets[b]);
+        }
+        out.println();
+    }
+
+    // Oldest first
+    size_t start = (head + TRACE_RING_SIZE - count) % TRACE_RING_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        const EventTraceRecord& r = ring[(start + i) % TRACE_RING_SIZE];
+        out.printf("[EventTrace] %-22s wait=%uus dispatch=%uus slowest=cb#%u(%uus) depth=%u\n",
+                   eventTypeToString(r.type), r.waitUs, r.dispatchUs,
+                   r.slowestCallback, r.slowestUs, r.depthAtDequeue);
+    }
+}
+
+void EventQueue::writeTraceJson(JsonObject root) const {
+    EventTraceRecord ring[TRACE_RING_SIZE];
+    CallbackTraceStats callbacks[MAX_TRACED_CALLBACKS];
+    uint32_t published, dropped, highWater;
+    size_t head, count;
+
+    portENTER_CRITICAL(&traceLock);
+    memcpy(ring, traceRing, sizeof(ring));
+    memcpy(callbacks, callbackStats, sizeof(callbacks));
+    published = publishedCount;
+    dropped = droppedCount;
+    highWater = highWaterMark;
+    head = traceHead;
+    count = traceCount;
+    portEXIT_CRITICAL(&traceLock);
+
+    root["capacity"] = queueCapacity;
+    root["depth"] = uxQueueMessagesWaiting(eventQueue);
+    root["high_water"] = highWater;
+    root["published"] = published;
+    root["dropped"] = dropped;
+
+    JsonArray limits = root.createNestedArray("bucket_limits_us");
+    for (size_t b = 0; b < TRACE_BUCKET_COUNT - 1; b++) {
+        limits.add(TRACE_BUCKET_LIMITS_US[b]);
+    }
+
+    JsonArray callbacksArray = root.createNestedArray("callbacks");
+    for (size_t i = 0; i < MAX_TRACED_CALLBACKS; i++) {
+        const CallbackTraceStats& stats = callbacks[i];
+        if (stats.calls == 0) continue;
+        JsonObject cb = callbacksArray.createNestedObject();
+        cb["index"] = i;
+        cb["calls"] = stats.calls;
+        cb["avg_us"] = (uint32_t)(stats.totalUs / stats.calls);
+        cb["max_us"] = stats.maxUs;
+        JsonArray hist = cb.createNestedArray("histogram");
+        for (size_t b = 0; b < TRACE_BUCKET_COUNT; b++) {
+            hist.add(stats.buckets[b]);
+        }
+    }
+
+    JsonArray events = root.createNestedArray("events");
+    size_t start = (head + TRACE_RING_SIZE - count) % TRACE_RING_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        const EventTraceRecord& r = ring[(start + i) % TRACE_RING_SIZE];
+        JsonObject e = events.createNestedObject();
+        e["type"] = eventTypeToString(r.type);
+        e["wait_us"] = r.waitUs;
+        e["dispatch_us"] = r.dispatchUs;
+        e["slowest_callback"] = r.slowestCallback;
+        e["slowest_us"] = r.slowestUs;
+        e["depth"] = r.depthAtDequeue;
+    }
+}
+#endif
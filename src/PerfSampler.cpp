@@ -0,0 +1,161 @@
+#include "PerfSampler.h"
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <string.h>
+
+namespace {
+
+struct GaugeSlot {
+    const char* name;
+    const char* unit;
+    PerfSampler::GaugeReadFn read;
+    std::atomic<int32_t> value;
+    std::atomic<bool> valid;
+};
+
+GaugeSlot gauges[PerfSampler::MAX_GAUGES];
+std::atomic<size_t> gaugesRegistered(0);
+portMUX_TYPE gaugeLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Written by LVGL display events, read by the sampling task
+uint32_t frameStartUs = 0;
+std::atomic<uint32_t> frameCount(0);
+std::atomic<uint32_t> frameTotalUs(0);
+std::atomic<uint32_t> frameMaxUs(0);
+uint32_t lastFrameSampleMs = 0;
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+constexpr UBaseType_t MAX_TASKS = 32;
+TaskStatus_t taskStatus[MAX_TASKS];
+configRUN_TIME_COUNTER_TYPE lastTotalRunTime = 0;
+configRUN_TIME_COUNTER_TYPE lastIdleRunTime[2] = {0, 0};
+configRUN_TIME_COUNTER_TYPE lastLvglRunTime = 0;
+#endif
+
+} // namespace
+
+void PerfSampler::attachDisplay(lv_display_t* display) {
+    lv_display_add_event_cb(display, frameEventCb, LV_EVENT_RENDER_START, nullptr);
+    lv_display_add_event_cb(display, frameEventCb, LV_EVENT_RENDER_READY, nullptr);
+    lastFrameSampleMs = millis();
+}
+
+void PerfSampler::frameEventCb(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        frameStartUs = micros();
+        return;
+    }
+
+    uint32_t frame_us = micros() - frameStartUs;
+    frameCount.fetch_add(1, std::memory_order_relaxed);
+    frameTotalUs.fetch_add(frame_us, std::memory_order_relaxed);
+    if (frame_us > frameMaxUs.load(std::memory_order_relaxed)) {
+        frameMaxUs.store(frame_us, std::memory_order_relaxed);
+    }
+}
+
+PerfSampler::FrameStats PerfSampler::sampleFrames() {
+    uint32_t now = millis();
+    uint32_t elapsed_ms = now - lastFrameSampleMs;
+    lastFrameSampleMs = now;
+
+    uint32_t frames = frameCount.exchange(0, std::memory_order_relaxed);
+    uint32_t total_us = frameTotalUs.exchange(0, std::memory_order_relaxed);
+
+    FrameStats stats;
+    stats.fps = elapsed_ms > 0 ? frames * 1000.0f / elapsed_ms : 0.0f;
+    stats.avgFrameUs = frames > 0 ? total_us / frames : 0;
+    stats.maxFrameUs = frameMaxUs.exchange(0, std::memory_order_relaxed);
+    return stats;
+}
+
+PerfSampler::CpuStats PerfSampler::sampleCpu() {
+    CpuStats stats = {};
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+    configRUN_TIME_COUNTER_TYPE total_run_time = 0;
+    UBaseType_t count = uxTaskGetSystemState(taskStatus, MAX_TASKS, &total_run_time);
+    if (count == 0) {
+        return stats;  // More tasks than MAX_TASKS
+    }
+
+    configRUN_TIME_COUNTER_TYPE idle_run_time[2] = {0, 0};
+    configRUN_TIME_COUNTER_TYPE lvgl_run_time = 0;
+    for (UBaseType_t i = 0; i < count; i++) {
+        for (BaseType_t core = 0; core < 2; core++) {
+            if (taskStatus[i].xHandle == xTaskGetIdleTaskHandleForCore(core)) {
+                idle_run_time[core] = taskStatus[i].ulRunTimeCounter;
+            }
+        }
+        if (strcmp(taskStatus[i].pcTaskName, "lvglTask") == 0) {
+            lvgl_run_time = taskStatus[i].ulRunTimeCounter;
+        }
+    }
+
+    // Counters are per task; the total is wall time, which each core spends once
+    configRUN_TIME_COUNTER_TYPE window = total_run_time - lastTotalRunTime;
+    if (lastTotalRunTime != 0 && window > 0) {
+        for (int core = 0; core < 2; core++) {
+            configRUN_TIME_COUNTER_TYPE idle = idle_run_time[core] - lastIdleRunTime[core];
+            uint32_t idle_percent = (uint32_t)((uint64_t)idle * 100 / window);
+            stats.coreLoad[core] = idle_percent >= 100 ? 0 : 100 - idle_percent;
+        }
+        uint32_t lvgl_percent = (uint32_t)((uint64_t)(lvgl_run_time - lastLvglRunTime) * 100 / window);
+        stats.lvglShare = lvgl_percent > 100 ? 100 : lvgl_percent;
+        stats.available = true;
+    }
+
+    lastTotalRunTime = total_run_time;
+    lastIdleRunTime[0] = idle_run_time[0];
+    lastIdleRunTime[1] = idle_run_time[1];
+    lastLvglRunTime = lvgl_run_time;
+#endif
+    return stats;
+}
+
+int PerfSampler::registerGauge(const char* name, const char* unit, GaugeReadFn read) {
+    portENTER_CRITICAL(&gaugeLock);
+    size_t index = gaugesRegistered.load(std::memory_order_relaxed);
+    if (index >= MAX_GAUGES) {
+        portEXIT_CRITICAL(&gaugeLock);
+        return NO_GAUGE;
+    }
+    gauges[index].name = name;
+    gauges[index].unit = unit ? unit : "";
+    gauges[index].read = read;
+    gauges[index].value.store(0, std::memory_order_relaxed);
+    gauges[index].valid.store(read != nullptr, std::memory_order_relaxed);
+    gaugesRegistered.store(index + 1, std::memory_order_release);
+    portEXIT_CRITICAL(&gaugeLock);
+    return (int)index;
+}
+
+void PerfSampler::setGauge(int id, int32_t value) {
+    if (id < 0 || (size_t)id >= gaugesRegistered.load(std::memory_order_acquire)) {
+        return;
+    }
+    gauges[id].value.store(value, std::memory_order_relaxed);
+    gauges[id].valid.store(true, std::memory_order_release);
+}
+
+size_t PerfSampler::gaugeCount() {
+    return gaugesRegistered.load(std::memory_order_acquire);
+}
+
+bool PerfSampler::readGauge(size_t index, const char*& name, const char*& unit, int32_t& value) {
+    if (index >= gaugesRegistered.load(std::memory_order_acquire)) {
+        return false;
+    }
+    GaugeSlot& gauge = gauges[index];
+    name = gauge.name;
+    unit = gauge.unit;
+    if (gauge.read) {
+        value = gauge.read();
+        return true;
+    }
+    if (!gauge.valid.load(std::memory_order_acquire)) {
+        return false;
+    }
+    value = gauge.value.load(std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * @class PerfSampler
+ * @brief Runtime health counters read by the performance HUD
+ *
+ * Collects LVGL frame statistics from display events, FreeRTOS CPU share
+ * when run-time stats are compiled in, and named gauges that any subsystem
+ * can register. Sampling is pull-based: readers call the sample functions at
+ * their own (low) rate, so nothing here runs unless someone is looking.
+ *
+ * Gauges are fixed slots. Register once at startup with a string literal
+ * name and unit; setGauge() is a single atomic store, safe from any task.
+ */
+class PerfSampler {
+public:
+    static constexpr size_t MAX_GAUGES = 8;
+    static constexpr int NO_GAUGE = -1;
+
+    /**
+     * @brief Optional pull callback evaluated when the gauge is read
+     */
+    using GaugeReadFn = int32_t (*)();
+
+    struct FrameStats {
+        float fps;              ///< Rendered frames per second since the previous sample
+        uint32_t avgFrameUs;    ///< Mean render+flush time per frame
+        uint32_t maxFrameUs;    ///< Slowest frame since the previous sample
+    };
+
+    struct CpuStats {
+        bool available;         ///< False unless FreeRTOS run-time stats are enabled
+        uint8_t coreLoad[2];    ///< Percent of each core not spent in its idle task
+        uint8_t lvglShare;      ///< Percent of one core used by the LVGL task
+    };
+
+    /**
+     * @brief Count frames rendered on a display
+     */
+    static void attachDisplay(lv_display_t* display);
+
+    /**
+     * @brief Frame statistics since the previous call
+     */
+    static FrameStats sampleFrames();
+
+    /**
+     * @brief CPU share since the previous call
+     */
+    static CpuStats sampleCpu();
+
+    /**
+     * @brief Register a named gauge
+     * @param name Short display name; must outlive the program (string literal)
+     * @param unit Unit suffix, may be empty
+     * @param read Callback polled on read, or nullptr for a push gauge fed by setGauge()
+     * @return Gauge id, or NO_GAUGE if all slots are taken
+     */
+    static int registerGauge(const char* name, const char* unit, GaugeReadFn read = nullptr);
+
+    /**
+     * @brief Update a push gauge
+     */
+    static void setGauge(int id, int32_t value);
+
+    static size_t gaugeCount();
+
+    /**
+     * @brief Read gauge by index (0..gaugeCount()-1)
+     * @return false if the gauge has never been set
+     */
+    static bool readGauge(size_t index, const char*& name, const char*& unit, int32_t& value);
+
+private:
+    static void frameEventCb(lv_event_t* e);
+};
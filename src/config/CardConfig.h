@@ -15,7 +15,8 @@ enum class CardType
     FLAPPY_HOG,  ///< Flappy Hog game card
     QUESTION,    ///< Question trivia card
     PADDLE,      ///< Paddle game card
-    POMODORO     /// < Pomodoro card
+    POMODORO,    /// < Pomodoro card
+    PERF_HUD     ///< Runtime performance overlay
 };
 
 /**
@@ -98,6 +99,8 @@ inline String cardTypeToString(CardType type)
         return "PADDLE";
     case CardType::POMODORO:
         return "POMODORO";
+    case CardType::PERF_HUD:
+        return "PERF_HUD";
     default:
         return "UNKNOWN";
     }
@@ -124,5 +127,7 @@ inline CardType stringToCardType(const String &str)
         return CardType::PADDLE;
     if (str == "POMODORO")
         return CardType::POMODORO;
+    if (str == "PERF_HUD")
+        return CardType::PERF_HUD;
     return CardType::INSIGHT; // Default fallback
 }
\ No newline at end of file
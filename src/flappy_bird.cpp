@@ -357,6 +357,20 @@ void FlappyBirdGame::cleanup() {
     }
 }
 
+void FlappyBirdGame::release_objects() {
+    if (main_container) {
+        lv_obj_clean(main_container); // Deletes bird, pipes and labels but keeps the container
+    }
+    bird_obj = nullptr;
+    start_message_label = nullptr;
+    game_over_message_label = nullptr;
+    score_label = nullptr;
+    for (int i = 0; i < PIPE_COUNT; ++i) {
+        pipes[i].top_pipe_obj = nullptr;
+        pipes[i].bottom_pipe_obj = nullptr;
+    }
+}
+
 lv_obj_t* FlappyBirdGame::get_main_container() {
     return main_container;
 } 
\ No newline at end of file
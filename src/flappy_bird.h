@@ -42,6 +42,8 @@ public:
     void setup(lv_obj_t* parent_screen); // Creates the game's UI elements on parent_screen
     void loop();                     // Main game logic tick, called when this card is active
     void cleanup();                  // Cleans up LVGL objects
+    void release_objects();          // Deletes everything inside main_container; setup() rebuilds it
+    bool has_objects() const { return bird_obj != nullptr; }
     lv_obj_t* get_main_container();   // Returns the root LVGL object for this game/card
 
 private:
@@ -0,0 +1,225 @@
+#include "ButtonGestures.h"
+
+ButtonGestures::ButtonGestures(uint8_t button_count, const Config& config)
+    : _config(config),
+      _button_count(button_count > MAX_BUTTONS ? MAX_BUTTONS : button_count),
+      _chord_fired(false), _event_head(0), _event_count(0), _dropped_events(0) {
+    for (uint8_t i = 0; i < MAX_BUTTONS; i++) {
+        _buttons[i] = ButtonState{};
+    }
+}
+
+void ButtonGestures::reset(uint8_t button, bool pressed, uint32_t now_us) {
+    if (button >= _button_count) return;
+
+    ButtonState& state = _buttons[button];
+    state = ButtonState{};
+    state.stable = pressed;
+    state.raw = pressed;
+    state.pressed_at_us = now_us;
+    // A button already down at boot never long-presses or repeats
+    state.long_fired = pressed;
+    state.suppressed = pressed;
+}
+
+void ButtonGestures::feed(const ButtonEdge& edge) {
+    if (edge.button >= _button_count) return;
+
+    // Settle anything that expired before this edge so events stay in order
+    poll(edge.time_us);
+
+    ButtonState& state = _buttons[edge.button];
+    state.raw = edge.pressed;
+    if (!state.locked && edge.pressed != state.stable) {
+        accept(edge.button, edge.pressed, edge.time_us);
+    }
+}
+
+void ButtonGestures::poll(uint32_t now_us) {
+    for (uint8_t i = 0; i < _button_count; i++) {
+        ButtonState& state = _buttons[i];
+        if (state.locked && reached(now_us, state.lock_until_us)) {
+            state.locked = false;
+            // The bounce settled on the other level: report it now
+            if (state.raw != state.stable) {
+                accept(i, state.raw, state.lock_until_us);
+            }
+        }
+    }
+
+    // Chord buttons whose window closed without the chord forming
+    for (uint8_t i = 0; i < _button_count; i++) {
+        ButtonState& state = _buttons[i];
+        if (state.press_pending && reached(now_us, state.pressed_at_us + _config.chord_window_us)) {
+            state.press_pending = false;
+            emit(ButtonEventType::PRESS, i, state.pressed_at_us);
+        }
+    }
+
+    if (_config.chord_mask && chordHeld()) {
+        for (uint8_t i = 0; i < _button_count; i++) {
+            if (_config.chord_mask & (1u << i)) {
+                _buttons[i].suppressed = true;
+            }
+        }
+        uint32_t chord_due = chordStartUs() + _config.chord_hold_us;
+        if (!_chord_fired && reached(now_us, chord_due)) {
+            _chord_fired = true;
+            emit(ButtonEventType::CHORD, _config.chord_mask, chord_due);
+        }
+    }
+
+    for (uint8_t i = 0; i < _button_count; i++) {
+        ButtonState& state = _buttons[i];
+        if (!state.stable || state.suppressed) continue;
+
+        if (_config.long_press_us > 0 && !state.long_fired &&
+            reached(now_us, state.pressed_at_us + _config.long_press_us)) {
+            state.long_fired = true;
+            emit(ButtonEventType::LONG_PRESS, i, state.pressed_at_us + _config.long_press_us);
+        }
+
+        if ((_config.repeat_mask & (1u << i)) && _config.repeat_interval_us > 0) {
+            // Catch up one repeat per poll; a late poll must not burst
+            if (reached(now_us, state.next_repeat_us)) {
+                emit(ButtonEventType::REPEAT, i, now_us);
+                state.next_repeat_us = now_us + _config.repeat_interval_us;
+            }
+        }
+    }
+}
+
+uint32_t ButtonGestures::nextDeadlineUs(uint32_t now_us) const {
+    uint32_t best = NO_DEADLINE;
+    auto consider = [&](uint32_t deadline_us) {
+        uint32_t wait = reached(now_us, deadline_us) ? 0 : deadline_us - now_us;
+        if (wait < best) best = wait;
+    };
+
+    for (uint8_t i = 0; i < _button_count; i++) {
+        const ButtonState& state = _buttons[i];
+        if (state.locked) {
+            consider(state.lock_until_us);
+        }
+        if (state.press_pending) {
+            consider(state.pressed_at_us + _config.chord_window_us);
+        }
+        if (!state.stable || state.suppressed) continue;
+        if (_config.long_press_us > 0 && !state.long_fired) {
+            consider(state.pressed_at_us + _config.long_press_us);
+        }
+        if ((_config.repeat_mask & (1u << i)) && _config.repeat_interval_us > 0) {
+            consider(state.next_repeat_us);
+        }
+    }
+
+    if (_config.chord_mask && !_chord_fired && chordHeld()) {
+        consider(chordStartUs() + _config.chord_hold_us);
+    }
+    return best;
+}
+
+bool ButtonGestures::nextEvent(ButtonEvent& event) {
+    if (_event_count == 0) return false;
+    event = _events[_event_head];
+    _event_head = (_event_head + 1) % EVENT_CAPACITY;
+    _event_count--;
+    return true;
+}
+
+bool ButtonGestures::isPressed(uint8_t button) const {
+    return button < _button_count && _buttons[button].stable;
+}
+
+void ButtonGestures::accept(uint8_t button, bool pressed, uint32_t time_us) {
+    ButtonState& state = _buttons[button];
+    state.stable = pressed;
+    state.locked = true;
+    state.lock_until_us = time_us + _config.debounce_us;
+
+    if (pressed) {
+        state.pressed_at_us = time_us;
+        state.long_fired = false;
+        state.suppressed = false;
+        state.in_chord = false;
+        state.next_repeat_us = time_us + _config.repeat_delay_us;
+
+        if (!isChordButton(button)) {
+            flushPendingPresses();
+            emit(ButtonEventType::PRESS, button, time_us);
+        } else if (chordHeld()) {
+            // This press completes the chord: drop it and any press still held back
+            for (uint8_t i = 0; i < _button_count; i++) {
+                if (isChordButton(i) && _buttons[i].press_pending) {
+                    _buttons[i].press_pending = false;
+                    _buttons[i].in_chord = true;
+                }
+            }
+            state.in_chord = true;
+        } else if (_config.chord_window_us > 0) {
+            state.press_pending = true;
+        } else {
+            emit(ButtonEventType::PRESS, button, time_us);
+        }
+    } else {
+        if (isChordButton(button)) {
+            _chord_fired = false;
+        }
+        bool in_chord = state.in_chord;
+        state.suppressed = false;
+        state.in_chord = false;
+        if (!in_chord) {
+            // A tap shorter than the chord window still reports its press first
+            flushPendingPresses();
+            emit(ButtonEventType::RELEASE, button, time_us);
+        }
+    }
+}
+
+void ButtonGestures::flushPendingPresses() {
+    for (;;) {
+        uint8_t oldest = MAX_BUTTONS;
+        for (uint8_t i = 0; i < _button_count; i++) {
+            if (_buttons[i].press_pending &&
+                (oldest == MAX_BUTTONS || (int32_t)(_buttons[i].pressed_at_us - _buttons[oldest].pressed_at_us) < 0)) {
+                oldest = i;
+            }
+        }
+        if (oldest == MAX_BUTTONS) return;
+        _buttons[oldest].press_pending = false;
+        emit(ButtonEventType::PRESS, oldest, _buttons[oldest].pressed_at_us);
+    }
+}
+
+void ButtonGestures::emit(ButtonEventType type, uint8_t button, uint32_t time_us) {
+    if (_event_count == EVENT_CAPACITY) {
+        _dropped_events++;
+        return;
+    }
+    _events[(_event_head + _event_count) % EVENT_CAPACITY] = {type, button, time_us};
+    _event_count++;
+}
+
+bool ButtonGestures::chordHeld() const {
+    for (uint8_t i = 0; i < _button_count; i++) {
+        if ((_config.chord_mask & (1u << i)) && !_buttons[i].stable) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t ButtonGestures::chordStartUs() const {
+    // The chord starts when its last button went down
+    uint32_t start = 0;
+    bool first = true;
+    for (uint8_t i = 0; i < _button_count; i++) {
+        if (!(_config.chord_mask & (1u << i))) continue;
+        uint32_t pressed_at = _buttons[i].pressed_at_us;
+        if (first || (int32_t)(pressed_at - start) > 0) {
+            start = pressed_at;
+            first = false;
+        }
+    }
+    return start;
+}
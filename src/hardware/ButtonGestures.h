@@ -0,0 +1,140 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Raw level change captured by a button interrupt
+ */
+struct ButtonEdge {
+    uint8_t button;    ///< Button index
+    bool pressed;      ///< Level after the change, in pressed/released terms
+    uint32_t time_us;  ///< Capture time from esp_timer (wraps every ~71 minutes)
+};
+
+enum class ButtonEventType : uint8_t {
+    PRESS,       ///< Debounced press
+    RELEASE,     ///< Debounced release
+    LONG_PRESS,  ///< Button held for long_press_us (fires once per hold)
+    REPEAT,      ///< Auto-repeat while a repeat-enabled button is held
+    CHORD        ///< Every chord button held together for chord_hold_us
+};
+
+/**
+ * @brief Debounced, interpreted button event
+ */
+struct ButtonEvent {
+    ButtonEventType type;
+    uint8_t button;    ///< Button index, or the chord bit mask for CHORD
+    uint32_t time_us;  ///< Time the event was recognised
+};
+
+/**
+ * @class ButtonGestures
+ * @brief Timestamp debouncer with long-press, repeat and chord detection
+ *
+ * Pure state machine with no hardware dependencies: feed it raw edges in
+ * timestamp order and call poll() when nextDeadlineUs() expires.
+ *
+ * Debouncing accepts the first edge that changes a button's state at once
+ * (no added latency) and then ignores edges for debounce_us. When the window
+ * closes, the last raw level seen is compared with the accepted state so a
+ * bounce that settles the other way is still reported.
+ *
+ * A chord button's PRESS is held back for chord_window_us so the other chord
+ * buttons have a chance to go down. If the chord forms, the held PRESS and
+ * the PRESS/RELEASE of every chord button in it are dropped, so starting the
+ * chord never also navigates or selects. Otherwise the PRESS is sent, with
+ * its original timestamp, when the window closes or the button is released.
+ *
+ * While every chord button is held, long-press and repeat are suppressed for
+ * those buttons until they are released.
+ */
+class ButtonGestures {
+public:
+    static constexpr uint8_t MAX_BUTTONS = 8;
+    static constexpr size_t EVENT_CAPACITY = 16;
+    static constexpr uint32_t NO_DEADLINE = UINT32_MAX;
+
+    struct Config {
+        uint32_t debounce_us = 5000;
+        uint32_t long_press_us = 800000;       ///< 0 disables long-press
+        uint32_t repeat_delay_us = 500000;     ///< Hold time before the first repeat
+        uint32_t repeat_interval_us = 150000;  ///< Time between repeats
+        uint8_t repeat_mask = 0;               ///< Buttons that auto-repeat (bit per button)
+        uint8_t chord_mask = 0;                ///< Buttons forming the chord, 0 disables it
+        uint32_t chord_hold_us = 2000000;
+        uint32_t chord_window_us = 50000;      ///< How long a chord button's PRESS waits for the others
+    };
+
+    ButtonGestures(uint8_t button_count, const Config& config);
+
+    /**
+     * @brief Set a button's state without emitting events (e.g. at boot)
+     */
+    void reset(uint8_t button, bool pressed, uint32_t now_us);
+
+    /**
+     * @brief Process one raw edge; edges must arrive in timestamp order
+     */
+    void feed(const ButtonEdge& edge);
+
+    /**
+     * @brief Close expired debounce windows and fire due timed events
+     */
+    void poll(uint32_t now_us);
+
+    /**
+     * @brief Microseconds until poll() has work to do, NO_DEADLINE if none
+     */
+    uint32_t nextDeadlineUs(uint32_t now_us) const;
+
+    /**
+     * @brief Take the oldest pending event
+     * @return false if no events are pending
+     */
+    bool nextEvent(ButtonEvent& event);
+
+    bool isPressed(uint8_t button) const;
+
+    /**
+     * @brief Events discarded because the caller did not drain them
+     */
+    uint32_t droppedEvents() const { return _dropped_events; }
+
+private:
+    struct ButtonState {
+        bool stable;             ///< Debounced state
+        bool raw;                ///< Last raw level seen
+        bool locked;             ///< Inside a debounce window
+        bool long_fired;         ///< LONG_PRESS already sent for this hold
+        bool suppressed;         ///< Part of a chord; no long-press/repeat until released
+        bool press_pending;      ///< PRESS held back while the chord may still form
+        bool in_chord;           ///< Pressed as part of a chord; PRESS/RELEASE not reported
+        uint32_t lock_until_us;  ///< End of the debounce window
+        uint32_t pressed_at_us;  ///< When the current hold started
+        uint32_t next_repeat_us; ///< When the next REPEAT is due
+    };
+
+    static bool reached(uint32_t now_us, uint32_t deadline_us) {
+        return (int32_t)(now_us - deadline_us) >= 0;
+    }
+
+    void accept(uint8_t button, bool pressed, uint32_t time_us);
+    void emit(ButtonEventType type, uint8_t button, uint32_t time_us);
+    // Send held-back chord button presses, oldest first
+    void flushPendingPresses();
+    bool isChordButton(uint8_t button) const { return (_config.chord_mask & (1u << button)) != 0; }
+    bool chordHeld() const;
+    uint32_t chordStartUs() const;
+
+    Config _config;
+    uint8_t _button_count;
+    ButtonState _buttons[MAX_BUTTONS];
+    bool _chord_fired;
+
+    ButtonEvent _events[EVENT_CAPACITY];
+    size_t _event_head;
+    size_t _event_count;
+    uint32_t _dropped_events;
+};
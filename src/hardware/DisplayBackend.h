@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @class DisplayBackend
+ * @brief Destination for the pixels DisplayInterface gets from LVGL
+ *
+ * DisplayInterface owns LVGL, the render buffers and flush accounting; a
+ * backend only has to put a block of little-endian RGB565 pixels somewhere.
+ * Synchronous backends are done when flush() returns. Asynchronous ones
+ * return early and report completion through the done callback, which may
+ * run in interrupt context, including while flash is being written: both
+ * the backend's path to it and the callback itself must be in IRAM.
+ */
+class DisplayBackend {
+public:
+    /**
+     * @brief Completion callback for asynchronous flushes
+     */
+    using FlushDoneFn = void (*)(void* arg);
+
+    virtual ~DisplayBackend() = default;
+
+    /**
+     * @brief Bring up the output; called once before LVGL is initialised
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Short name for logs
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Send a block of pixels
+     *
+     * @param pixels Render buffer contents; an asynchronous backend may read
+     *        (or byte-swap in place) until it reports completion
+     */
+    virtual void flush(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* pixels) = 0;
+
+    /**
+     * @brief Whether flush() completes through the done callback
+     */
+    virtual bool isAsync() const { return false; }
+
+    virtual void setFlushDoneCallback(FlushDoneFn /*done*/, void* /*arg*/) {}
+
+    /**
+     * @brief Internal DMA-capable stripes for flushing buffers the hardware cannot read
+     */
+    virtual void setBounceBuffers(uint8_t* const* /*bounce*/, size_t /*count*/, size_t /*bytes*/) {}
+
+    /**
+     * @brief Block until no flush is reading a render or bounce buffer
+     */
+    virtual void waitIdle() {}
+
+    virtual void setBrightness(uint8_t /*brightness*/) {}
+
+    /**
+     * @brief Called on the LVGL task after LVGL renders a frame
+     *
+     * @param render_us Time from the start of the frame to its last flush being issued
+     */
+    virtual void frameRendered(uint32_t /*render_us*/) {}
+};
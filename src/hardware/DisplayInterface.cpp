@@ -1,8 +1,19 @@
 #include "DisplayInterface.h"
+#include "ui/RenderProfiler.h"
+#include "PerfSampler.h"
+#if !DISPLAY_BACKEND_FRAMEBUFFER
+#include "St7789Backend.h"
+#include "St7789Dma.h"
+#endif
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
 
 // A pointer to the instance for use in static callbacks
 static DisplayInterface* instance = nullptr;
 
+TaskHandle_t DisplayInterface::_lvgl_task = nullptr;
+
+#if !DISPLAY_BACKEND_FRAMEBUFFER
 DisplayInterface::DisplayInterface(
     uint16_t screen_width,
     uint16_t screen_height,
@@ -11,42 +22,58 @@ DisplayInterface::DisplayInterface(
     int8_t dc_pin, 
     int8_t rst_pin,
     int8_t backlight_pin
+) : DisplayInterface(
+        new St7789Backend(screen_width, screen_height, cs_pin, dc_pin, rst_pin, backlight_pin),
+        screen_width, screen_height, buffer_rows) {
+}
+#endif
+
+DisplayInterface::DisplayInterface(
+    DisplayBackend* backend,
+    uint16_t screen_width,
+    uint16_t screen_height,
+    uint16_t buffer_rows
 ) : _screen_width(screen_width),
     _screen_height(screen_height),
     _buffer_rows(buffer_rows),
-    _cs_pin(cs_pin),
-    _dc_pin(dc_pin),
-    _rst_pin(rst_pin),
-    _backlight_pin(backlight_pin),
-    _tft(nullptr),
+    _backend(backend),
     _display(nullptr),
-    _buf1(nullptr),
-    _buf2(nullptr),
-    _lvgl_mutex(nullptr) {
+    _buffers{},
+    _lvgl_mutex(nullptr),
+    _wakeups{},
+    _last_wakeup_ms(0),
+    _last_report_ms(0),
+    _idle_rate(0.0f),
+    _animating_rate(0.0f),
+    _refresh_mode(RefreshMode::ON_DEMAND),
+    _refresh_period_ms(0),
+    _mode_stats{},
+    _frame_start_us(0),
+    _flush_done(nullptr),
+    _flush_busy(false),
+    _flush_start_us(0),
+    _flush_done_us(0),
+    _flush_stats{},
+    _last_flush_report_ms(0) {
     
     // Store instance for static callbacks
     instance = this;
     
-    // Create TFT object
-    _tft = new Adafruit_ST7789(&SPI, _cs_pin, _dc_pin, _rst_pin);
-    if (!_tft) {
-        Serial.println("Failed to create TFT object");
+    if (!_backend) {
+        Serial.println("Failed to create display backend");
         return;
     }
     
-    // Allocate display buffers using C++ new operator instead of malloc
-    try {
-        _buf1 = new lv_color_t[_screen_width * _buffer_rows];
-        _buf2 = new lv_color_t[_screen_width * _buffer_rows];
-    } catch (std::bad_alloc&) {
+    // Allocate render buffers, falling back to full-frame PSRAM if the
+    // configured strategy does not fit
+    RenderBufferStrategy strategy = (RenderBufferStrategy)DISPLAY_BUFFER_STRATEGY;
+    if (!_allocate_buffers(strategy, _buffers) &&
+        (strategy == RenderBufferStrategy::PSRAM_FULL_FRAME ||
+         !_allocate_buffers(RenderBufferStrategy::PSRAM_FULL_FRAME, _buffers))) {
         Serial.println("Failed to allocate display buffers");
         // Clean up already allocated resources
-        delete _tft;
-        _tft = nullptr;
-        if (_buf1) {
-            delete[] _buf1;
-            _buf1 = nullptr;
-        }
+        delete _backend;
+        _backend = nullptr;
         return;
     }
     
@@ -55,46 +82,41 @@ DisplayInterface::DisplayInterface(
     if (_lvgl_mutex == nullptr) {
         Serial.println("Could not create mutex");
         // Clean up already allocated resources
-        delete _tft;
-        _tft = nullptr;
-        delete[] _buf1;
-        _buf1 = nullptr;
-        delete[] _buf2;
-        _buf2 = nullptr;
+        delete _backend;
+        _backend = nullptr;
+        _free_buffers(_buffers);
         return;
     }
 }
 
 void DisplayInterface::begin() {
     // Check if initialization failed
-    if (!_tft || !_buf1 || !_buf2 || !_lvgl_mutex) {
+    if (!_backend || !_buffers.draw[0] || !_lvgl_mutex) {
         Serial.println("Cannot initialize display: resources not allocated");
         return;
     }
     
-    // Initialize SPI
-    SPI.begin();
-    
-    // Initialize display
-    _tft->init(_screen_height, _screen_width);
-    _tft->setRotation(1);
-    
-    // Configure backlight with PWM for brightness control
-    pinMode(_backlight_pin, OUTPUT);
-    
-    // Set up PWM on the backlight pin using new ESP32 Arduino Core 3.x API
-    // Attach pin with 5000 Hz frequency and 8-bit resolution
-    ledcAttach(_backlight_pin, 5000, 8);
-    
-    // Set brightness to 80% (204 out of 255)
-    ledcWrite(_backlight_pin, 204);
-    Serial.println("Display backlight set to 80% brightness");
+    _backend->setFlushDoneCallback(_flush_done_cb, this);
+    if (!_backend->begin()) {
+        Serial.println("Cannot initialize display: backend failed to start");
+        return;
+    }
+    _backend->setBounceBuffers(_buffers.bounce, _buffers.bounceCount, _buffers.bounceBytes);
     
-    _tft->fillScreen(ST77XX_BLACK);
+    if (_backend->isAsync()) {
+        _flush_done = xSemaphoreCreateBinary();
+        if (!_flush_done) {
+            Serial.println("Could not create flush semaphore");
+            return;
+        }
+    }
     
     // Initialize LVGL
     lv_init();
     
+    // LVGL reads the time on demand, so no task has to wake to advance the tick
+    lv_tick_set_cb(_tick_cb);
+    
     // Initialize and register display for LVGL v9
     _display = lv_display_create(_screen_width, _screen_height);
     if (!_display) {
@@ -103,13 +125,27 @@ void DisplayInterface::begin() {
     }
     
     lv_display_set_flush_cb(_display, _disp_flush);
+    if (_backend->isAsync()) {
+        // Block on the completion interrupt instead of spinning on the flush flag
+        lv_display_set_flush_wait_cb(_display, _flush_wait_cb);
+    }
+    lv_display_add_event_cb(_display, _frame_rendered_cb, LV_EVENT_RENDER_START, this);
+    lv_display_add_event_cb(_display, _frame_rendered_cb, LV_EVENT_RENDER_READY, this);
+    updateRefreshRate(0);
+    PerfSampler::attachDisplay(_display);
+    PerfSampler::registerGauge("Flush", "us", _flush_cost_gauge);
+    _last_flush_report_ms = millis();
+    
+#if RENDER_PROFILER
+    RenderProfiler::attach(_display);
+#endif
     
     // Set the buffer correctly
     lv_display_set_buffers(
         _display, 
-        _buf1, 
-        _buf2, 
-        _screen_width * _buffer_rows * sizeof(lv_color_t),
+        _buffers.draw[0], 
+        _buffers.draw[1], 
+        _buffers.drawBytes,
         LV_DISPLAY_RENDER_MODE_PARTIAL
     );
     
@@ -119,23 +155,123 @@ void DisplayInterface::begin() {
     lv_obj_set_style_border_width(lv_scr_act(), 0, 0);
 }
 
-Adafruit_ST7789* DisplayInterface::getDisplay() {
-    return _tft;
-}
-
-void DisplayInterface::handleLVGLTasks() {
+uint32_t DisplayInterface::handleLVGLTasks() {
+    uint32_t next_ms = 1;
     if (takeMutex()) {
-        lv_timer_handler();
+        next_ms = lv_timer_handler();
         giveMutex();
     }
+    if (DISPLAY_FLUSH_REPORT_INTERVAL_MS > 0 && millis() - _last_flush_report_ms >= DISPLAY_FLUSH_REPORT_INTERVAL_MS) {
+        _report_flush_stats();
+    }
+#if RENDER_PROFILER
+    RenderProfiler::maybeDump();
+#endif
+    return next_ms;
+}
+
+uint32_t DisplayInterface::_tick_cb() {
+    return millis();
+}
+
+void DisplayInterface::setLVGLTask(TaskHandle_t task) {
+    _lvgl_task = task;
+    _last_wakeup_ms = millis();
+    _last_report_ms = _last_wakeup_ms;
+}
+
+void DisplayInterface::wakeLVGLTask() {
+    if (_lvgl_task && xTaskGetCurrentTaskHandle() != _lvgl_task) {
+        xTaskNotifyGive(_lvgl_task);
+    }
 }
 
-void DisplayInterface::tickTask(void* arg) {
-    (void)arg;  // Silence unused parameter warning
-    while (1) {
-        lv_tick_inc(10);
-        vTaskDelay(pdMS_TO_TICKS(10));
+void DisplayInterface::updateRefreshRate(uint8_t card_fps) {
+    if (!_display) return;
+    
+    RefreshMode mode;
+    uint32_t period_ms;
+    if (card_fps > 0) {
+        mode = RefreshMode::CONTINUOUS;
+        period_ms = 1000 / card_fps;
+    } else if (lv_anim_count_running() > 0) {
+        mode = RefreshMode::ANIMATING;
+        period_ms = 1000 / LVGL_ANIMATION_FPS;
+    } else {
+        mode = RefreshMode::ON_DEMAND;
+        period_ms = LVGL_ON_DEMAND_REFR_PERIOD_MS;
     }
+    _refresh_mode = mode;
+    if (period_ms == _refresh_period_ms) return;
+    
+    // Animations advance on their own timer; step them no faster than frames are drawn
+    lv_timer_set_period(lv_display_get_refr_timer(_display), period_ms);
+    lv_timer_set_period(lv_anim_get_timer(), mode == RefreshMode::ON_DEMAND ? 1000 / LVGL_ANIMATION_FPS : period_ms);
+    _refresh_period_ms = period_ms;
+}
+
+void DisplayInterface::_frame_rendered_cb(lv_event_t* e) {
+    DisplayInterface* self = static_cast<DisplayInterface*>(lv_event_get_user_data(e));
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        self->_frame_start_us = micros();
+        return;
+    }
+    self->_mode_stats[(size_t)self->_refresh_mode].frames++;
+    self->_backend->frameRendered(micros() - self->_frame_start_us);
+}
+
+void DisplayInterface::waitForWork(TickType_t timeout) {
+    TickType_t max_wait = pdMS_TO_TICKS(LVGL_TASK_MAX_SLEEP_MS);
+    if (timeout > max_wait) {
+        timeout = max_wait;
+    }
+    
+    bool animating = lv_anim_count_running() > 0;
+    uint32_t sleep_start = millis();
+    bool notified = ulTaskNotifyTake(pdTRUE, timeout) > 0;
+    
+    uint32_t now = millis();
+    uint32_t slept_ms = now - _last_wakeup_ms;
+    _last_wakeup_ms = now;
+    ModeStats& mode = _mode_stats[(size_t)_refresh_mode];
+    mode.wallMs += slept_ms;
+    mode.sleepMs += now - sleep_start;
+    if (animating) {
+        _wakeups.animatingWakeups++;
+        _wakeups.animatingMs += slept_ms;
+    } else {
+        _wakeups.idleWakeups++;
+        _wakeups.idleMs += slept_ms;
+    }
+    if (notified) {
+        _wakeups.notifiedWakeups++;
+    }
+    
+    if (LVGL_WAKEUP_REPORT_INTERVAL_MS > 0 && now - _last_report_ms >= LVGL_WAKEUP_REPORT_INTERVAL_MS) {
+        _idle_rate = _wakeups.idleMs ? _wakeups.idleWakeups * 1000.0f / _wakeups.idleMs : 0.0f;
+        _animating_rate = _wakeups.animatingMs ? _wakeups.animatingWakeups * 1000.0f / _wakeups.animatingMs : 0.0f;
+        Serial.printf("[LVGL] Wakeups/s: %.1f idle (%lu ms), %.1f animating (%lu ms), %lu woken early\n",
+                      _idle_rate, (unsigned long)_wakeups.idleMs,
+                      _animating_rate, (unsigned long)_wakeups.animatingMs,
+                      (unsigned long)_wakeups.notifiedWakeups);
+        static const char* const MODE_NAMES[] = {"on-demand", "animating", "continuous"};
+        for (size_t i = 0; i < (size_t)RefreshMode::COUNT; i++) {
+            const ModeStats& stats = _mode_stats[i];
+            if (stats.wallMs == 0) continue;
+            uint32_t busy_ms = stats.wallMs > stats.sleepMs ? stats.wallMs - stats.sleepMs : 0;
+            Serial.printf("[LVGL] %s: %.1f fps, LVGL task busy %lu%% over %lu ms\n",
+                          MODE_NAMES[i], stats.frames * 1000.0f / stats.wallMs,
+                          (unsigned long)(busy_ms * 100 / stats.wallMs), (unsigned long)stats.wallMs);
+        }
+        memset(_mode_stats, 0, sizeof(_mode_stats));
+        _wakeups = WakeupStats{};
+        _last_report_ms = now;
+    }
+}
+
+void DisplayInterface::getWakeupRates(float& idle, float& animating) const {
+    idle = _idle_rate;
+    animating = _animating_rate;
 }
 
 bool DisplayInterface::takeMutex(TickType_t timeout) {
@@ -148,6 +284,8 @@ bool DisplayInterface::takeMutex(TickType_t timeout) {
 void DisplayInterface::giveMutex() {
     if (_lvgl_mutex) {
         xSemaphoreGive(_lvgl_mutex);
+        // Another task may have changed the UI: let the LVGL task redraw it
+        wakeLVGLTask();
     }
 }
 
@@ -155,17 +293,199 @@ SemaphoreHandle_t* DisplayInterface::getMutexPtr() {
     return &_lvgl_mutex;
 }
 
+const char* DisplayInterface::strategyName(RenderBufferStrategy strategy) {
+    switch (strategy) {
+        case RenderBufferStrategy::INTERNAL_STRIPES: return "internal-stripes";
+        case RenderBufferStrategy::PSRAM_FULL_FRAME: return "psram-full-frame";
+        case RenderBufferStrategy::HYBRID: return "hybrid";
+        default: return "unknown";
+    }
+}
+
+bool DisplayInterface::_allocate_buffers(RenderBufferStrategy strategy, RenderBuffers& out) {
+    const size_t pixel_bytes = LV_COLOR_DEPTH / 8;
+    const size_t stripe_bytes = _screen_width * _buffer_rows * pixel_bytes;
+    const uint32_t internal_caps = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL;
+    
+    RenderBuffers buffers = {};
+    buffers.strategy = strategy;
+    uint8_t bounce_count = 0;
+    
+    if (strategy == RenderBufferStrategy::INTERNAL_STRIPES) {
+        // Fast to render into, DMA reads them directly; more flushes per frame
+        buffers.drawBytes = stripe_bytes;
+        buffers.draw[0] = (uint8_t*)heap_caps_malloc(stripe_bytes, internal_caps);
+        buffers.draw[1] = (uint8_t*)heap_caps_malloc(stripe_bytes, internal_caps);
+    } else {
+        // One flush per frame, but rendering touches slower PSRAM and the
+        // pixels reach the SPI through internal bounce stripes
+        buffers.drawBytes = _screen_width * _screen_height * pixel_bytes;
+        buffers.draw[0] = (uint8_t*)heap_caps_malloc(buffers.drawBytes, MALLOC_CAP_SPIRAM);
+        buffers.draw[1] = (uint8_t*)heap_caps_malloc(buffers.drawBytes, MALLOC_CAP_SPIRAM);
+        // Hybrid double-buffers the bounce stripes so copying overlaps the transfer
+        bounce_count = (DISPLAY_ASYNC_FLUSH && !DISPLAY_BACKEND_FRAMEBUFFER) ? (strategy == RenderBufferStrategy::HYBRID ? 2 : 1) : 0;
+    }
+    
+#if DISPLAY_BACKEND_FRAMEBUFFER
+    buffers.bounceBytes = stripe_bytes;
+#else
+    buffers.bounceBytes = stripe_bytes < St7789DmaWriter::CHUNK_BYTES ? stripe_bytes : St7789DmaWriter::CHUNK_BYTES;
+#endif
+    bool ok = buffers.draw[0] && buffers.draw[1];
+    for (uint8_t i = 0; ok && i < bounce_count; i++) {
+        buffers.bounce[i] = (uint8_t*)heap_caps_malloc(buffers.bounceBytes, internal_caps);
+        ok = buffers.bounce[i] != nullptr;
+        buffers.bounceCount = i + 1;
+    }
+    
+    if (!ok) {
+        Serial.printf("[Display] Could not allocate %s render buffers\n", strategyName(strategy));
+        _free_buffers(buffers);
+        return false;
+    }
+    
+    Serial.printf("[Display] Render buffers: %s, 2 x %u bytes, %u bounce x %u bytes\n",
+                  strategyName(strategy), (unsigned)buffers.drawBytes,
+                  (unsigned)buffers.bounceCount, (unsigned)buffers.bounceBytes);
+    out = buffers;
+    return true;
+}
+
+void DisplayInterface::_free_buffers(RenderBuffers& buffers) {
+    for (uint8_t i = 0; i < 2; i++) {
+        heap_caps_free(buffers.draw[i]);
+        heap_caps_free(buffers.bounce[i]);
+    }
+    buffers = RenderBuffers{};
+}
+
+bool DisplayInterface::setBufferStrategy(RenderBufferStrategy strategy) {
+    if (!_display) return false;
+    if (strategy == _buffers.strategy) return true;
+    
+    RenderBuffers buffers;
+    if (!_allocate_buffers(strategy, buffers)) {
+        return false;
+    }
+    
+    // Nothing may still be reading the old buffers
+    _wait_flush_idle();
+    lv_display_set_buffers(_display, buffers.draw[0], buffers.draw[1], buffers.drawBytes,
+                           LV_DISPLAY_RENDER_MODE_PARTIAL);
+    _free_buffers(_buffers);
+    _buffers = buffers;
+    _backend->setBounceBuffers(_buffers.bounce, _buffers.bounceCount, _buffers.bounceBytes);
+    lv_obj_invalidate(lv_screen_active());
+    return true;
+}
+
+uint32_t DisplayInterface::renderFrameNow() {
+    if (!_display) return 0;
+    lv_obj_invalidate(lv_screen_active());
+    uint32_t start_us = micros();
+    lv_refr_now(_display);
+    _wait_flush_idle();
+    return micros() - start_us;
+}
+
+void DisplayInterface::_wait_flush_idle() {
+    if (_backend && _backend->isAsync()) {
+        _flush_wait_cb(_display);
+        _backend->waitIdle();
+    }
+}
+
+void IRAM_ATTR DisplayInterface::_flush_done_cb(void* arg) {
+    // May run in the SPI ISR during a flash write: nothing here may live in
+    // flash, so LVGL is told from _flush_wait_cb on the LVGL task instead
+    DisplayInterface* self = static_cast<DisplayInterface*>(arg);
+    self->_flush_done_us = (uint32_t)esp_timer_get_time();
+    self->_flush_busy.store(false);
+    
+    if (!self->_flush_done) return;
+    if (xPortInIsrContext()) {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(self->_flush_done, &woken);
+        portYIELD_FROM_ISR(woken);
+    } else {
+        xSemaphoreGive(self->_flush_done);
+    }
+}
+
+void DisplayInterface::_flush_wait_cb(lv_display_t* disp) {
+    if (!instance) return;
+    uint32_t wait_start = micros();
+    // The semaphore may hold a stale give from an earlier flush, so recheck the flag
+    while (instance->_flush_busy.load()) {
+        xSemaphoreTake(instance->_flush_done, pdMS_TO_TICKS(20));
+    }
+    instance->_flush_stats.waitUs += micros() - wait_start;
+    lv_display_flush_ready(disp);
+}
+
+int32_t DisplayInterface::_flush_cost_gauge() {
+    if (!instance || instance->_flush_stats.flushes == 0) return 0;
+    const FlushStats& stats = instance->_flush_stats;
+    return (stats.issueUs + stats.waitUs) / stats.flushes;
+}
+
+void DisplayInterface::_report_flush_stats() {
+    FlushStats& stats = _flush_stats;
+    if (stats.flushes > 0) {
+        Serial.printf("[Display] %s flush: %lu flushes, avg %lu px, issue %lu us, wait %lu us, transfer %lu us\n",
+                      _backend->name(),
+                      (unsigned long)stats.flushes,
+                      (unsigned long)(stats.pixels / stats.flushes),
+                      (unsigned long)(stats.issueUs / stats.flushes),
+                      (unsigned long)(stats.waitUs / stats.flushes),
+                      (unsigned long)(stats.transferUs / stats.flushes));
+    }
+    _flush_stats = FlushStats{};
+    _last_flush_report_ms = millis();
+}
+
 void DisplayInterface::_disp_flush(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
-    if (instance && instance->_tft) {
-        uint32_t w = (area->x2 - area->x1 + 1);
-        uint32_t h = (area->y2 - area->y1 + 1);
+    if (!instance || !instance->_backend) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+    
+    uint32_t flush_start = micros();
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+    FlushStats& stats = instance->_flush_stats;
+    stats.flushes++;
+    stats.pixels += w * h;
+    DisplayBackend* backend = instance->_backend;
+    
+    if (backend->isAsync()) {
+        // LVGL waited for the previous transfer before handing us this buffer
+        if (instance->_flush_start_us) {
+            stats.transferUs += instance->_flush_done_us - instance->_flush_start_us;
+        }
+        
+        instance->_flush_busy.store(true);
+        instance->_flush_start_us = micros();
+        backend->flush(area->x1, area->y1, w, h, px_map);
         
-        instance->_tft->startWrite();
-        instance->_tft->setAddrWindow(area->x1, area->y1, w, h);
-        instance->_tft->writePixels((uint16_t*)px_map, w * h);
-        instance->_tft->endWrite();
+        uint32_t issue_us = micros() - flush_start;
+        stats.issueUs += issue_us;
+#if RENDER_PROFILER
+        RenderProfiler::noteFlush(area, issue_us);
+#endif
+        // lv_display_flush_ready() is called from _flush_wait_cb once the backend reports completion
+        return;
     }
     
+    backend->flush(area->x1, area->y1, w, h, px_map);
+    
+    uint32_t elapsed_us = micros() - flush_start;
+    stats.issueUs += elapsed_us;
+    stats.transferUs += elapsed_us;
+#if RENDER_PROFILER
+    RenderProfiler::noteFlush(area, elapsed_us);
+#endif
+    
     lv_display_flush_ready(disp);
 }
 
@@ -176,20 +496,17 @@ DisplayInterface::~DisplayInterface() {
         _lvgl_mutex = nullptr;
     }
     
-    if (_buf2) {
-        delete[] _buf2;  // Using delete[] for array allocations
-        _buf2 = nullptr;
+    if (_backend) {
+        delete _backend;  // Waits for any transfer still reading the buffers
+        _backend = nullptr;
     }
     
-    if (_buf1) {
-        delete[] _buf1;  // Using delete[] for array allocations
-        _buf1 = nullptr;
+    if (_flush_done) {
+        vSemaphoreDelete(_flush_done);
+        _flush_done = nullptr;
     }
     
-    if (_tft) {
-        delete _tft;
-        _tft = nullptr;
-    }
+    _free_buffers(_buffers);
     
     // Reset the static instance pointer if it points to this object
     if (instance == this) {
@@ -198,6 +515,7 @@ DisplayInterface::~DisplayInterface() {
 }
 
 void DisplayInterface::setBrightness(uint8_t brightness) {
-    // Update the PWM duty cycle on the backlight pin
-    ledcWrite(_backlight_pin, brightness);
-}
\ No newline at end of file
+    if (_backend) {
+        _backend->setBrightness(brightness);
+    }
+}
@@ -1,11 +1,107 @@
 #pragma once
 
 #include <Arduino.h>
-#include <SPI.h>
-#include <Adafruit_ST7789.h>
 #include <lvgl.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <atomic>
+#include "DisplayBackend.h"
+
+/**
+ * @brief Longest the LVGL task sleeps when no LVGL timer is pending
+ * 
+ * Safety net for LVGL changes made by code that bypasses giveMutex().
+ */
+#ifndef LVGL_TASK_MAX_SLEEP_MS
+#define LVGL_TASK_MAX_SLEEP_MS 1000
+#endif
+
+/**
+ * @brief How often the LVGL task logs its wakeup rate, 0 to disable
+ */
+#ifndef LVGL_WAKEUP_REPORT_INTERVAL_MS
+#define LVGL_WAKEUP_REPORT_INTERVAL_MS 60000
+#endif
+
+/**
+ * @brief Refresh rate while LVGL animations run on an on-demand card
+ */
+#ifndef LVGL_ANIMATION_FPS
+#define LVGL_ANIMATION_FPS 20
+#endif
+
+/**
+ * @brief Refresh period when nothing animates
+ * 
+ * LVGL pauses its refresh timer while nothing is invalidated, so this only
+ * caps how often sporadic changes are drawn.
+ */
+#ifndef LVGL_ON_DEMAND_REFR_PERIOD_MS
+#define LVGL_ON_DEMAND_REFR_PERIOD_MS 100
+#endif
+
+/**
+ * @brief Send flushes to the panel by DMA so LVGL renders into one buffer
+ * while the other is on the wire
+ * 
+ * Set to 0 to use the blocking Adafruit writePixels() path. The blocking path
+ * is also used if the DMA bus or buffers cannot be set up.
+ */
+#ifndef DISPLAY_ASYNC_FLUSH
+#define DISPLAY_ASYNC_FLUSH 1
+#endif
+
+/**
+ * @brief Where LVGL renders
+ * 
+ * INTERNAL_STRIPES: two buffer_rows-high stripes in internal DMA RAM. Fastest
+ * to draw into and sent by DMA without copying, at the cost of several
+ * flushes per frame.
+ * PSRAM_FULL_FRAME: two full frames in PSRAM. One flush per frame, but
+ * drawing is slower and each stripe is copied to internal RAM for the SPI.
+ * HYBRID: full frames in PSRAM with two internal bounce stripes, so the copy
+ * of one stripe overlaps the transfer of the previous.
+ */
+enum class RenderBufferStrategy : uint8_t {
+    INTERNAL_STRIPES = 0,
+    PSRAM_FULL_FRAME = 1,
+    HYBRID = 2
+};
+
+/**
+ * @brief Render buffer strategy at boot, as a RenderBufferStrategy value
+ */
+#ifndef DISPLAY_BUFFER_STRATEGY
+#define DISPLAY_BUFFER_STRATEGY 0
+#endif
+
+/**
+ * @brief Render each card with every buffer strategy after boot and log ms/frame
+ */
+#ifndef DISPLAY_BUFFER_BENCHMARK
+#define DISPLAY_BUFFER_BENCHMARK 0
+#endif
+
+/**
+ * @brief SPI clock for DMA flushes
+ */
+#ifndef DISPLAY_SPI_FREQ_HZ
+#define DISPLAY_SPI_FREQ_HZ 40000000
+#endif
+
+/**
+ * @brief How often flush timings are logged, 0 to disable
+ */
+#ifndef DISPLAY_FLUSH_REPORT_INTERVAL_MS
+#define DISPLAY_FLUSH_REPORT_INTERVAL_MS 60000
+#endif
+
+/**
+ * @brief Run the UI on the headless framebuffer backend instead of the panel
+ */
+#ifndef DISPLAY_BACKEND_FRAMEBUFFER
+#define DISPLAY_BACKEND_FRAMEBUFFER 0
+#endif
 
 /**
  * @brief Interface class for TFT display with LVGL integration
@@ -15,12 +111,13 @@
  */
 class DisplayInterface {
 public:
+#if !DISPLAY_BACKEND_FRAMEBUFFER
     /**
      * @brief Construct a new Display Interface object
      * 
      * @param screen_width Width of the display in pixels
      * @param screen_height Height of the display in pixels
-     * @param buffer_rows Number of rows to buffer for LVGL rendering
+     * @param buffer_rows Height of render stripes and bounce buffers in rows
      * @param cs_pin Chip select pin
      * @param dc_pin Data/command pin
      * @param rst_pin Reset pin
@@ -35,6 +132,22 @@ public:
         int8_t rst_pin,
         int8_t backlight_pin
     );
+#endif
+    
+    /**
+     * @brief Construct a Display Interface on another backend
+     * 
+     * @param backend Pixel destination, owned by the Display Interface
+     * @param screen_width Width of the display in pixels
+     * @param screen_height Height of the display in pixels
+     * @param buffer_rows Height of render stripes and bounce buffers in rows
+     */
+    DisplayInterface(
+        DisplayBackend* backend,
+        uint16_t screen_width,
+        uint16_t screen_height,
+        uint16_t buffer_rows
+    );
     
     /**
      * @brief Destroy the Display Interface object and free resources
@@ -47,23 +160,64 @@ public:
     void begin();
     
     /**
-     * @brief Get the underlying TFT display object
-     * 
-     * @return Adafruit_ST7789* Pointer to the display
+     * @brief Get the backend pixels are flushed to
      */
-    Adafruit_ST7789* getDisplay();
+    DisplayBackend* getBackend() { return _backend; }
     
     /**
      * @brief Process LVGL tasks (should be called regularly)
+     * 
+     * @return uint32_t Milliseconds until the next LVGL timer is due,
+     *         LV_NO_TIMER_READY if none is scheduled
+     */
+    uint32_t handleLVGLTasks();
+    
+    /**
+     * @brief Register the task that runs handleLVGLTasks()
+     * 
+     * That task is woken by wakeLVGLTask() and whenever another task
+     * releases the LVGL mutex, since it may have invalidated the screen.
+     */
+    void setLVGLTask(TaskHandle_t task);
+    
+    /**
+     * @brief Wake the LVGL task early (UI dispatch, input)
+     */
+    static void wakeLVGLTask();
+    
+    /**
+     * @brief Block the LVGL task until woken or the timeout passes
+     * 
+     * @param timeout Longest wait in ticks, capped at LVGL_TASK_MAX_SLEEP_MS
+     */
+    void waitForWork(TickType_t timeout);
+    
+    /**
+     * @brief How the display refresh timer is currently paced
+     */
+    enum class RefreshMode : uint8_t {
+        ON_DEMAND,   ///< Static content, redraw only on invalidation
+        ANIMATING,   ///< LVGL animations running, LVGL_ANIMATION_FPS
+        CONTINUOUS,  ///< The card asked for a fixed rate (games)
+        COUNT
+    };
+    
+    /**
+     * @brief Pace the refresh and animation timers; call on the LVGL task
+     * 
+     * @param card_fps Rate requested by the active card, 0 for on demand
      */
-    void handleLVGLTasks();
+    void updateRefreshRate(uint8_t card_fps);
+    
+    RefreshMode getRefreshMode() const { return _refresh_mode; }
     
     /**
-     * @brief FreeRTOS task for LVGL tick handling
+     * @brief LVGL task wakeups per second over the last report interval
      * 
-     * @param arg Task argument (not used)
+     * @param idle Wakeups/s while no animation was running
+     * @param animating Wakeups/s while animations were running
      */
-    static void tickTask(void* arg);
+    void getWakeupRates(float& idle, float& animating) const;
     
     /**
      * @brief Acquire the LVGL mutex
@@ -92,22 +246,126 @@ public:
      * @param brightness Brightness level (0-255)
      */
     void setBrightness(uint8_t brightness);
+    
+    /**
+     * @brief Flush timings, accumulated since the last report
+     * 
+     * issueUs is LVGL task time spent inside the flush callback and waitUs
+     * the time it then blocked for a buffer; together they are what flushing
+     * costs the renderer. transferUs is wall time until the panel had the data.
+     */
+    struct FlushStats {
+        uint32_t flushes;
+        uint32_t pixels;
+        uint32_t issueUs;
+        uint32_t transferUs;
+        uint32_t waitUs;
+    };
+    
+    FlushStats getFlushStats() const { return _flush_stats; }
+    
+    /**
+     * @brief Whether flushes go out by DMA rather than the blocking path
+     */
+    bool isAsyncFlush() const { return _backend && _backend->isAsync(); }
+    
+    /**
+     * @brief Reallocate the render buffers; call on the LVGL task
+     * 
+     * @return false if the new buffers could not be allocated, in which case
+     *         the current ones stay in use
+     */
+    bool setBufferStrategy(RenderBufferStrategy strategy);
+    
+    RenderBufferStrategy getBufferStrategy() const { return _buffers.strategy; }
+    
+    static const char* strategyName(RenderBufferStrategy strategy);
+    
+    /**
+     * @brief Redraw the whole screen synchronously, for benchmarking
+     * 
+     * @return Microseconds until the last pixel reached the panel
+     */
+    uint32_t renderFrameNow();
 
 private:
     uint16_t _screen_width;
     uint16_t _screen_height;
     uint16_t _buffer_rows;
-    int8_t _cs_pin;
-    int8_t _dc_pin;
-    int8_t _rst_pin;
-    int8_t _backlight_pin;
     
-    Adafruit_ST7789* _tft;
+    DisplayBackend* _backend;
     lv_display_t* _display;
-    lv_color_t* _buf1;
-    lv_color_t* _buf2;
+    
+    struct RenderBuffers {
+        RenderBufferStrategy strategy;
+        uint8_t* draw[2];       ///< LVGL render buffers
+        size_t drawBytes;
+        uint8_t* bounce[2];     ///< Internal DMA stripes for flushing from PSRAM
+        uint8_t bounceCount;
+        size_t bounceBytes;
+    };
+    RenderBuffers _buffers;
     SemaphoreHandle_t _lvgl_mutex;
     
+    static TaskHandle_t _lvgl_task;  ///< Task woken by wakeLVGLTask()
+    
+    // Wakeup accounting, split by whether animations were running
+    struct WakeupStats {
+        uint32_t idleWakeups;
+        uint32_t idleMs;
+        uint32_t animatingWakeups;
+        uint32_t animatingMs;
+        uint32_t notifiedWakeups;  ///< Woken early rather than by timeout
+    };
+    WakeupStats _wakeups;
+    uint32_t _last_wakeup_ms;
+    uint32_t _last_report_ms;
+    float _idle_rate;
+    float _animating_rate;
+    
+    // Achieved frame rate and LVGL task load per refresh mode
+    struct ModeStats {
+        uint32_t wallMs;
+        uint32_t sleepMs;
+        uint32_t frames;
+    };
+    RefreshMode _refresh_mode;
+    uint32_t _refresh_period_ms;
+    ModeStats _mode_stats[(size_t)RefreshMode::COUNT];
+    uint32_t _frame_start_us;
+    
+    static void _frame_rendered_cb(lv_event_t* e);
+    
+    // Asynchronous flush completion, signalled by the backend (possibly from an interrupt).
+    // The ISR side only records the time, clears _flush_busy and gives _flush_done;
+    // lv_display_flush_ready() runs on the LVGL task in _flush_wait_cb.
+    SemaphoreHandle_t _flush_done;
+    std::atomic<bool> _flush_busy;
+    uint32_t _flush_start_us;
+    volatile uint32_t _flush_done_us;
+    
+    FlushStats _flush_stats;
+    uint32_t _last_flush_report_ms;
+    
+    void _report_flush_stats();
+    
+    bool _allocate_buffers(RenderBufferStrategy strategy, RenderBuffers& out);
+    static void _free_buffers(RenderBuffers& buffers);
+    
+    /**
+     * @brief Wait until no flush is reading a render or bounce buffer
+     */
+    void _wait_flush_idle();
+    
+    static void IRAM_ATTR _flush_done_cb(void* arg);
+    static void _flush_wait_cb(lv_display_t* disp);
+    static int32_t _flush_cost_gauge();
+    
+    /**
+     * @brief LVGL tick source, read from the esp_timer-backed millis()
+     */
+    static uint32_t _tick_cb();
+    
     /**
      * @brief LVGL display flush callback
      * 
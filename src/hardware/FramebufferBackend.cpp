@@ -0,0 +1,52 @@
+#include "FramebufferBackend.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+FramebufferBackend::FramebufferBackend(uint16_t width, uint16_t height)
+    : _width(width), _height(height), _framebuffer(nullptr), _flushes(0), _frame_stats{} {
+}
+
+FramebufferBackend::~FramebufferBackend() {
+    heap_caps_free(_framebuffer);
+    _framebuffer = nullptr;
+}
+
+bool FramebufferBackend::begin() {
+    size_t bytes = (size_t)_width * _height * sizeof(uint16_t);
+    _framebuffer = (uint16_t*)heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM);
+    if (!_framebuffer) {
+        _framebuffer = (uint16_t*)heap_caps_calloc(1, bytes, MALLOC_CAP_8BIT);
+    }
+    if (!_framebuffer) {
+        Serial.println("[Display] Failed to allocate framebuffer");
+        return false;
+    }
+    Serial.printf("[Display] Headless framebuffer %ux%u\n", _width, _height);
+    return true;
+}
+
+void FramebufferBackend::flush(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* pixels) {
+    if (!_framebuffer) return;
+
+    // LVGL clips to the display, but stay inside the framebuffer regardless
+    if (x < 0 || y < 0 || x + w > _width || y + h > _height) return;
+
+    const uint16_t* src = (const uint16_t*)pixels;
+    for (uint16_t row = 0; row < h; row++) {
+        memcpy(_framebuffer + (size_t)(y + row) * _width + x, src + (size_t)row * w, w * sizeof(uint16_t));
+    }
+    _flushes++;
+}
+
+void FramebufferBackend::frameRendered(uint32_t render_us) {
+    _frame_stats.frames++;
+    _frame_stats.totalUs += render_us;
+    _frame_stats.lastUs = render_us;
+    if (render_us > _frame_stats.worstUs) _frame_stats.worstUs = render_us;
+}
+
+bool FramebufferBackend::writePng(PngWriter::Sink sink, void* ctx) const {
+    if (!_framebuffer) return false;
+    return PngWriter::write(_framebuffer, _width, _height, sink, ctx);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "DisplayBackend.h"
+#include "PngWriter.h"
+
+/**
+ * @class FramebufferBackend
+ * @brief Headless backend that composes flushes into an RGB565 framebuffer
+ *
+ * Lets the UI run, be timed and be captured without a panel attached. The
+ * framebuffer holds exactly what the panel would show, so writePng() gives
+ * golden images for comparing renderer and card output across changes.
+ */
+class FramebufferBackend : public DisplayBackend {
+public:
+    FramebufferBackend(uint16_t width, uint16_t height);
+    ~FramebufferBackend() override;
+
+    bool begin() override;
+    const char* name() const override { return "Framebuffer"; }
+    void flush(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* pixels) override;
+
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+    const uint16_t* pixels() const { return _framebuffer; }
+
+    /**
+     * @brief Flushes received so far, to tell whether the image changed
+     */
+    uint32_t flushCount() const { return _flushes; }
+
+    /**
+     * @brief Render times of the frames drawn since the last reset
+     */
+    struct FrameStats {
+        uint32_t frames;
+        uint64_t totalUs;
+        uint32_t worstUs;
+        uint32_t lastUs;
+    };
+
+    void frameRendered(uint32_t render_us) override;
+    const FrameStats& frameStats() const { return _frame_stats; }
+    void resetFrameStats() { _frame_stats = FrameStats{}; }
+
+    /**
+     * @brief Encode the current framebuffer; hold the LVGL mutex to avoid tearing
+     */
+    bool writePng(PngWriter::Sink sink, void* ctx) const;
+
+private:
+    uint16_t _width;
+    uint16_t _height;
+    uint16_t* _framebuffer;
+    uint32_t _flushes;
+    FrameStats _frame_stats;
+};
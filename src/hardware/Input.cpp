@@ -0,0 +1,171 @@
+#include "Input.h"
+#include <atomic>
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+namespace {
+
+// Button index doubles as the GPIO number on this board
+const gpio_num_t BUTTON_PINS[Input::NUM_BUTTONS] = {
+    (gpio_num_t)Input::BUTTON_DOWN,
+    (gpio_num_t)Input::BUTTON_CENTER,
+    (gpio_num_t)Input::BUTTON_UP
+};
+
+// Level that means "pressed": BOOT is pulled up, the others pulled down
+const int PRESSED_LEVEL[Input::NUM_BUTTONS] = { LOW, HIGH, HIGH };
+
+// Single producer (the GPIO ISR, which does not nest with itself) and
+// single consumer (the LVGL task)
+constexpr uint16_t EDGE_CAPACITY = 64;
+ButtonEdge edgeRing[EDGE_CAPACITY];
+std::atomic<uint16_t> edgeHead(0);  ///< Next slot the ISR writes
+std::atomic<uint16_t> edgeTail(0);  ///< Next slot the LVGL task reads
+std::atomic<uint32_t> edgesDropped(0);
+std::atomic<bool> edgeOverflow(false);
+
+TaskHandle_t notifyTask = nullptr;
+
+ButtonGestures::Config gestureConfig() {
+    ButtonGestures::Config config;
+    config.debounce_us = 5000;
+    config.repeat_mask = (1u << Input::BUTTON_UP) | (1u << Input::BUTTON_DOWN);
+    // Power-off chord: CENTER + DOWN held for 2 seconds
+    config.chord_mask = (1u << Input::BUTTON_CENTER) | (1u << Input::BUTTON_DOWN);
+    config.chord_hold_us = 2000000;
+    // CENTER and DOWN presses wait this long for the other before acting
+    config.chord_window_us = 50000;
+    return config;
+}
+
+ButtonGestures gestures(Input::NUM_BUTTONS, gestureConfig());
+
+ButtonEvent frameEvents[ButtonGestures::EVENT_CAPACITY];
+size_t frameEventCount = 0;
+size_t frameEventRead = 0;
+uint8_t pressedFlags = 0;
+uint8_t releasedFlags = 0;
+
+void ARDUINO_ISR_ATTR onButtonEdge(void* arg) {
+    uint8_t button = (uint8_t)(uintptr_t)arg;
+    gpio_num_t pin = BUTTON_PINS[button];
+    int level = gpio_get_level(pin);
+
+    // Re-arm on the opposite level; this also moves the light-sleep wakeup level
+    gpio_set_intr_type(pin, level ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+
+    uint16_t head = edgeHead.load(std::memory_order_relaxed);
+    uint16_t next = (head + 1) % EDGE_CAPACITY;
+    if (next == edgeTail.load(std::memory_order_acquire)) {
+        edgesDropped.fetch_add(1, std::memory_order_relaxed);
+        edgeOverflow.store(true, std::memory_order_relaxed);
+    } else {
+        edgeRing[head] = {button, level == PRESSED_LEVEL[button], (uint32_t)esp_timer_get_time()};
+        edgeHead.store(next, std::memory_order_release);
+    }
+
+    if (notifyTask) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(notifyTask, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+} // namespace
+
+void Input::configureButtons() {
+    // BOOT button has built-in pullup, active LOW
+    pinMode(BUTTON_PINS[BUTTON_DOWN], INPUT_PULLUP);
+    // Configure CENTER and UP buttons with pulldown, active HIGH
+    pinMode(BUTTON_PINS[BUTTON_CENTER], INPUT_PULLDOWN);
+    pinMode(BUTTON_PINS[BUTTON_UP], INPUT_PULLDOWN);
+
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        int level = digitalRead(BUTTON_PINS[i]);
+        gestures.reset(i, level == PRESSED_LEVEL[i], now_us);
+
+        // Level interrupts (not edges) so the same trigger can wake light sleep
+        int trigger = level ? ONLOW : ONHIGH;
+        attachInterruptArg(BUTTON_PINS[i], onButtonEdge, (void*)(uintptr_t)i, trigger);
+        gpio_wakeup_enable(BUTTON_PINS[i], level ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+    esp_sleep_enable_gpio_wakeup();
+}
+
+void Input::setNotifyTask(TaskHandle_t task) {
+    notifyTask = task;
+}
+
+void Input::process() {
+    pressedFlags = 0;
+    releasedFlags = 0;
+    frameEventCount = 0;
+    frameEventRead = 0;
+
+    uint16_t tail = edgeTail.load(std::memory_order_relaxed);
+    uint16_t head = edgeHead.load(std::memory_order_acquire);
+    while (tail != head) {
+        gestures.feed(edgeRing[tail]);
+        tail = (tail + 1) % EDGE_CAPACITY;
+    }
+    edgeTail.store(tail, std::memory_order_release);
+
+    uint32_t now_us = (uint32_t)esp_timer_get_time();
+    if (edgeOverflow.exchange(false, std::memory_order_relaxed)) {
+        // Edges were lost: resynchronise with the pins as they are now
+        for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+            gestures.feed({i, digitalRead(BUTTON_PINS[i]) == PRESSED_LEVEL[i], now_us});
+        }
+        Serial.printf("[Input] Edge ring overflowed, %lu edges dropped so far\n",
+                      (unsigned long)edgesDropped.load(std::memory_order_relaxed));
+    }
+    gestures.poll(now_us);
+
+    ButtonEvent event;
+    while (frameEventCount < ButtonGestures::EVENT_CAPACITY && gestures.nextEvent(event)) {
+        if (event.type == ButtonEventType::PRESS) {
+            pressedFlags |= (1u << event.button);
+        } else if (event.type == ButtonEventType::RELEASE) {
+            releasedFlags |= (1u << event.button);
+        }
+        frameEvents[frameEventCount++] = event;
+    }
+}
+
+bool Input::nextEvent(ButtonEvent& event) {
+    if (frameEventRead >= frameEventCount) return false;
+    event = frameEvents[frameEventRead++];
+    return true;
+}
+
+TickType_t Input::ticksUntilNextDeadline() {
+    // Edges already waiting need processing straight away
+    if (edgeTail.load(std::memory_order_relaxed) != edgeHead.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    uint32_t wait_us = gestures.nextDeadlineUs((uint32_t)esp_timer_get_time());
+    if (wait_us == ButtonGestures::NO_DEADLINE) {
+        return portMAX_DELAY;
+    }
+    // Round up so the deadline has passed when the task wakes
+    TickType_t ticks = pdMS_TO_TICKS((wait_us + 999) / 1000);
+    return (wait_us > 0 && ticks == 0) ? 1 : ticks;
+}
+
+bool Input::isHeld(uint8_t button) {
+    return gestures.isPressed(button);
+}
+
+bool Input::wasPressed(uint8_t button) {
+    return button < NUM_BUTTONS && (pressedFlags & (1u << button));
+}
+
+bool Input::wasReleased(uint8_t button) {
+    return button < NUM_BUTTONS && (releasedFlags & (1u << button));
+}
+
+uint32_t Input::droppedEdges() {
+    return edgesDropped.load(std::memory_order_relaxed);
+}
@@ -1,45 +1,75 @@
 #pragma once
 
 #include <Arduino.h>
-#include <Bounce2.h>
-
-// Forward declare the external buttons array
-extern Bounce2::Button buttons[];
+#include "ButtonGestures.h"
 
+/**
+ * @class Input
+ * @brief Interrupt-driven button input
+ *
+ * Each button pin raises a level interrupt that flips polarity on every
+ * change, so it behaves like an edge interrupt and still works as a
+ * light-sleep wakeup source. The ISR stores the new level and an esp_timer
+ * timestamp in a lock-free ring and notifies the LVGL task. process() drains
+ * the ring on the LVGL task, runs the edges through ButtonGestures and
+ * latches per-frame pressed/released flags for cards that poll buttons.
+ */
 class Input {
 public:
     static const uint8_t BUTTON_DOWN = 0;    // BOOT button - pulled HIGH by default, LOW when pressed
     static const uint8_t BUTTON_CENTER = 1;  //pulled LOW by default, HIGH when pressed
     static const uint8_t BUTTON_UP = 2;      //pulled LOW by default, HIGH when pressed
+    static const uint8_t NUM_BUTTONS = 3;
 
-    static void configureButtons() {
-        // BOOT button has built-in pullup, active LOW
-        buttons[BUTTON_DOWN].attach(BUTTON_DOWN, INPUT_PULLUP);
-        buttons[BUTTON_DOWN].interval(5);
-        buttons[BUTTON_DOWN].setPressedState(LOW);
-        
-        // Configure CENTER and UP buttons with pulldown, active HIGH
-        buttons[BUTTON_CENTER].attach(BUTTON_CENTER, INPUT_PULLDOWN);
-        buttons[BUTTON_CENTER].interval(5);
-        buttons[BUTTON_CENTER].setPressedState(HIGH);
-        
-        buttons[BUTTON_UP].attach(BUTTON_UP, INPUT_PULLDOWN);
-        buttons[BUTTON_UP].interval(5);
-        buttons[BUTTON_UP].setPressedState(HIGH);
-    }
-
-    static void update() {
-        buttons[BUTTON_DOWN].update();
-        buttons[BUTTON_CENTER].update();
-        buttons[BUTTON_UP].update();
-    }
-
-    static bool isDownPressed() { return buttons[BUTTON_DOWN].pressed(); }
-    static bool isCenterPressed() { return buttons[BUTTON_CENTER].pressed(); }
-    static bool isUpPressed() { return buttons[BUTTON_UP].pressed(); }
-
-    static bool isDownReleased() { return buttons[BUTTON_DOWN].released(); }
-    static bool isCenterReleased() { return buttons[BUTTON_CENTER].released(); }
-    static bool isUpReleased() { return buttons[BUTTON_UP].released(); }
-};
+    /**
+     * @brief Configure pins, attach the ISRs and enable GPIO wakeup
+     */
+    static void configureButtons();
+
+    /**
+     * @brief Task notified (xTaskNotifyGive) whenever an edge arrives
+     */
+    static void setNotifyTask(TaskHandle_t task);
+
+    /**
+     * @brief Drain captured edges and run the gesture detectors
+     *
+     * Call from the LVGL task before dispatching events. Clears the
+     * per-frame pressed/released flags from the previous call.
+     */
+    static void process();
+
+    /**
+     * @brief Take the next debounced event produced by process()
+     */
+    static bool nextEvent(ButtonEvent& event);
+
+    /**
+     * @brief Ticks until process() must run again, portMAX_DELAY if idle
+     */
+    static TickType_t ticksUntilNextDeadline();
 
+    /**
+     * @brief Debounced level
+     */
+    static bool isHeld(uint8_t button);
+
+    /**
+     * @brief Press/release seen by the latest process() call
+     */
+    static bool wasPressed(uint8_t button);
+    static bool wasReleased(uint8_t button);
+
+    /**
+     * @brief Edges lost because the ring was full
+     */
+    static uint32_t droppedEdges();
+
+    static bool isDownPressed() { return wasPressed(BUTTON_DOWN); }
+    static bool isCenterPressed() { return wasPressed(BUTTON_CENTER); }
+    static bool isUpPressed() { return wasPressed(BUTTON_UP); }
+
+    static bool isDownReleased() { return wasReleased(BUTTON_DOWN); }
+    static bool isCenterReleased() { return wasReleased(BUTTON_CENTER); }
+    static bool isUpReleased() { return wasReleased(BUTTON_UP); }
+};
@@ -0,0 +1,148 @@
+#include "PngWriter.h"
+#include <string.h>
+
+namespace {
+
+uint32_t crcTable[256];
+bool crcTableReady = false;
+
+void buildCrcTable() {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        crcTable[n] = c;
+    }
+    crcTableReady = true;
+}
+
+uint32_t crcUpdate(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+void putBE32(uint8_t* out, uint32_t value) {
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+}
+
+// Streams one IDAT chunk, tracking its CRC and the zlib Adler-32
+class ChunkStream {
+public:
+    ChunkStream(PngWriter::Sink sink, void* ctx) : _sink(sink), _ctx(ctx), _ok(true), _crc(0) {}
+
+    void begin(const char* type, uint32_t length) {
+        uint8_t header[8];
+        putBE32(header, length);
+        memcpy(header + 4, type, 4);
+        emit(header, 4);
+        _crc = 0xFFFFFFFFu;
+        data((const uint8_t*)type, 4);
+    }
+
+    void data(const uint8_t* bytes, size_t length) {
+        _crc = crcUpdate(_crc, bytes, length);
+        emit(bytes, length);
+    }
+
+    void end() {
+        uint8_t crc[4];
+        putBE32(crc, _crc ^ 0xFFFFFFFFu);
+        emit(crc, 4);
+    }
+
+    bool ok() const { return _ok; }
+
+private:
+    void emit(const uint8_t* bytes, size_t length) {
+        if (_ok && length > 0) {
+            _ok = _sink(_ctx, bytes, length);
+        }
+    }
+
+    PngWriter::Sink _sink;
+    void* _ctx;
+    bool _ok;
+    uint32_t _crc;
+};
+
+} // namespace
+
+bool PngWriter::write(const uint16_t* pixels, uint16_t width, uint16_t height, Sink sink, void* ctx) {
+    if (width == 0 || height == 0 || width > MAX_WIDTH) {
+        return false;
+    }
+    if (!crcTableReady) {
+        buildCrcTable();
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (!sink(ctx, signature, sizeof(signature))) {
+        return false;
+    }
+
+    ChunkStream chunk(sink, ctx);
+
+    // 8-bit RGB, no interlace
+    uint8_t ihdr[13] = {};
+    putBE32(ihdr, width);
+    putBE32(ihdr + 4, height);
+    ihdr[8] = 8;
+    ihdr[9] = 2;
+    chunk.begin("IHDR", sizeof(ihdr));
+    chunk.data(ihdr, sizeof(ihdr));
+    chunk.end();
+
+    // One stored deflate block per scanline: filter byte + RGB triplets
+    const uint32_t row_bytes = 1 + (uint32_t)width * 3;
+    const uint32_t block_bytes = 5 + row_bytes;
+    const uint32_t idat_length = 2 + block_bytes * height + 4;
+    chunk.begin("IDAT", idat_length);
+
+    const uint8_t zlib_header[2] = {0x78, 0x01};
+    chunk.data(zlib_header, sizeof(zlib_header));
+
+    uint32_t adler_a = 1;
+    uint32_t adler_b = 0;
+    uint8_t row[1 + MAX_WIDTH * 3];
+    for (uint16_t y = 0; y < height && chunk.ok(); y++) {
+        uint8_t block_header[5];
+        block_header[0] = (y == height - 1) ? 1 : 0;  // BFINAL on the last block
+        block_header[1] = row_bytes & 0xFF;
+        block_header[2] = row_bytes >> 8;
+        block_header[3] = ~row_bytes & 0xFF;
+        block_header[4] = (~row_bytes >> 8) & 0xFF;
+        chunk.data(block_header, sizeof(block_header));
+
+        row[0] = 0;  // Filter: none
+        const uint16_t* src = pixels + (size_t)y * width;
+        for (uint16_t x = 0; x < width; x++) {
+            uint16_t c = src[x];
+            uint8_t r = (c >> 11) & 0x1F;
+            uint8_t g = (c >> 5) & 0x3F;
+            uint8_t b = c & 0x1F;
+            row[1 + x * 3] = (r << 3) | (r >> 2);
+            row[2 + x * 3] = (g << 2) | (g >> 4);
+            row[3 + x * 3] = (b << 3) | (b >> 2);
+        }
+        for (uint32_t i = 0; i < row_bytes; i++) {
+            adler_a = (adler_a + row[i]) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+        }
+        chunk.data(row, row_bytes);
+    }
+
+    uint8_t adler[4];
+    putBE32(adler, (adler_b << 16) | adler_a);
+    chunk.data(adler, sizeof(adler));
+    chunk.end();
+
+    chunk.begin("IEND", 0);
+    chunk.end();
+    return chunk.ok();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @class PngWriter
+ * @brief Encodes an RGB565 framebuffer as a PNG
+ *
+ * Uses stored (uncompressed) deflate blocks, so encoding needs no
+ * compression state and only one scanline of scratch. Output is about
+ * width * height * 3 bytes, which is fine for golden images and screenshots.
+ * Has no Arduino or LVGL dependencies so it also builds on a host.
+ */
+class PngWriter {
+public:
+    /**
+     * @brief Receives the encoded bytes in order
+     * @return false to abort encoding
+     */
+    using Sink = bool (*)(void* ctx, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Encode a framebuffer
+     *
+     * @param pixels Little-endian RGB565, row-major, stride = width
+     * @return false if the sink failed or the image is too wide
+     */
+    static bool write(const uint16_t* pixels, uint16_t width, uint16_t height, Sink sink, void* ctx);
+
+    static constexpr uint16_t MAX_WIDTH = 320;
+};
@@ -0,0 +1,121 @@
+#include "St7789Backend.h"
+#include "DisplayInterface.h"
+#include <lvgl.h>
+#include <esp_memory_utils.h>
+
+St7789Backend::St7789Backend(uint16_t width, uint16_t height, int8_t cs_pin, int8_t dc_pin, int8_t rst_pin,
+                             int8_t backlight_pin)
+    : _width(width), _height(height), _cs_pin(cs_pin), _dc_pin(dc_pin), _rst_pin(rst_pin),
+      _backlight_pin(backlight_pin), _tft(nullptr), _dma(nullptr), _done(nullptr), _done_arg(nullptr),
+      _bounce{}, _bounce_count(0), _bounce_bytes(0) {
+    _tft = new ST7789Panel(&SPI, _cs_pin, _dc_pin, _rst_pin);
+}
+
+St7789Backend::~St7789Backend() {
+    if (_dma) {
+        delete _dma;  // Waits for any transfer still reading the buffers
+        _dma = nullptr;
+    }
+    if (_tft) {
+        delete _tft;
+        _tft = nullptr;
+    }
+}
+
+bool St7789Backend::begin() {
+    if (!_tft) {
+        Serial.println("Failed to create TFT object");
+        return false;
+    }
+
+    // Initialize SPI
+    SPI.begin();
+
+    // Initialize display
+    _tft->init(_height, _width);
+    _tft->setRotation(1);
+
+    // Configure backlight with PWM for brightness control
+    pinMode(_backlight_pin, OUTPUT);
+
+    // Set up PWM on the backlight pin using new ESP32 Arduino Core 3.x API
+    // Attach pin with 5000 Hz frequency and 8-bit resolution
+    ledcAttach(_backlight_pin, 5000, 8);
+
+    // Set brightness to 80% (204 out of 255)
+    ledcWrite(_backlight_pin, 204);
+    Serial.println("Display backlight set to 80% brightness");
+
+    _tft->fillScreen(ST77XX_BLACK);
+
+#if DISPLAY_ASYNC_FLUSH
+    if (!_start_dma()) {
+        Serial.println("[Display] DMA flush unavailable, using blocking flushes");
+    }
+#endif
+    return true;
+}
+
+bool St7789Backend::_start_dma() {
+    // The panel is initialised; hand its pins from Arduino SPI to the SPI master driver
+    SPI.end();
+    St7789DmaWriter* writer = new St7789DmaWriter();
+    if (!writer->begin(*_tft, MOSI, SCK, _cs_pin, _dc_pin, DISPLAY_SPI_FREQ_HZ,
+                       _width * _height, _dma_done_cb, this)) {
+        delete writer;
+        SPI.begin();
+        return false;
+    }
+
+    _dma = writer;
+    return true;
+}
+
+void IRAM_ATTR St7789Backend::_dma_done_cb(void* arg) {
+    St7789Backend* self = static_cast<St7789Backend*>(arg);
+    if (self->_done) {
+        self->_done(self->_done_arg);
+    }
+}
+
+void St7789Backend::setFlushDoneCallback(FlushDoneFn done, void* arg) {
+    _done = done;
+    _done_arg = arg;
+}
+
+void St7789Backend::setBounceBuffers(uint8_t* const* bounce, size_t count, size_t bytes) {
+    _bounce_count = count > 2 ? 2 : count;
+    for (size_t i = 0; i < 2; i++) {
+        _bounce[i] = i < _bounce_count ? bounce[i] : nullptr;
+    }
+    _bounce_bytes = bytes;
+}
+
+void St7789Backend::waitIdle() {
+    if (_dma) {
+        _dma->waitIdle();
+    }
+}
+
+void St7789Backend::flush(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* pixels) {
+    if (_dma) {
+        if (esp_ptr_dma_capable(pixels)) {
+            // The panel wants big-endian RGB565; writePixels() used to swap on the fly
+            lv_draw_sw_rgb565_swap(pixels, (uint32_t)w * h);
+            _dma->writePixels(x, y, w, h, pixels);
+        } else {
+            _dma->writePixelsBounced(x, y, w, h, pixels, _bounce, _bounce_count, _bounce_bytes);
+        }
+        return;
+    }
+
+    _tft->startWrite();
+    _tft->setAddrWindow(x, y, w, h);
+    _tft->writePixels((uint16_t*)pixels, (uint32_t)w * h);
+    _tft->endWrite();
+}
+
+void St7789Backend::setBrightness(uint8_t brightness) {
+    // Update the PWM duty cycle on the backlight pin
+    ledcWrite(_backlight_pin, brightness);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "DisplayBackend.h"
+#include "St7789Dma.h"
+
+/**
+ * @class St7789Backend
+ * @brief The board's ST7789 panel over SPI
+ *
+ * The Adafruit driver initialises the panel. Flushes then go out by DMA
+ * when DISPLAY_ASYNC_FLUSH is set and the SPI master driver comes up, and
+ * through the blocking Adafruit writePixels() otherwise.
+ */
+class St7789Backend : public DisplayBackend {
+public:
+    St7789Backend(uint16_t width, uint16_t height, int8_t cs_pin, int8_t dc_pin, int8_t rst_pin,
+                  int8_t backlight_pin);
+    ~St7789Backend() override;
+
+    bool begin() override;
+    const char* name() const override { return _dma ? "DMA" : "Blocking"; }
+    void flush(int16_t x, int16_t y, uint16_t w, uint16_t h, uint8_t* pixels) override;
+    bool isAsync() const override { return _dma != nullptr; }
+    void setFlushDoneCallback(FlushDoneFn done, void* arg) override;
+    void setBounceBuffers(uint8_t* const* bounce, size_t count, size_t bytes) override;
+    void waitIdle() override;
+    void setBrightness(uint8_t brightness) override;
+
+private:
+    /**
+     * @brief Move flushing to DMA once the panel is initialised
+     */
+    bool _start_dma();
+
+    static void IRAM_ATTR _dma_done_cb(void* arg);  // SPI ISR
+
+    uint16_t _width;
+    uint16_t _height;
+    int8_t _cs_pin;
+    int8_t _dc_pin;
+    int8_t _rst_pin;
+    int8_t _backlight_pin;
+
+    ST7789Panel* _tft;
+    St7789DmaWriter* _dma;  ///< Set once DMA flushing is running
+    FlushDoneFn _done;
+    void* _done_arg;
+    uint8_t* _bounce[2];
+    size_t _bounce_count;
+    size_t _bounce_bytes;
+};
@@ -0,0 +1,230 @@
+#include "St7789Dma.h"
+#include <driver/gpio.h>
+#include <string.h>
+
+namespace {
+
+// Transaction user field: writer pointer with two tag bits in the alignment
+constexpr uintptr_t TAG_DATA = 0x1;   ///< DC high (data) rather than low (command)
+constexpr uintptr_t TAG_LAST = 0x2;   ///< Final chunk of a write
+constexpr uintptr_t TAG_MASK = 0x3;
+
+void* tagged(St7789DmaWriter* writer, uintptr_t tags) {
+    return (void*)((uintptr_t)writer | tags);
+}
+
+// Copy RGB565 pixels, swapping the bytes of each; a word at a time when aligned
+void copySwapped(uint8_t* dst, const uint8_t* src, size_t length) {
+    size_t i = 0;
+    if ((((uintptr_t)dst | (uintptr_t)src) & 3) == 0) {
+        const uint32_t* src_words = (const uint32_t*)src;
+        uint32_t* dst_words = (uint32_t*)dst;
+        for (; i + 4 <= length; i += 4) {
+            uint32_t v = *src_words++;
+            *dst_words++ = ((v & 0xFF00FF00u) >> 8) | ((v & 0x00FF00FFu) << 8);
+        }
+    }
+    for (; i < length; i += 2) {
+        dst[i] = src[i + 1];
+        dst[i + 1] = src[i];
+    }
+}
+
+} // namespace
+
+St7789DmaWriter::St7789DmaWriter()
+    : _device(nullptr), _host(SPI3_HOST), _bus_initialized(false), _x_offset(0), _y_offset(0),
+      _dc_pin(-1), _chunks{}, _queued(0), _done(nullptr), _done_arg(nullptr) {
+}
+
+St7789DmaWriter::~St7789DmaWriter() {
+    if (_device) {
+        waitIdle();
+        spi_bus_remove_device(_device);
+        _device = nullptr;
+    }
+    if (_bus_initialized) {
+        spi_bus_free(_host);
+        _bus_initialized = false;
+    }
+}
+
+bool St7789DmaWriter::begin(const ST7789Panel& panel, int8_t mosi_pin, int8_t sck_pin, int8_t cs_pin, int8_t dc_pin,
+                            uint32_t clock_hz, size_t max_pixels, DoneCallback done, void* done_arg) {
+    size_t max_bytes = max_pixels * 2;
+    if ((max_bytes + CHUNK_BYTES - 1) / CHUNK_BYTES > MAX_CHUNKS) {
+        Serial.printf("[DisplayDMA] %u byte writes need more than %u chunks\n",
+                      (unsigned)max_bytes, (unsigned)MAX_CHUNKS);
+        return false;
+    }
+
+    _x_offset = panel.columnOffset();
+    _y_offset = panel.rowOffset();
+    _dc_pin = dc_pin;
+    _done = done;
+    _done_arg = done_arg;
+
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = mosi_pin;
+    bus.miso_io_num = -1;
+    bus.sclk_io_num = sck_pin;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = CHUNK_BYTES;
+
+    // SPI3 so the Arduino SPI object (FSPI) never shares a peripheral with us
+    esp_err_t err = spi_bus_initialize(_host, &bus, SPI_DMA_CH_AUTO);
+    if (err != ESP_OK) {
+        Serial.printf("[DisplayDMA] spi_bus_initialize failed: %s\n", esp_err_to_name(err));
+        return false;
+    }
+    _bus_initialized = true;
+
+    spi_device_interface_config_t dev = {};
+    dev.clock_speed_hz = clock_hz;
+    dev.mode = panel.spiDataMode();
+    dev.spics_io_num = cs_pin;
+    dev.queue_size = MAX_CHUNKS;
+    dev.flags = SPI_DEVICE_HALFDUPLEX | SPI_DEVICE_NO_DUMMY;
+    dev.pre_cb = preTransferCb;
+    dev.post_cb = postTransferCb;
+
+    err = spi_bus_add_device(_host, &dev, &_device);
+    if (err != ESP_OK) {
+        Serial.printf("[DisplayDMA] spi_bus_add_device failed: %s\n", esp_err_to_name(err));
+        spi_bus_free(_host);
+        _bus_initialized = false;
+        return false;
+    }
+
+    gpio_set_direction((gpio_num_t)_dc_pin, GPIO_MODE_OUTPUT);
+    Serial.printf("[DisplayDMA] Ready at %lu Hz, offsets %d,%d\n",
+                  (unsigned long)clock_hz, _x_offset, _y_offset);
+    return true;
+}
+
+void IRAM_ATTR St7789DmaWriter::preTransferCb(spi_transaction_t* trans) {
+    uintptr_t user = (uintptr_t)trans->user;
+    St7789DmaWriter* writer = (St7789DmaWriter*)(user & ~TAG_MASK);
+    gpio_set_level((gpio_num_t)writer->_dc_pin, (user & TAG_DATA) ? 1 : 0);
+}
+
+void IRAM_ATTR St7789DmaWriter::postTransferCb(spi_transaction_t* trans) {
+    uintptr_t user = (uintptr_t)trans->user;
+    if (!(user & TAG_LAST)) return;
+    St7789DmaWriter* writer = (St7789DmaWriter*)(user & ~TAG_MASK);
+    if (writer->_done) {
+        writer->_done(writer->_done_arg);
+    }
+}
+
+void St7789DmaWriter::sendCommand(uint8_t command, const uint8_t* data, size_t length) {
+    spi_transaction_t trans = {};
+    trans.length = 8;
+    trans.flags = SPI_TRANS_USE_TXDATA;
+    trans.tx_data[0] = command;
+    trans.user = tagged(this, 0);
+    spi_device_polling_transmit(_device, &trans);
+
+    if (length == 0) return;
+    trans = {};
+    trans.length = length * 8;
+    trans.flags = SPI_TRANS_USE_TXDATA;
+    memcpy(trans.tx_data, data, length);
+    trans.user = tagged(this, TAG_DATA);
+    spi_device_polling_transmit(_device, &trans);
+}
+
+void St7789DmaWriter::reclaimOne() {
+    spi_transaction_t* done;
+    spi_device_get_trans_result(_device, &done, portMAX_DELAY);
+    _queued--;
+}
+
+void St7789DmaWriter::waitIdle() {
+    while (_queued > 0) {
+        reclaimOne();
+    }
+}
+
+void St7789DmaWriter::setWindow(int16_t x, int16_t y, uint16_t w, uint16_t h) {
+    uint16_t x0 = x + _x_offset;
+    uint16_t y0 = y + _y_offset;
+    uint16_t x1 = x0 + w - 1;
+    uint16_t y1 = y0 + h - 1;
+    const uint8_t columns[4] = {(uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1};
+    const uint8_t rows[4] = {(uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1};
+    sendCommand(ST77XX_CASET, columns, sizeof(columns));
+    sendCommand(ST77XX_RASET, rows, sizeof(rows));
+    sendCommand(ST77XX_RAMWR, nullptr, 0);
+}
+
+bool St7789DmaWriter::queueChunk(spi_transaction_t& chunk, const uint8_t* data, size_t length, bool last) {
+    chunk = {};
+    chunk.length = length * 8;
+    chunk.tx_buffer = data;
+    chunk.user = tagged(this, TAG_DATA | (last ? TAG_LAST : 0));
+    if (spi_device_queue_trans(_device, &chunk, portMAX_DELAY) != ESP_OK) {
+        Serial.println("[DisplayDMA] Failed to queue pixel data");
+        return false;
+    }
+    _queued++;
+    return true;
+}
+
+void St7789DmaWriter::finishWrite(bool queued_last) {
+    // The last chunk never went out, so the interrupt will not report completion
+    if (!queued_last) {
+        waitIdle();
+        if (_done) {
+            _done(_done_arg);
+        }
+    }
+}
+
+void St7789DmaWriter::writePixels(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* pixels) {
+    // Polling transactions may not overlap queued ones
+    waitIdle();
+    setWindow(x, y, w, h);
+
+    size_t remaining = (size_t)w * h * 2;
+    bool queued_last = false;
+    while (remaining > 0 && _queued < MAX_CHUNKS) {
+        size_t length = remaining > CHUNK_BYTES ? CHUNK_BYTES : remaining;
+        remaining -= length;
+        if (!queueChunk(_chunks[_queued], pixels, length, remaining == 0)) break;
+        queued_last = (remaining == 0);
+        pixels += length;
+    }
+    finishWrite(queued_last);
+}
+
+void St7789DmaWriter::writePixelsBounced(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* pixels,
+                                         uint8_t* const* bounce, size_t bounce_count, size_t bounce_bytes) {
+    waitIdle();
+    setWindow(x, y, w, h);
+
+    if (bounce_count > MAX_CHUNKS) bounce_count = MAX_CHUNKS;
+    if (bounce_bytes > CHUNK_BYTES) bounce_bytes = CHUNK_BYTES;
+    bounce_bytes &= ~(size_t)1;  // Whole pixels only
+
+    size_t remaining = (size_t)w * h * 2;
+    bool queued_last = false;
+    for (size_t n = 0; remaining > 0 && bounce_count > 0 && bounce_bytes > 0; n++) {
+        size_t length = remaining > bounce_bytes ? bounce_bytes : remaining;
+        remaining -= length;
+
+        // Results come back in order, so this frees the buffer queued bounce_count stripes ago
+        if (_queued >= bounce_count) {
+            reclaimOne();
+        }
+
+        uint8_t* stripe = bounce[n % bounce_count];
+        copySwapped(stripe, pixels, length);
+        pixels += length;
+
+        if (!queueChunk(_chunks[n % MAX_CHUNKS], stripe, length, remaining == 0)) break;
+        queued_last = (remaining == 0);
+    }
+    finishWrite(queued_last);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include <driver/spi_master.h>
+
+/**
+ * @class ST7789Panel
+ * @brief Adafruit_ST7789 with the panel geometry exposed
+ *
+ * The Adafruit driver still performs panel init and rotation; the DMA writer
+ * needs the resulting RAM offsets and SPI mode to address the panel itself.
+ */
+class ST7789Panel : public Adafruit_ST7789 {
+public:
+    using Adafruit_ST7789::Adafruit_ST7789;
+
+    int16_t columnOffset() const { return _xstart; }
+    int16_t rowOffset() const { return _ystart; }
+    uint8_t spiDataMode() const { return spiMode; }
+};
+
+/**
+ * @class St7789DmaWriter
+ * @brief Queues pixel transfers to an ST7789 through the ESP-IDF SPI master
+ *
+ * Takes over the panel's SPI pins after the Adafruit driver has initialised
+ * it. writePixels() sends the address window with short polling
+ * transactions and queues the pixel data for DMA, returning immediately;
+ * the done callback runs from the SPI interrupt once the last byte is out.
+ * Only one write may be in flight: callers wait for the callback before
+ * starting the next one, as LVGL does between flushes.
+ */
+class St7789DmaWriter {
+public:
+    /**
+     * @brief Called from interrupt context when a write has completed
+     *
+     * Runs from the SPI ISR, which stays enabled during flash writes, so it
+     * must be IRAM_ATTR and touch only internal RAM.
+     */
+    using DoneCallback = void (*)(void* arg);
+
+    St7789DmaWriter();
+    ~St7789DmaWriter();
+
+    /**
+     * @brief Attach the SPI master driver to the panel's pins
+     *
+     * @param panel Initialised panel, used for offsets and SPI mode
+     * @param max_pixels Largest write that will be requested
+     * @return false if the bus or device could not be set up
+     */
+    bool begin(const ST7789Panel& panel, int8_t mosi_pin, int8_t sck_pin, int8_t cs_pin, int8_t dc_pin,
+               uint32_t clock_hz, size_t max_pixels, DoneCallback done, void* done_arg);
+
+    /**
+     * @brief Start writing a block of big-endian RGB565 pixels
+     *
+     * @param pixels Must be DMA-capable and stay untouched until the done callback
+     */
+    void writePixels(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* pixels);
+
+    /**
+     * @brief Write pixels the DMA cannot read directly (e.g. from PSRAM)
+     *
+     * The source is copied and byte-swapped into the bounce buffers one
+     * stripe at a time. With two bounce buffers the copy of one stripe
+     * overlaps the transfer of the previous; with one they alternate. Returns
+     * once the last stripe is queued.
+     *
+     * @param pixels Little-endian RGB565, as LVGL renders it
+     * @param bounce DMA-capable buffers of bounce_bytes each
+     */
+    void writePixelsBounced(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint8_t* pixels,
+                            uint8_t* const* bounce, size_t bounce_count, size_t bounce_bytes);
+
+    /**
+     * @brief Block until the previous write has finished and reclaim its transactions
+     */
+    void waitIdle();
+
+    /**
+     * @brief Largest single transfer, and so the largest useful bounce buffer
+     */
+    static constexpr size_t CHUNK_BYTES = 32000;
+
+private:
+    // The SPI peripheral moves at most 2^18 bits per transaction
+    static constexpr size_t MAX_CHUNKS = 6;
+
+    static void IRAM_ATTR preTransferCb(spi_transaction_t* trans);
+    static void IRAM_ATTR postTransferCb(spi_transaction_t* trans);
+
+    void sendCommand(uint8_t command, const uint8_t* data, size_t length);
+    void setWindow(int16_t x, int16_t y, uint16_t w, uint16_t h);
+    bool queueChunk(spi_transaction_t& chunk, const uint8_t* data, size_t length, bool last);
+    void reclaimOne();
+    void finishWrite(bool queued_last);
+
+    spi_device_handle_t _device;
+    spi_host_device_t _host;
+    bool _bus_initialized;
+    int16_t _x_offset;
+    int16_t _y_offset;
+    int8_t _dc_pin;
+    spi_transaction_t _chunks[MAX_CHUNKS];
+    size_t _queued;
+    DoneCallback _done;
+    void* _done_arg;
+};
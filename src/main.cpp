@@ -24,6 +24,7 @@
 #include "ui/CaptivePortal.h"
 #include "ui/ProvisioningCard.h"
 #include "hardware/DisplayInterface.h"
+#include "hardware/FramebufferBackend.h"
 #include "ui/CardNavigationStack.h"
 #include "ui/InsightCard.h"
 #include "hardware/Input.h"
@@ -42,18 +43,7 @@
 #define SCREEN_HEIGHT 135
 
 // LVGL display buffer size
-#define LVGL_BUFFER_ROWS 135  // Full screen height
-
-// Button configuration
-#define NUM_BUTTONS 3
-const uint8_t BUTTON_PINS[NUM_BUTTONS] = {
-    Input::BUTTON_DOWN,    // BOOT button
-    Input::BUTTON_CENTER,  // Center button
-    Input::BUTTON_UP       // Up button
-};
-
-// Define the global buttons array
-Bounce2::Button buttons[NUM_BUTTONS];
+#define LVGL_BUFFER_ROWS 34   // Render stripe height, a quarter of the screen
 
 // Global objects
 DisplayInterface* displayInterface;
@@ -103,72 +93,63 @@ void insightTaskFunction(void* parameter) {
     }
 }
 
-// LVGL handler task that includes button polling - added here to consolidate UI operations
+// LVGL handler task that also dispatches button input - added here to consolidate UI operations
 void lvglHandlerTask(void* parameter) {
-    TickType_t lastButtonCheck = xTaskGetTickCount();
-    const TickType_t buttonCheckInterval = pdMS_TO_TICKS(50); // Check buttons every 50ms
-    
-    static unsigned long powerOffPressStartTime = 0;
-    // static bool upPressedState = false; // Unused
-    // static bool downPressedState = false; // Unused
+    // Button interrupts and UI dispatches wake this task as soon as they arrive
+    Input::setNotifyTask(xTaskGetCurrentTaskHandle());
+    displayInterface->setLVGLTask(xTaskGetCurrentTaskHandle());
 
     while (1) {
-        // Handle LVGL tasks
-        displayInterface->handleLVGLTasks();
-
-        cardController->processUIQueue();
-        
-        // Poll buttons at regular intervals
-        TickType_t currentTime = xTaskGetTickCount();
-        if ((currentTime - lastButtonCheck) >= buttonCheckInterval) {
-            lastButtonCheck = currentTime;
-            
-            // Update all buttons first
-            for (int i = 0; i < NUM_BUTTONS; i++) {
-                buttons[i].update();
+        // Debounce captured edges and act on the resulting events
+        Input::process();
+        ButtonEvent event;
+        while (Input::nextEvent(event)) {
+            switch (event.type) {
+                case ButtonEventType::PRESS:
+                    // Presses of chord buttons arrive only once no chord formed
+                    cardController->getCardStack()->handleButtonPress(event.button);
+                    break;
+                case ButtonEventType::REPEAT:
+                    // Only UP and DOWN repeat, so holding them keeps navigating
+                    cardController->getCardStack()->handleButtonRepeat(event.button);
+                    break;
+                case ButtonEventType::CHORD:
+                    Serial.println("Simultaneous CENTER and DOWN hold for 2s detected. Entering deep sleep.");
+                    // Optional: Turn off display backlight or other peripherals before sleep
+                    // displayInterface->setBacklight(0); // Example if such a function exists
+                    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+                    esp_deep_sleep_start();
+                    break;
+                default:
+                    break;
             }
+        }
 
-            // Get current state of UP and DOWN buttons
-            // BUTTON_UP is pressed when HIGH (INPUT_PULLDOWN)
-            // BUTTON_DOWN is pressed when LOW (INPUT_PULLUP)
-            bool centerButtonHeld = (buttons[Input::BUTTON_CENTER].read() == HIGH);
-            bool downButtonHeld = (buttons[Input::BUTTON_DOWN].read() == LOW);
+        // Pace redraws for what is on screen: the card's own rate, else
+        // animation rate while anything animates, else on demand
+        if (displayInterface->takeMutex()) {
+            displayInterface->updateRefreshRate(cardController->getCardStack()->activeFrameRate());
+            displayInterface->giveMutex();
+        }
 
-            if (centerButtonHeld && downButtonHeld) {
-                if (powerOffPressStartTime == 0) { // Both pressed, start timer
-                    powerOffPressStartTime = millis();
-                } else {
-                    if (millis() - powerOffPressStartTime >= 2000) { // Held for 2 seconds
-                        Serial.println("Simultaneous CENTER and DOWN hold for 2s detected. Entering deep sleep.");
-                        // Optional: Turn off display backlight or other peripherals before sleep
-                        // displayInterface->setBacklight(0); // Example if such a function exists
-			esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
-                        esp_deep_sleep_start();
-                    }
-                }
-            } else {
-                // If either button is released or not simultaneously pressed, reset the timer
-                powerOffPressStartTime = 0;
+        // Handle LVGL tasks
+        uint32_t lvgl_wait_ms = displayInterface->handleLVGLTasks();
 
-                // Process individual button presses if power-off sequence is not active or completed.
-                // Check .pressed() for single press actions (triggers on state change).
-                // This ensures that navigation still works if the power-off combo isn't fully executed.
-                if (buttons[Input::BUTTON_UP].pressed()) {
-                    // Ensure this doesn't trigger if it was part of the combo that just got released
-                    // However, .pressed() fires on the transition, so if it was held and released, 
-                    // it won't fire again here unless pressed again separately.
-                    cardController->getCardStack()->handleButtonPress(Input::BUTTON_UP);
-                }
-                if (buttons[Input::BUTTON_DOWN].pressed()) {
-                    cardController->getCardStack()->handleButtonPress(Input::BUTTON_DOWN);
-                }
-                if (buttons[Input::BUTTON_CENTER].pressed()) {
-                    cardController->getCardStack()->handleButtonPress(Input::BUTTON_CENTER);
-                }
-            }
-        }
+        cardController->processUIQueue();
         
-        vTaskDelay(pdMS_TO_TICKS(5));
+        // Sleep until the next LVGL timer, a button edge, a debounce/hold
+        // deadline or a UI dispatch, whichever comes first
+        TickType_t wait = (lvgl_wait_ms == LV_NO_TIMER_READY) ? portMAX_DELAY : pdMS_TO_TICKS(lvgl_wait_ms);
+        TickType_t input_wait = Input::ticksUntilNextDeadline();
+        if (input_wait < wait) {
+            wait = input_wait;
+        }
+        if (CardController::getUIQueueDepth() > 0) {
+            wait = 1;  // Work deferred by the frame budget; still yield to lower priorities
+        } else if (cardController->getCardStack()->activeCardNeedsFrames() && wait > pdMS_TO_TICKS(5)) {
+            wait = pdMS_TO_TICKS(5);  // Games step once per loop
+        }
+        displayInterface->waitForWork(wait > 0 ? wait : 1);
     }
 }
 
@@ -256,24 +237,25 @@ void setup() {
     posthogClient = new PostHogClient(*configManager, *eventQueue);
     
     // Initialize display manager
+#if DISPLAY_BACKEND_FRAMEBUFFER
+    displayInterface = new DisplayInterface(
+        new FramebufferBackend(SCREEN_WIDTH, SCREEN_HEIGHT),
+        SCREEN_WIDTH, SCREEN_HEIGHT, LVGL_BUFFER_ROWS
+    );
+#else
     displayInterface = new DisplayInterface(
         SCREEN_WIDTH, SCREEN_HEIGHT, LVGL_BUFFER_ROWS, 
         TFT_CS, TFT_DC, TFT_RST, TFT_BACKLITE
     );
+#endif
     displayInterface->begin();
     
     // Initialize WiFi manager with event queue
     wifiInterface = new WiFiInterface(*configManager, *eventQueue);
     wifiInterface->begin();
     
-    // Initialize buttons
+    // Initialize buttons (interrupts double as light sleep wakeup sources)
     Input::configureButtons();
-    
-    // Configure GPIO wakeup for buttons to wake from light sleep
-    gpio_wakeup_enable((gpio_num_t)Input::BUTTON_UP, GPIO_INTR_HIGH_LEVEL);
-    gpio_wakeup_enable((gpio_num_t)Input::BUTTON_DOWN, GPIO_INTR_LOW_LEVEL);  
-    gpio_wakeup_enable((gpio_num_t)Input::BUTTON_CENTER, GPIO_INTR_HIGH_LEVEL);
-    esp_sleep_enable_gpio_wakeup();
     Serial.println("GPIO wakeup configured for buttons");
     
     // Create and initialize card controller
@@ -330,18 +312,7 @@ void setup() {
         0
     );
     
-    // Create LVGL tick task
-    xTaskCreatePinnedToCore(
-        DisplayInterface::tickTask,
-        "lv_tick_task",
-        2048,
-        NULL,
-        1,
-        NULL,
-        1
-    );
-    
-    // Create LVGL handler task (now includes button polling)
+    // Create LVGL handler task (now includes button dispatch)
     xTaskCreatePinnedToCore(
         lvglHandlerTask,
         "lvglTask",
@@ -1,5 +1,6 @@
 #include "PostHogClient.h"
 #include "../ConfigManager.h"
+#include "PerfSampler.h"
 
 
 
@@ -7,7 +8,8 @@ PostHogClient::PostHogClient(ConfigManager& config, EventQueue& eventQueue)
     : _config(config)
     , _eventQueue(eventQueue)
     , has_active_request(false)
-    , last_refresh_check(0) {
+    , last_refresh_check(0)
+    , _fetch_latency_gauge(PerfSampler::registerGauge("Fetch", "ms")) {
     // Configure secure client for HTTPS
     _secureClient.setInsecure(); // TODO: get proper cert baked into the firmware to verify these connections
     _http.setReuse(true);
@@ -158,6 +160,7 @@ bool PostHogClient::fetchInsight(const String& insight_id, String& response, boo
     }
 
     unsigned long start_time = millis();
+    unsigned long fetch_start = start_time;
     has_active_request = true;
     
     bool success = false;
@@ -192,6 +195,9 @@ bool PostHogClient::fetchInsight(const String& insight_id, String& response, boo
         }
         
         _http.end();
+        if (success) {
+            PerfSampler::setGauge(_fetch_latency_gauge, millis() - fetch_start);
+        }
         has_active_request = false;
         return success;
     }
@@ -277,6 +283,9 @@ bool PostHogClient::fetchInsight(const String& insight_id, String& response, boo
         _http.end();
     }
     
+    if (success) {
+        PerfSampler::setGauge(_fetch_latency_gauge, millis() - fetch_start);
+    }
     has_active_request = false;
     return success;
 }
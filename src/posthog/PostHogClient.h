@@ -89,6 +89,7 @@ private:
     WiFiClientSecure _secureClient;        ///< Secure WiFi client for HTTPS
     HTTPClient _http;                      ///< HTTP client instance
     unsigned long last_refresh_check;       ///< Last refresh timestamp
+    int _fetch_latency_gauge;               ///< PerfSampler gauge for the last successful fetch
     
     // Constants
     static const char* BASE_URL;                        ///< PostHog API base URL
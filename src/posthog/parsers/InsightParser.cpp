@@ -1,5 +1,7 @@
 #include "InsightParser.h"
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 #include <algorithm> // Add for std::min
 
 #ifdef ARDUINO
@@ -194,6 +196,11 @@ bool InsightParser::private_hasLineGraphStructure() const {
     JsonObjectConst firstResult = results[0];
     if (firstResult.isNull()) return false;
     
+    // Trend series objects: one per event or breakdown value, points in "data"
+    if (private_hasSeriesObjects()) {
+        return private_seriesData(0).size() > 1; // Needs at least 2 points for a line graph
+    }
+
     // Check for line graph structure:
     // - results array exists
     // - first result has result array with multiple points
@@ -218,6 +225,25 @@ bool InsightParser::private_hasLineGraphStructure() const {
     return firstPoint[1].is<double>();
 }
 
+bool InsightParser::private_hasSeriesObjects() const {
+    JsonArrayConst result = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    if (result.isNull() || result.size() == 0) return false;
+    return result[0][JSON_KEY_DATA].is<JsonArrayConst>();
+}
+
+// Points of one series: [date, value] pairs, or bare values for series objects
+JsonArrayConst InsightParser::private_seriesData(size_t series) const {
+    JsonArrayConst result = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    if (private_hasSeriesObjects()) {
+        return result[series][JSON_KEY_DATA];
+    }
+    return series == 0 ? result : JsonArrayConst();
+}
+
+static double seriesPointValue(JsonVariantConst point) {
+    return point.is<JsonArrayConst>() ? point[1].as<double>() : point.as<double>();
+}
+
 // Renamed and made private. All accessors must now use m_insightDataRoot
 bool InsightParser::private_hasAreaChartStructure() const {
     if (!valid) return false;
@@ -239,13 +265,14 @@ bool InsightParser::private_hasAreaChartStructure() const {
         return private_hasLineGraphStructure(); 
     }
 
-    // Secondary check: presence of "compare" flag AND line graph structure.
+    // Secondary check: "compare" set to true AND line graph structure.
     // Note: The `compare` flag can also be in `filters`. Check both for robustness.
-    bool hasCompareFlag = !firstResult[JSON_KEY_COMPARE].isNull(); // Directly in insight object
+    // The value matters, not the key: insights commonly send "compare": false.
+    bool hasCompareFlag = firstResult[JSON_KEY_COMPARE].as<bool>(); // Directly in insight object
     if (!hasCompareFlag) {
         JsonObjectConst filters = firstResult[JSON_KEY_FILTERS];
         if (!filters.isNull()) {
-            hasCompareFlag = filters.containsKey(JSON_KEY_COMPARE); // Check if key exists
+            hasCompareFlag = filters[JSON_KEY_COMPARE].as<bool>();
         }
     }
 
@@ -346,26 +373,86 @@ bool InsightParser::private_hasFunnelNestedStructure() const {
     return false; // For flat structure, result[0] is typically an object directly.
 }
 
+size_t InsightParser::getSeriesCount() const {
+    if (!valid || !private_hasLineGraphStructure()) return 0;
+    if (!private_hasSeriesObjects()) return 1;
+    
+    JsonArrayConst result = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    return result.size();
+}
+
+bool InsightParser::getSeriesLabel(size_t series, char* buffer, size_t bufferSize) const {
+    if (!buffer || bufferSize == 0) return false;
+    buffer[0] = '\0';
+    if (!valid || !private_hasLineGraphStructure() || !private_hasSeriesObjects()) return false;
+    
+    JsonObjectConst seriesObject = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT][series];
+    const char* label = seriesObject[JSON_KEY_LABEL];
+    if (!label) return false;
+    
+    strncpy(buffer, label, bufferSize - 1);
+    buffer[bufferSize - 1] = '\0';
+    return true;
+}
+
+bool InsightParser::getCompareSeries(size_t* current, size_t* previous) const {
+    if (!current || !previous) return false;
+    *current = 0;
+    *previous = 0;
+    size_t seriesCount = getSeriesCount();
+    if (seriesCount < 2) return false;
+    
+    // Series objects arrive in order; the first labelled "previous" is the comparison
+    JsonArrayConst result = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    size_t index = 0;
+    for (JsonObjectConst series : result) {
+        const char* compareLabel = series[JSON_KEY_COMPARE_LABEL];
+        if (compareLabel && strcmp(compareLabel, JSON_VAL_COMPARE_PREVIOUS) == 0) {
+            *previous = index;
+            *current = index == 0 ? 1 : 0;
+            return true;
+        }
+        index++;
+    }
+    
+    // Several series without a previous period are breakdowns, not a comparison
+    return false;
+}
+
 size_t InsightParser::getSeriesPointCount() const {
     if (!valid || !private_hasLineGraphStructure()) return 0;
     
-    // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    return timeseriesData.size();
+    // All series share the x-axis of the first
+    return private_seriesData(0).size();
 }
 
 bool InsightParser::getSeriesYValues(double* yValues) const {
     if (!valid || !private_hasLineGraphStructure() || !yValues) return false;
     
-    // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    size_t pointCount = timeseriesData.size();
+    size_t i = 0;
+    for (JsonVariantConst point : private_seriesData(0)) {
+        yValues[i++] = seriesPointValue(point);
+    }
     
-    // Extract y-values directly - format is consistent with [date_string, numeric_value]
-    for (size_t i = 0; i < pointCount; i++) {
-        yValues[i] = timeseriesData[i][1].as<double>();
+    return true;
+}
+
+bool InsightParser::getSeriesYValues(size_t series, int32_t* yValues, size_t count, double offset, double scale) const {
+    if (!valid || !private_hasLineGraphStructure() || !yValues) return false;
+    
+    JsonArrayConst timeseriesData = private_seriesData(series);
+    if (timeseriesData.isNull()) return false;
+    
+    // Iterate rather than index: indexing a JsonArray walks it from the start.
+    // Series share the x-axis of the first, so a longer one is cut at count.
+    size_t i = 0;
+    for (JsonVariantConst point : timeseriesData) {
+        if (i == count) break;
+        yValues[i++] = (int32_t)lround((seriesPointValue(point) - offset) * scale);
+    }
+    // A shorter series leaves the rest of its run on the baseline
+    for (; i < count; i++) {
+        yValues[i] = (int32_t)lround(-offset * scale);
     }
     
     return true;
@@ -376,11 +463,16 @@ bool InsightParser::getSeriesXLabel(size_t index, char* buffer, size_t bufferSiz
     
     // Use m_insightDataRoot
     JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    
-    if (index >= timeseriesData.size()) return false;
-    
-    const char* dateStr = timeseriesData[index][0];
+    const char* dateStr = nullptr;
+    if (private_hasSeriesObjects()) {
+        JsonArrayConst days = results[0][JSON_KEY_RESULT][0][JSON_KEY_DAYS];
+        if (index >= days.size()) return false;
+        dateStr = days[index];
+    } else {
+        JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
+        if (index >= timeseriesData.size()) return false;
+        dateStr = timeseriesData[index][0];
+    }
     if (!dateStr) return false;
     
     // Copy just the year and month (YYYY-MM) to keep labels compact
@@ -394,31 +486,43 @@ bool InsightParser::getSeriesXLabel(size_t index, char* buffer, size_t bufferSiz
     return true;
 }
 
-void InsightParser::getSeriesRange(double* minValue, double* maxValue) const {
-    if (!valid || !private_hasLineGraphStructure() || !minValue || !maxValue) {
+void InsightParser::getSeriesRange(double* minValue, double* maxValue, size_t seriesLimit) const {
+    if (!minValue || !maxValue) {
         if (minValue) *minValue = 0.0;
         if (maxValue) *maxValue = 0.0;
         return;
     }
     
-    // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
+    bool found = false;
+    size_t seriesCount = std::min(getSeriesCount(), seriesLimit);
+    for (size_t series = 0; series < seriesCount; series++) {
+        double seriesMin, seriesMax;
+        if (!getSeriesValueRange(series, &seriesMin, &seriesMax)) continue;
+        if (!found || seriesMin < *minValue) *minValue = seriesMin;
+        if (!found || seriesMax > *maxValue) *maxValue = seriesMax;
+        found = true;
+    }
     
-    if (timeseriesData.size() == 0) {
+    if (!found) {
         *minValue = 0.0;
         *maxValue = 0.0;
-        return;
     }
+}
 
-    *minValue = timeseriesData[0][1].as<double>();
-    *maxValue = *minValue;
-    
-    for (size_t i = 1; i < timeseriesData.size(); i++) {
-        double value = timeseriesData[i][1].as<double>();
-        if (value < *minValue) *minValue = value;
-        if (value > *maxValue) *maxValue = value;
+bool InsightParser::getSeriesValueRange(size_t series, double* minValue, double* maxValue) const {
+    if (!minValue || !maxValue) return false;
+    *minValue = 0.0;
+    *maxValue = 0.0;
+    if (series >= getSeriesCount()) return false;
+    
+    bool found = false;
+    for (JsonVariantConst point : private_seriesData(series)) {
+        double value = seriesPointValue(point);
+        if (!found || value < *minValue) *minValue = value;
+        if (!found || value > *maxValue) *maxValue = value;
+        found = true;
     }
+    return found;
 }
 
 size_t InsightParser::getFunnelBreakdownCount() const {
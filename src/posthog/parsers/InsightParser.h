@@ -5,6 +5,35 @@
 // e.g., in platformio.ini: build_flags = -DARDUINOJSON_USE_PSRAM
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 50
 #include <ArduinoJson.h>
+#include <vector>
+
+// Most line graph series (trends or breakdown values) kept per insight; bounds display memory
+#ifndef INSIGHT_MAX_LINE_SERIES
+#define INSIGHT_MAX_LINE_SERIES 5
+#endif
+
+/**
+ * @struct SeriesSet
+ * @brief Chart-ready line graph series packed as structure-of-arrays
+ *
+ * All series share one x-axis, so their points sit back to back in a single
+ * y array: series s occupies y[s * pointCount, (s + 1) * pointCount).
+ */
+struct SeriesSet {
+    static constexpr size_t MAX_SERIES = INSIGHT_MAX_LINE_SERIES;
+    static constexpr size_t LABEL_LENGTH = 24;
+
+    uint8_t seriesCount = 0;
+    uint16_t pointCount = 0;
+    std::vector<int32_t> y;             ///< seriesCount runs of pointCount values
+    char labels[MAX_SERIES][LABEL_LENGTH] = {};
+    uint32_t colors[MAX_SERIES] = {};   ///< 0xRRGGBB per series
+    std::vector<int16_t> compareDelta;  ///< Previous period minus series 0, per point; empty without comparison
+
+    int32_t* series(size_t index) { return y.data() + index * pointCount; }
+    const int32_t* series(size_t index) const { return y.data() + index * pointCount; }
+    bool empty() const { return seriesCount == 0 || pointCount == 0; }
+};
 
 // REMOVED: #define MAX_BREAKDOWNS 5 // This constant is likely defined elsewhere (e.g., InsightCard.h) using static constexpr
 
@@ -91,6 +120,37 @@ public:
      */
     bool getNumericFormattingSuffix(char* buffer, size_t bufferSize) const;
     
+    /**
+     * @brief Get number of series in a line graph
+     * @return Number of series or 0 if not a line graph
+     * 
+     * Results as [date, value] pairs hold one series. Results as trend
+     * series objects hold one per event or breakdown value, all over the
+     * same days.
+     */
+    size_t getSeriesCount() const;
+
+    /**
+     * @brief Get the display label of a line graph series
+     * @param series Series index
+     * @param buffer Buffer to store label
+     * @param bufferSize Size of buffer
+     * @return true if the series has a label
+     */
+    bool getSeriesLabel(size_t series, char* buffer, size_t bufferSize) const;
+
+    /**
+     * @brief Find the current and previous period series of a comparison
+     * @param current Receives the current period series index
+     * @param previous Receives the previous period series index
+     * @return true if a series has compare_label "previous"; both indices are
+     *         then set, otherwise both are 0
+     * 
+     * The current period is series 0, or series 1 if the previous period
+     * comes first.
+     */
+    bool getCompareSeries(size_t* current, size_t* previous) const;
+
     /**
      * @brief Get number of data points in line graph series
      * @return Number of points or 0 if not a line graph
@@ -110,6 +170,22 @@ public:
      */
     bool getSeriesYValues(double* yValues) const;
 
+    /**
+     * @brief Get Y-values for line graph series mapped to integer chart units
+     * @param series Series index, below getSeriesCount()
+     * @param yValues Array to fill
+     * @param count Size of yValues, usually getSeriesPointCount()
+     * @param offset Value that maps to 0
+     * @param scale Chart units per data unit
+     * @return true if values were retrieved successfully
+     * 
+     * Writes round((value - offset) * scale) for each point in one pass over
+     * the series, so renderers can fill an LVGL chart array without an
+     * intermediate double copy. A series longer than count is cut short; a
+     * shorter one is padded with the value that maps zero.
+     */
+    bool getSeriesYValues(size_t series, int32_t* yValues, size_t count, double offset, double scale) const;
+
     /**
      * @brief Get X-axis label for a data point
      * @param index Point index
@@ -126,12 +202,22 @@ public:
      * @brief Get Y-value range for scaling
      * @param minValue Pointer to store minimum value
      * @param maxValue Pointer to store maximum value
+     * @param seriesLimit Number of leading series to include
      * 
      * Calculates the min/max Y values across all data points.
      * Useful for scaling visualizations appropriately.
      */
-    void getSeriesRange(double* minValue, double* maxValue) const;
-    
+    void getSeriesRange(double* minValue, double* maxValue, size_t seriesLimit = 1) const;
+
+    /**
+     * @brief Get Y-value range of one series
+     * @param series Series index, below getSeriesCount()
+     * @param minValue Pointer to store minimum value
+     * @param maxValue Pointer to store maximum value
+     * @return true if the series has points; otherwise both values are 0
+     */
+    bool getSeriesValueRange(size_t series, double* minValue, double* maxValue) const;
+
     /**
      * @brief Check if parsing was successful
      * @return true if JSON was parsed successfully
@@ -305,6 +391,8 @@ private:
     // Private helper methods for insight type detection
     bool private_hasNumericCardStructure() const;
     bool private_hasLineGraphStructure() const;
+    bool private_hasSeriesObjects() const;
+    JsonArrayConst private_seriesData(size_t series) const;
     bool private_hasAreaChartStructure() const;
     bool private_hasFunnelStructure() const;
     bool private_hasFunnelResultData() const;
@@ -346,7 +434,12 @@ static const char* JSON_KEY_FUNNEL_WINDOW_INTERVAL_UNIT = "funnel_window_interva
 static const char* JSON_KEY_EVENTS = "events";
 static const char* JSON_KEY_ACTIONS = "actions";
 static const char* JSON_KEY_ID = "id";
-static const char* JSON_KEY_ACTION_ID = "action_id"; 
+static const char* JSON_KEY_ACTION_ID = "action_id";
+static const char* JSON_KEY_DATA = "data";
+static const char* JSON_KEY_DAYS = "days";
+static const char* JSON_KEY_LABEL = "label";
+static const char* JSON_KEY_COMPARE_LABEL = "compare_label";
+static const char* JSON_VAL_COMPARE_PREVIOUS = "previous"; 
 
 // Define common JSON values as constants
 static const char* JSON_VAL_INSIGHT_FUNNELS = "FUNNELS";
@@ -108,6 +108,19 @@ void CaptivePortal::begin() {
     _server.on("/start-update", HTTP_POST, std::bind(&CaptivePortal::handleStartUpdate, this, std::placeholders::_1));
     _server.on("/update-status", HTTP_GET, std::bind(&CaptivePortal::handleUpdateStatus, this, std::placeholders::_1));
 
+#if EVENT_QUEUE_TRACING
+    // Event bus diagnostics
+    _server.on("/api/debug/events", HTTP_GET, std::bind(&CaptivePortal::handleGetEventTrace, this, std::placeholders::_1));
+#endif
+#if RENDER_PROFILER
+    // Per-card render cost
+    _server.on("/api/debug/render", HTTP_GET, std::bind(&CaptivePortal::handleGetRenderProfile, this, std::placeholders::_1));
+#endif
+#if DISPLAY_BACKEND_FRAMEBUFFER
+    // Headless framebuffer capture for golden images
+    _server.on("/api/debug/screenshot", HTTP_GET, std::bind(&CaptivePortal::handleGetScreenshot, this, std::placeholders::_1));
+#endif
+
     // Captive portal detection URLs
     _server.on("/generate_204", HTTP_GET, std::bind(&CaptivePortal::handleCaptivePortal, this, std::placeholders::_1)); // Android
     _server.on("/fwlink", HTTP_GET, std::bind(&CaptivePortal::handleCaptivePortal, this, std::placeholders::_1));         // Microsoft
@@ -694,6 +707,78 @@ void CaptivePortal::handleGetCardDefinitions(AsyncWebServerRequest *request) {
     request->send(response);
 }
 
+#if EVENT_QUEUE_TRACING
+void CaptivePortal::handleGetEventTrace(AsyncWebServerRequest *request) {
+    DynamicJsonDocument doc(8192);
+    JsonObject root = doc.to<JsonObject>();
+    _eventQueue.writeTraceJson(root);
+
+    // The LVGL side of the bus: UI update queue timing and callback pool use
+    CardController::UIQueueStats queueStats = CardController::getUIQueueStats();
+    JsonObject uiQueue = root.createNestedObject("ui_queue");
+    uiQueue["depth"] = CardController::getUIQueueDepth();
+    uiQueue["callbacks"] = queueStats.callbacks;
+    uiQueue["total_callback_us"] = (double)queueStats.totalCallbackUs;
+    uiQueue["max_callback_us"] = queueStats.maxCallbackUs;
+    uiQueue["worst_frame_us"] = queueStats.worstFrameUs;
+    uiQueue["deferred_frames"] = queueStats.deferredFrames;
+
+    UICallbackPool::Stats poolStats = UICallbackPool::getStats();
+    JsonObject pool = root.createNestedObject("ui_callbacks");
+    pool["capacity"] = UICallbackPool::CAPACITY;
+    pool["acquired"] = poolStats.acquired;
+    pool["in_use"] = poolStats.inUse;
+    pool["high_water"] = poolStats.highWater;
+    pool["heap_fallbacks"] = poolStats.heapFallbacks;
+    pool["pool_exhausted"] = poolStats.poolExhausted;
+
+    String responseJson;
+    serializeJson(doc, responseJson);
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", responseJson);
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    request->send(response);
+}
+#endif
+
+#if RENDER_PROFILER
+void CaptivePortal::handleGetRenderProfile(AsyncWebServerRequest *request) {
+    DynamicJsonDocument doc(12288);
+    RenderProfiler::writeJson(doc.to<JsonObject>());
+
+    String responseJson;
+    serializeJson(doc, responseJson);
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", responseJson);
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    request->send(response);
+}
+#endif
+
+#if DISPLAY_BACKEND_FRAMEBUFFER
+void CaptivePortal::handleGetScreenshot(AsyncWebServerRequest *request) {
+    DisplayInterface* display = _cardController.getDisplayInterface();
+    FramebufferBackend* framebuffer = display ? static_cast<FramebufferBackend*>(display->getBackend()) : nullptr;
+    if (!framebuffer || !display->takeMutex(pdMS_TO_TICKS(500))) {
+        request->send(503, "text/plain", "Framebuffer unavailable");
+        return;
+    }
+
+    // Encode under the LVGL mutex so no flush lands mid-image
+    AsyncResponseStream *response = request->beginResponseStream("image/png");
+    bool ok = framebuffer->writePng([](void* ctx, const uint8_t* data, size_t length) -> bool {
+        return static_cast<AsyncResponseStream*>(ctx)->write(data, length) == length;
+    }, response);
+    display->giveMutex();
+
+    if (!ok) {
+        delete response;
+        request->send(500, "text/plain", "PNG encoding failed");
+        return;
+    }
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    request->send(response);
+}
+#endif
+
 void CaptivePortal::handleGetConfiguredCards(AsyncWebServerRequest *request) {
     DynamicJsonDocument doc(2048);
     JsonArray cardsArray = doc.to<JsonArray>();
@@ -18,6 +18,8 @@
 #include "html_portal.h"  // Include generated HTML header
 #include "EventQueue.h"   // Include the event queue
 #include "config/CardConfig.h"  // Include card configuration structures
+#include "ui/RenderProfiler.h"
+#include "hardware/FramebufferBackend.h"
 // #include "OtaManager.h" // Will be included in .cpp, forward declare here
 
 class OtaManager; // Forward declaration
@@ -207,6 +209,29 @@ private:
     void handleRequestCheckOtaUpdate(AsyncWebServerRequest *request);
     void handleRequestStartOtaUpdate(AsyncWebServerRequest *request);
 
+#if EVENT_QUEUE_TRACING
+    /**
+     * @brief Return event bus trace (queue depth, drops, callback timings) as JSON
+     *
+     * Also reports UI update queue timing and UICallbackPool usage.
+     */
+    void handleGetEventTrace(AsyncWebServerRequest *request);
+#endif
+
+#if RENDER_PROFILER
+    /**
+     * @brief Return per-card frame costs and the recent frame log as JSON
+     */
+    void handleGetRenderProfile(AsyncWebServerRequest *request);
+#endif
+
+#if DISPLAY_BACKEND_FRAMEBUFFER
+    /**
+     * @brief Return the headless framebuffer as a PNG
+     */
+    void handleGetScreenshot(AsyncWebServerRequest *request);
+#endif
+
     /**
      * @brief Common handler to queue an action and store parameters.
      * @param action The PortalAction to queue.
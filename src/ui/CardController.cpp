@@ -1,9 +1,12 @@
 #include "ui/CardController.h"
 #include "ui/PaddleCard.h"
 #include "ui/PomodoroCard.h"
+#include "ui/PerfHudCard.h"
+#include "ui/UIBenchmark.h"
 #include <algorithm>
 
-QueueHandle_t CardController::uiQueue = nullptr;
+UIUpdateQueue *CardController::uiQueue = nullptr;
+CardController::UIQueueStats CardController::uiQueueStats = {};
 
 // Define the global UI dispatch function
 std::function<void(std::function<void()>, bool)> globalUIDispatch;
@@ -104,6 +107,23 @@ void CardController::initialize(DisplayInterface *display)
     // Connect WiFi manager to UI
     wifiInterface.setUI(provisioningCard);
 
+#if DISPLAY_BUFFER_BENCHMARK
+    // Queued behind the initial reconcile so every configured card exists
+    if (!dispatchToLVGLTask([this]()
+                            { runRenderBenchmark(); }))
+    {
+        Serial.println("[CardController] Render benchmark could not be queued");
+    }
+#endif
+#if UI_BENCHMARK
+    // Also queued behind the initial reconcile so the real card tree is in place
+    if (!dispatchToLVGLTask([]()
+                            { UIBenchmark::run(); }))
+    {
+        Serial.println("[CardController] UI benchmark could not be queued");
+    }
+#endif
+
     // Subscribe to card configuration changes
     eventQueue.subscribe([this](const Event &event)
                          {
@@ -124,6 +144,64 @@ void CardController::initialize(DisplayInterface *display)
         } });
 }
 
+#if DISPLAY_BUFFER_BENCHMARK
+void CardController::runRenderBenchmark()
+{
+    static const RenderBufferStrategy strategies[] = {
+        RenderBufferStrategy::INTERNAL_STRIPES,
+        RenderBufferStrategy::PSRAM_FULL_FRAME,
+        RenderBufferStrategy::HYBRID};
+    const uint16_t FRAMES_PER_CARD = 20;
+
+    if (!displayInterface || !cardStack)
+    {
+        return;
+    }
+
+    uint32_t card_count = cardStack->getCardCount();
+    uint8_t original_card = cardStack->getCurrentIndex();
+    RenderBufferStrategy original_strategy = displayInterface->getBufferStrategy();
+    Serial.printf("[Benchmark] %lu cards x %u frames per buffer strategy\n",
+                  (unsigned long)card_count, FRAMES_PER_CARD);
+
+    for (RenderBufferStrategy strategy : strategies)
+    {
+        if (!displayInterface->setBufferStrategy(strategy))
+        {
+            Serial.printf("[Benchmark] %s: skipped, buffers unavailable\n",
+                          DisplayInterface::strategyName(strategy));
+            continue;
+        }
+
+        uint64_t total_us = 0;
+        uint32_t worst_us = 0;
+        uint32_t frames = 0;
+        for (uint32_t card = 0; card < card_count; card++)
+        {
+            cardStack->jumpToCard(card);
+            displayInterface->renderFrameNow(); // Settle layout and caches, not counted
+            for (uint16_t i = 0; i < FRAMES_PER_CARD; i++)
+            {
+                uint32_t frame_us = displayInterface->renderFrameNow();
+                total_us += frame_us;
+                worst_us = std::max(worst_us, frame_us);
+                frames++;
+            }
+        }
+
+        if (frames > 0)
+        {
+            Serial.printf("[Benchmark] %-16s %.2f ms/frame, worst %.2f ms\n",
+                          DisplayInterface::strategyName(strategy),
+                          total_us / 1000.0 / frames, worst_us / 1000.0);
+        }
+    }
+
+    displayInterface->setBufferStrategy(original_strategy);
+    cardStack->jumpToCard(original_card);
+}
+#endif
+
 void CardController::setDisplayInterface(DisplayInterface *display)
 {
     displayInterface = display;
@@ -424,7 +502,7 @@ void CardController::initializeCardTypes()
         {
             // Add to unified tracking system
             CardInstance instance{newCard, newCard->getCard()};
-            dynamicCards[CardType::PADDLE].push_back(instance);
+            dynamicCards[CardType::POMODORO].push_back(instance);
 
             // Register as input handler
             cardStack->registerInputHandler(newCard->getCard(), newCard);
@@ -435,6 +513,34 @@ void CardController::initializeCardTypes()
         return nullptr;
     };
     registerCardType(pomodoroDef);
+
+    // Register PERF_HUD card type
+    CardDefinition perfHudDef;
+    perfHudDef.type = CardType::PERF_HUD;
+    perfHudDef.name = "Performance HUD";
+    perfHudDef.allowMultiple = false;
+    perfHudDef.needsConfigInput = false;
+    perfHudDef.configInputLabel = "";
+    perfHudDef.uiDescription = "Frame rate, memory, queues and CPU load";
+    perfHudDef.factory = [this](const String &configValue) -> lv_obj_t *
+    {
+        PerfHudCard *newCard = new PerfHudCard(screen, eventQueue);
+
+        if (newCard && newCard->getCard())
+        {
+            // Add to unified tracking system
+            CardInstance instance{newCard, newCard->getCard()};
+            dynamicCards[CardType::PERF_HUD].push_back(instance);
+
+            // Register as input handler
+            cardStack->registerInputHandler(newCard->getCard(), newCard);
+            return newCard->getCard();
+        }
+
+        delete newCard;
+        return nullptr;
+    };
+    registerCardType(perfHudDef);
 }
 
 void CardController::handleCardConfigChanged()
@@ -454,64 +560,107 @@ void CardController::reconcileCards(const std::vector<CardConfig> &newConfigs)
         return;
     }
 
-    // Track the number of cards before reconciliation
-    size_t oldCardCount = 0;
-    for (const auto &[cardType, cards] : dynamicCards)
-    {
-        oldCardCount += cards.size();
-    }
-
     reconcileInProgress = true;
 
     // Dispatch the entire reconciliation to the LVGL task to ensure thread safety
-    dispatchToLVGLTask([this, newConfigs, oldCardCount]()
+    bool queued = dispatchToLVGLTask([this, newConfigs]()
                        {
         if (!displayInterface || !displayInterface->takeMutex(portMAX_DELAY)) {
             reconcileInProgress = false;  // Clear flag on failure
             return;
         }
         
-        // Save current card index to restore after reconciliation
-        uint8_t savedCardIndex = cardStack ? cardStack->getCurrentIndex() : 0;
+        uint32_t reconcileStart = micros();
         
-        // Simple approach: Clear everything and rebuild from scratch
-        // This avoids complex diffing logic that can cause sync issues
+        // Remember which card is on screen so it stays selected if it survives
+        lv_obj_t* shownCard = nullptr;
+        uint8_t savedCardIndex = 0;
+        if (cardStack) {
+            savedCardIndex = cardStack->getCurrentIndex();
+            for (const auto& [cardType, cards] : dynamicCards) {
+                for (const auto& cardInstance : cards) {
+                    if (cardInstance.lvglCard && lv_obj_get_index(cardInstance.lvglCard) == savedCardIndex) {
+                        shownCard = cardInstance.lvglCard;
+                    }
+                }
+            }
+        }
+        
+        std::vector<CardConfig> sortedConfigs = newConfigs;
+        std::sort(sortedConfigs.begin(), sortedConfigs.end(), 
+                  [](const CardConfig& a, const CardConfig& b) {
+                      return a.order < b.order;
+                  });
+        
+        // Match each configured card against a surviving instance keyed on (type, config)
+        std::vector<std::pair<CardType, String>> liveKeys;
+        std::vector<std::pair<CardType, size_t>> liveRefs;
+        for (const auto& [cardType, cards] : dynamicCards) {
+            for (size_t j = 0; j < cards.size(); j++) {
+                liveKeys.emplace_back(cardType, cards[j].config);
+                liveRefs.emplace_back(cardType, j);
+            }
+        }
+        std::vector<std::pair<CardType, String>> wantedKeys;
+        for (const CardConfig& config : sortedConfigs) {
+            wantedKeys.emplace_back(config.type, config.config);
+        }
+        CardReconcilePlan plan = planCardReconcile(liveKeys, wantedKeys);
+        
+        std::vector<lv_obj_t*> orderedCards(sortedConfigs.size(), nullptr);
+        for (size_t i = 0; i < sortedConfigs.size(); i++) {
+            if (plan.reuse[i] != CardReconcilePlan::CREATE) {
+                const auto& ref = liveRefs[plan.reuse[i]];
+                orderedCards[i] = dynamicCards[ref.first][ref.second].lvglCard;
+            }
+        }
+        std::unordered_map<CardType, std::vector<bool>> kept;
+        for (const auto& [cardType, cards] : dynamicCards) {
+            kept[cardType].assign(cards.size(), false);
+        }
+        for (size_t j = 0; j < liveRefs.size(); j++) {
+            kept[liveRefs[j].first][liveRefs[j].second] = plan.kept[j];
+        }
         
-        // Remove all existing dynamic cards using unified system
+        // Remove only the cards that are no longer configured
+        size_t cardsRemoved = 0;
         for (auto& [cardType, cards] : dynamicCards) {
-            for (auto& cardInstance : cards) {
+            std::vector<bool>& keptFlags = kept[cardType];
+            std::vector<CardInstance> survivors;
+            for (size_t j = 0; j < cards.size(); j++) {
+                CardInstance& cardInstance = cards[j];
+                if (keptFlags[j]) {
+                    survivors.push_back(cardInstance);
+                    continue;
+                }
                 if (cardInstance.lvglCard) {
                     // Notify the card that its LVGL object will be managed externally
                     cardInstance.handler->prepareForRemoval();
                     // Remove from navigation stack (this deletes the LVGL object)
                     cardStack->removeCard(cardInstance.lvglCard);
+#if RENDER_PROFILER
+                    RenderProfiler::forgetCard(cardInstance.lvglCard);
+#endif
+                }
+                if (cardInstance.handler == animationCard) {
+                    animationCard = nullptr;
+                }
+                if (cardInstance.lvglCard == shownCard) {
+                    shownCard = nullptr;
                 }
                 delete cardInstance.handler;
+                cardsRemoved++;
             }
+            cards = std::move(survivors);
         }
-        dynamicCards.clear();
-        
-        // Clear legacy pointer
-        animationCard = nullptr;
         
-        // Force LVGL to process all pending operations
-        lv_refr_now(NULL);
-        
-        // Now recreate cards based on new configuration
-        std::vector<CardConfig> sortedConfigs = newConfigs;
-        std::sort(sortedConfigs.begin(), sortedConfigs.end(), 
-                  [](const CardConfig& a, const CardConfig& b) {
-                      return a.order < b.order;
-                  });
-        
-        // Track how many cards we've created
+        // Create only the cards that did not exist before
         size_t cardsCreated = 0;
-        
-        // Check if we have a new card (more configs than before)
-        bool hasNewCard = (sortedConfigs.size() > oldCardCount);
-        size_t newCardPosition = 0;
-        
+        lv_obj_t* lastCreatedCard = nullptr;
         for (size_t i = 0; i < sortedConfigs.size(); i++) {
+            if (orderedCards[i]) {
+                continue;
+            }
             const CardConfig& config = sortedConfigs[i];
             // Find the registered card type
             auto it = std::find_if(registeredCardTypes.begin(), registeredCardTypes.end(),
@@ -525,11 +674,16 @@ void CardController::reconcileCards(const std::vector<CardConfig> &newConfigs)
                 if (cardObj) {
                     cardStack->addCard(cardObj);
                     
-                    // Track position of new card if this is likely the new one
-                    if (hasNewCard && i == sortedConfigs.size() - 1) {
-                        newCardPosition = cardsCreated + 1; // +1 for provisioning card
+                    // Factories register the instance; record its config as the diff key
+                    for (auto& cardInstance : dynamicCards[config.type]) {
+                        if (cardInstance.lvglCard == cardObj) {
+                            cardInstance.config = config.config;
+                            break;
+                        }
                     }
                     
+                    orderedCards[i] = cardObj;
+                    lastCreatedCard = cardObj;
                     cardsCreated++;
                 } else {
                     Serial.printf("Failed to create card of type %s\n", 
@@ -541,36 +695,59 @@ void CardController::reconcileCards(const std::vector<CardConfig> &newConfigs)
             }
         }
         
-        // Force another LVGL refresh to ensure everything is properly laid out
-        lv_refr_now(NULL);
+        // Put every card in configured order; index 0 is always the provisioning card
+        uint32_t position = 1;
+        for (lv_obj_t* cardObj : orderedCards) {
+            if (cardObj && cardStack->moveCard(cardObj, position)) {
+                position++;
+            }
+        }
+        
+        // No forced refresh: goToCard() resolves the stack layout it needs and
+        // every change made here is drawn together in the next normal frame
         
         // Force the card stack to update its pip indicators
         // This ensures the indicators are correct after bulk card operations
         cardStack->forceUpdateIndicators();
         
         // Navigate to appropriate card
-        if (hasNewCard && newCardPosition > 0) {
+        uint32_t cardCount = cardStack->getCardCount();
+        if (cardsCreated > 0 && cardsRemoved == 0 && lastCreatedCard) {
             // Navigate to the newly added card
-            cardStack->goToCard(newCardPosition);
-        } else if (savedCardIndex > 0 && cardsCreated > 0) {
-            // Restore previous position if no new card was added
-            // Adjust for the provisioning card (always at index 0)
-            uint8_t maxIndex = cardsCreated; // provisioning + created cards - 1
+            cardStack->goToCard(lv_obj_get_index(lastCreatedCard));
+        } else if (shownCard) {
+            // Keep showing the same card at its new position
+            cardStack->goToCard(lv_obj_get_index(shownCard));
+        } else if (savedCardIndex > 0 && cardCount > 1) {
+            uint8_t maxIndex = cardCount - 1;
             uint8_t targetIndex = (savedCardIndex <= maxIndex) ? savedCardIndex : maxIndex;
             cardStack->goToCard(targetIndex);
         }
         
+        Serial.printf("[CardController] Reconciled %u cards in %lu us (kept %u, created %u, removed %u)\n",
+                      (unsigned)sortedConfigs.size(), (unsigned long)(micros() - reconcileStart),
+                      (unsigned)(sortedConfigs.size() - cardsCreated), (unsigned)cardsCreated, (unsigned)cardsRemoved);
+        
         // Clear the in-progress flag
         reconcileInProgress = false;
         
         displayInterface->giveMutex(); }, true); // Use to_front=true for immediate processing
+
+    if (!queued)
+    {
+        // The closure will never run, so nothing else would clear the flag
+        Serial.println("[CardController] Reconcile could not be queued, will retry on next config change");
+        reconcileInProgress = false;
+    }
 }
 
 void CardController::initUIQueue()
 {
     if (uiQueue == nullptr)
     {
-        uiQueue = xQueueCreate(20, sizeof(UICallback *));
+        UICallbackPool::begin();
+
+        uiQueue = new UIUpdateQueue();
         if (uiQueue == nullptr)
         {
             Serial.println("[UI-CRITICAL] Failed to create UI task queue!");
@@ -582,63 +759,138 @@ void CardController::initUIQueue()
             {
                 this->dispatchToLVGLTask(std::move(func), to_front);
             };
+            globalUISubmit = &CardController::submitToLVGLTask;
+            globalUICancel = [](const void *owner) -> size_t
+            {
+                return uiQueue ? uiQueue->cancel(owner) : 0;
+            };
         }
     }
 }
 
-void CardController::processUIQueue()
+void CardController::processUIQueue(uint32_t budget_us)
 {
     if (uiQueue == nullptr)
         return;
 
+    uint32_t frame_start = micros();
+    uint32_t frame_elapsed = 0;
     UICallback *callback_ptr = nullptr;
-    while (xQueueReceive(uiQueue, &callback_ptr, 0) == pdTRUE)
+
+    // Always run at least one callback so a single slow closure cannot stall the queue
+    while ((callback_ptr = uiQueue->pop()) != nullptr)
     {
-        if (callback_ptr)
+        uint32_t callback_start = micros();
+        callback_ptr->execute();
+        UICallbackPool::release(callback_ptr);
+        uint32_t callback_us = micros() - callback_start;
+
+        uiQueueStats.callbacks++;
+        uiQueueStats.totalCallbackUs += callback_us;
+        if (callback_us > uiQueueStats.maxCallbackUs)
+        {
+            uiQueueStats.maxCallbackUs = callback_us;
+        }
+        if (callback_us > budget_us)
         {
-            callback_ptr->execute();
-            delete callback_ptr;
+            Serial.printf("[UI-WARN] UI callback took %u us (budget %u us)\n", callback_us, budget_us);
         }
+
+        frame_elapsed = micros() - frame_start;
+        if (frame_elapsed >= budget_us)
+        {
+            break;
+        }
+    }
+
+    if (frame_elapsed >= budget_us && uiQueue->size() > 0)
+    {
+        // Remaining work runs after the next lv_timer_handler() and button poll
+        uiQueueStats.deferredFrames++;
+    }
+    uiQueueStats.lastFrameUs = frame_elapsed;
+    if (frame_elapsed > uiQueueStats.worstFrameUs)
+    {
+        uiQueueStats.worstFrameUs = frame_elapsed;
     }
 
     // Update active card (for games and other interactive cards)
     if (cardStack)
     {
         cardStack->updateActiveCard();
+#if RENDER_PROFILER
+        updateProfiledCard();
+#endif
     }
 }
 
-void CardController::dispatchToLVGLTask(std::function<void()> update_func, bool to_front)
+#if RENDER_PROFILER
+void CardController::updateProfiledCard()
 {
-    if (uiQueue == nullptr)
+    lv_obj_t *current = cardStack->getCurrentCard();
+    if (current == profiledCard)
     {
-        Serial.println("[UI-ERROR] UI Queue not initialized, cannot dispatch UI update.");
         return;
     }
+    profiledCard = current;
 
-    UICallback *callback = new UICallback(std::move(update_func));
-    if (!callback)
+    // Label frames with the card type and its config so instances can be told apart
+    String label = "PROVISIONING";
+    for (const auto &[cardType, cards] : dynamicCards)
     {
-        Serial.println("[UI-CRITICAL] Failed to allocate UICallback for dispatch!");
-        return;
+        for (const CardInstance &instance : cards)
+        {
+            if (instance.lvglCard == current)
+            {
+                label = cardTypeToString(cardType);
+                if (instance.config.length() > 0)
+                {
+                    label += ":" + instance.config;
+                }
+            }
+        }
     }
+    RenderProfiler::setActiveCard(current, label.c_str());
+}
+#endif
 
-    BaseType_t queue_send_result;
-    if (to_front)
+bool CardController::dispatchToLVGLTask(std::function<void()> update_func, bool to_front)
+{
+    // std::function fits the inline slot, so only its own capture may allocate
+    UICallback *callback = UICallbackPool::make([func = std::move(update_func)]()
+                                                {
+        if (func) {
+            func();
+        } });
+    if (!callback)
     {
-        queue_send_result = xQueueSendToFront(uiQueue, &callback, (TickType_t)0);
+        Serial.println("[UI-CRITICAL] Failed to allocate UICallback for dispatch!");
+        return false;
     }
-    else
+
+    return submitToLVGLTask(callback, to_front, UIUpdateKey());
+}
+
+bool CardController::submitToLVGLTask(UICallback *callback, bool to_front, const UIUpdateKey &key)
+{
+    if (uiQueue == nullptr)
     {
-        queue_send_result = xQueueSend(uiQueue, &callback, (TickType_t)0);
+        Serial.println("[UI-ERROR] UI Queue not initialized, cannot dispatch UI update.");
+        UICallbackPool::release(callback);
+        return false;
     }
 
-    if (queue_send_result != pdTRUE)
+    // The queue releases the callback itself if it cannot be queued
+    if (!uiQueue->push(callback, key, to_front))
     {
-        Serial.printf("[UI-WARN] UI queue full/error (send_to_front: %d), update discarded. Core: %d\n",
-                      to_front, xPortGetCoreID());
-        delete callback;
+        Serial.printf("[UI-WARN] UI queue full (send_to_front: %d, keyed: %d), update discarded. Core: %d\n",
+                      to_front, key.isValid(), xPortGetCoreID());
+        return false;
     }
+
+    // The LVGL task may be sleeping until its next timer
+    DisplayInterface::wakeLVGLTask();
+    return true;
 }
 
 void CardController::handleCardTitleUpdated(const Event &event)
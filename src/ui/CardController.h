@@ -9,6 +9,7 @@
 #include "hardware/WifiInterface.h"
 #include "posthog/PostHogClient.h"
 #include "ui/CardNavigationStack.h"
+#include "ui/CardReconcile.h"
 #include "ui/ProvisioningCard.h"
 #include "ui/InsightCard.h"
 #include "ui/FriendCard.h"
@@ -18,7 +19,9 @@
 #include "EventQueue.h"
 #include "config/CardConfig.h"
 #include "UICallback.h"
+#include "UIUpdateQueue.h"
 #include "ui/QuestionCard.h"
+#include "ui/RenderProfiler.h"
 
 /**
  * @class CardController
@@ -30,6 +33,8 @@
  */
 class CardController {
 public:
+    static constexpr uint32_t UI_FRAME_BUDGET_US = 8000;  ///< Default per-frame budget for processUIQueue
+
     /**
      * @brief Constructor for CardController
      * 
@@ -130,18 +135,45 @@ public:
     /**
      * @brief Initialize the UI update queue
      * 
-     * Creates a FreeRTOS queue for handling UI updates across threads.
+     * Creates the coalescing queue for handling UI updates across threads.
      * Must be called once during CardController initialization.
      */
     void initUIQueue();
 
     /**
-     * @brief Process pending UI updates
+     * @brief Timing statistics for UI queue processing
+     */
+    struct UIQueueStats {
+        uint32_t callbacks;        ///< Callbacks executed since boot
+        uint64_t totalCallbackUs;  ///< Sum of callback execution times
+        uint32_t maxCallbackUs;    ///< Slowest single callback
+        uint32_t lastFrameUs;      ///< Time spent in the most recent processUIQueue call
+        uint32_t worstFrameUs;     ///< Slowest processUIQueue call
+        uint32_t deferredFrames;   ///< Calls that ran out of budget with work left over
+    };
+
+    /**
+     * @brief Process pending UI updates within a time budget
      * 
-     * Processes all queued UI updates in the LVGL task context.
+     * Executes queued UI updates in the LVGL task context until the budget is
+     * spent, leaving the rest for the next call so rendering and button polling
+     * keep running under load. At least one callback runs per call.
      * Should be called regularly from the LVGL handler task.
+     * 
+     * @param budget_us Time budget in microseconds for this call
+     */
+    void processUIQueue(uint32_t budget_us = UI_FRAME_BUDGET_US);
+
+    /**
+     * @brief Get UI queue timing statistics
+     * @return Copy of the current statistics
+     */
+    static UIQueueStats getUIQueueStats() { return uiQueueStats; }
+
+    /**
+     * @brief Number of UI updates currently waiting
      */
-    void processUIQueue();
+    static size_t getUIQueueDepth() { return uiQueue ? uiQueue->size() : 0; }
     
     /**
      * @brief Thread-safe method to dispatch UI updates to the LVGL task
@@ -151,8 +183,22 @@ public:
      * 
      * Queues UI operations to be executed on the LVGL thread.
      * Handles queue overflow by discarding updates if queue is full.
+     *
+     * @return false if the update was discarded and will never run
      */
-    void dispatchToLVGLTask(std::function<void()> update_func, bool to_front = false);
+    bool dispatchToLVGLTask(std::function<void()> update_func, bool to_front = false);
+
+    /**
+     * @brief Queue an already-filled callback for the LVGL task
+     *
+     * @param callback Callback from UICallbackPool; ownership passes to the queue
+     * @param to_front If true, tries to add the callback to the front of the queue
+     * @param key Coalescing key; a pending callback with the same key is replaced
+     * @return true if queued, false if the queue was full (callback is released)
+     *
+     * Installed as globalUISubmit so dispatchUICallback() can skip std::function.
+     */
+    static bool submitToLVGLTask(UICallback* callback, bool to_front, const UIUpdateKey& key);
 
 private:
     // Screen reference
@@ -174,6 +220,7 @@ private:
     struct CardInstance {
         InputHandler* handler;  ///< The card as an InputHandler
         lv_obj_t* lvglCard;    ///< The LVGL card object
+        String config;         ///< Config value the card was created with (diff key with its type)
     };
     std::unordered_map<CardType, std::vector<CardInstance>> dynamicCards; ///< All dynamic cards by type
     
@@ -184,13 +231,32 @@ private:
     DisplayInterface* displayInterface;  ///< Thread-safe display interface
     
     // UI Threading
-    static QueueHandle_t uiQueue;  ///< Queue for thread-safe UI updates
+    static UIUpdateQueue* uiQueue;  ///< Coalescing queue for thread-safe UI updates
+    static UIQueueStats uiQueueStats;  ///< Written only by the LVGL task
     
     // Card registration and management
     std::vector<CardDefinition> registeredCardTypes; ///< Available card types with factory functions
     std::vector<CardConfig> currentCardConfigs;      ///< Current card configuration from storage
     bool reconcileInProgress = false;                ///< Flag to prevent concurrent reconciliations
     
+#if DISPLAY_BUFFER_BENCHMARK
+    /**
+     * @brief Render every card with each buffer strategy and log ms/frame
+     * 
+     * Runs on the LVGL task; the UI is unresponsive until it finishes.
+     */
+    void runRenderBenchmark();
+#endif
+    
+#if RENDER_PROFILER
+    lv_obj_t* profiledCard = nullptr;  ///< Card the render profiler is attributing frames to
+    
+    /**
+     * @brief Point the render profiler at the card now on screen
+     */
+    void updateProfiledCard();
+#endif
+    
     /**
      * @brief Create and initialize the animation card
      */
@@ -222,7 +288,9 @@ private:
 
     /**
      * @brief Reconcile current cards with new configuration
-     * Diffs configuration, removes old cards, creates new ones, and reorders
+     * Diffs configuration keyed on (CardType, config): surviving cards keep their
+     * LVGL objects and data, only added cards are created, only removed cards are
+     * deleted, and the stack is reordered in place
      * @param newConfigs New card configuration from storage
      */
     void reconcileCards(const std::vector<CardConfig>& newConfigs);
@@ -1,14 +1,17 @@
 #include "CardNavigationStack.h"
 #include "hardware/Input.h"
-
-// External button objects - defined in main.cpp
-extern Bounce2::Button buttons[];
-
-// Use the same NUM_BUTTONS definition as main.cpp
-#define NUM_BUTTONS 3
+#include "RenderProfiler.h"
+#include <algorithm>
+#include <esp_heap_caps.h>
+#include <lvgl_private.h>  // lv_timer_t::period
 
 CardNavigationStack::CardNavigationStack(lv_obj_t* parent, uint16_t width, uint16_t height)
-    : _parent(parent), _width(width), _height(height), _current_card(0), _mutex_ptr(nullptr) {
+    : _parent(parent), _width(width), _height(height), _current_card(0),
+      _window_radius(CARD_STACK_WINDOW_RADIUS), _pip_count(0), _active_pip(0),
+      _snapshot_transitions(CARD_STACK_SNAPSHOT_TRANSITIONS != 0), _snapshot_data{nullptr, nullptr},
+      _snapshot_data_size(0), _transition_layer(nullptr), _transition_images{nullptr, nullptr},
+      _transition_direction(1), _transition_start_ms(0), _transition_frames(0),
+      _transition_capture_us(0), _mutex_ptr(nullptr) {
     
     // Create main container
     _main_container = lv_obj_create(_parent);
@@ -23,75 +26,63 @@ CardNavigationStack::CardNavigationStack(lv_obj_t* parent, uint16_t width, uint1
     lv_obj_set_style_pad_bottom(_main_container, 0, 0);
     lv_obj_set_style_pad_row(_main_container, 0, 0);  // No gap between cards
     lv_obj_set_flex_flow(_main_container, LV_FLEX_FLOW_COLUMN);
-    lv_obj_add_event_cb(_main_container, _scroll_event_cb, LV_EVENT_SCROLL, NULL);
     lv_obj_set_scroll_dir(_main_container, LV_DIR_VER);
     lv_obj_set_scroll_snap_y(_main_container, LV_SCROLL_SNAP_CENTER);
     lv_obj_set_scrollbar_mode(_main_container, LV_SCROLLBAR_MODE_OFF);
 
-    // Create scroll indicator container
+    // Create scroll indicator: a single 2px column whose pips are painted in a draw callback
     _scroll_indicator = lv_obj_create(_parent);
-    lv_obj_set_size(_scroll_indicator, 2, _height);  // 2px wide container
+    lv_obj_remove_style_all(_scroll_indicator);
+    lv_obj_set_size(_scroll_indicator, 2, _height);  // 2px wide column
     lv_obj_align(_scroll_indicator, LV_ALIGN_RIGHT_MID, 0, 0);  // Keep flush with right edge
-    lv_obj_set_style_bg_color(_scroll_indicator, lv_color_black(), 0);
-    lv_obj_set_style_bg_opa(_scroll_indicator, LV_OPA_TRANSP, 0);  // Make container transparent
-    lv_obj_set_style_border_width(_scroll_indicator, 0, 0);
-    lv_obj_set_style_pad_all(_scroll_indicator, 0, 0);
-    lv_obj_set_style_pad_row(_scroll_indicator, 5, 0);  // 5px gap between pips
-    lv_obj_set_flex_flow(_scroll_indicator, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(_scroll_indicator, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     lv_obj_clear_flag(_scroll_indicator, LV_OBJ_FLAG_SCROLLABLE);     // Disable scrolling
+    lv_obj_clear_flag(_scroll_indicator, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_scroll_indicator, _pip_draw_cb, LV_EVENT_DRAW_MAIN, this);
 }
 
 void CardNavigationStack::_update_pip_count() {
     uint32_t card_count = lv_obj_get_child_cnt(_main_container);
-    uint32_t pip_count = lv_obj_get_child_cnt(_scroll_indicator);
-    
-    // Ensure we have at least 1 card for calculations
-    if (card_count == 0) {
-        // Remove all pips if no cards
-        while (pip_count > 0) {
-            lv_obj_t* pip = lv_obj_get_child(_scroll_indicator, 0);
-            if (pip) {
-                lv_obj_del(pip);
-            }
-            pip_count--;
-        }
-        return;
-    }
-    
-    // Calculate pip height based on card count
-    // Height = (container height - (gaps between pips)) / number of pips
-    int32_t total_gaps = (card_count > 1) ? ((card_count - 1) * 5) : 0;
-    int32_t pip_height = (_height - total_gaps) / card_count;
+    if (card_count == _pip_count) return;
     
-    // Ensure minimum pip height
-    if (pip_height < 2) pip_height = 2;
-    
-    // Remove all existing pips and recreate to ensure consistency
-    while (pip_count > 0) {
-        lv_obj_t* pip = lv_obj_get_child(_scroll_indicator, 0);
-        if (pip) {
-            lv_obj_del(pip);
-        }
-        pip_count--;
+    _pip_count = card_count;
+    lv_obj_invalidate(_scroll_indicator);
+}
+
+void CardNavigationStack::_pip_draw_cb(lv_event_t* e) {
+    CardNavigationStack* self = static_cast<CardNavigationStack*>(lv_event_get_user_data(e));
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    lv_layer_t* layer = lv_event_get_layer(e);
+    uint32_t count = self->_pip_count;
+    if (count == 0) return;
+    
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    int32_t height = lv_area_get_height(&coords);
+    
+    // Height = (container height - (gaps between pips)) / number of pips,
+    // shrinking the gap when there are too many cards to fit
+    int32_t gap = PIP_GAP;
+    int32_t pip_height = (height - (int32_t)(count - 1) * gap) / (int32_t)count;
+    if (pip_height < 2) {
+        gap = 1;
+        pip_height = (height - (int32_t)(count - 1) * gap) / (int32_t)count;
+        if (pip_height < 1) pip_height = 1;
     }
     
-    // Create new pips
-    for (uint32_t i = 0; i < card_count; i++) {
-        lv_obj_t* pip = lv_obj_create(_scroll_indicator);
-        lv_obj_set_size(pip, 2, pip_height);  // 2px wide
-        lv_obj_set_style_radius(pip, 0, 0);  // Rectangle shape
-        lv_obj_set_style_bg_color(pip, lv_color_hex(0x808080), 0);  // Gray by default
-        lv_obj_set_style_border_width(pip, 0, 0);
-        lv_obj_clear_flag(pip, LV_OBJ_FLAG_SCROLLABLE);
-    }
+    // Centre the column of pips vertically
+    int32_t total = (int32_t)count * pip_height + (int32_t)(count - 1) * gap;
+    int32_t y = coords.y1 + (height - total) / 2;
     
-    // Make the first pip active if we just created pips
-    if (_current_card < card_count) {
-        lv_obj_t* active_pip = lv_obj_get_child(_scroll_indicator, _current_card);
-        if (active_pip) {
-            lv_obj_set_style_bg_color(active_pip, lv_color_white(), 0);
-        }
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = 0;  // Rectangle shape
+    dsc.bg_opa = LV_OPA_COVER;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        lv_area_t pip_area = { coords.x1, y, coords.x2, y + pip_height - 1 };
+        dsc.bg_color = (i == self->_active_pip) ? lv_color_white() : lv_color_hex(0x808080);
+        lv_draw_rect(layer, &dsc, &pip_area);
+        y += pip_height + gap;
     }
 }
 
@@ -135,6 +126,22 @@ void CardNavigationStack::goToCard(uint8_t index) {
     uint32_t card_count = lv_obj_get_child_cnt(_main_container);
     if (index >= card_count) return;
     
+    // A new navigation settles any slide still in flight
+    if (_transition_layer) {
+        lv_anim_delete(this, _transition_anim_cb);
+        _finish_snapshot_transition();
+    }
+    
+    // Card positions must be current after adds, removals and reorders
+    lv_obj_update_layout(_main_container);
+    
+    // The card on screen is wherever the container is scrolled to, which may
+    // differ from _current_card after cards were reordered
+    int32_t scroll_y = lv_obj_get_scroll_y(_main_container);
+    uint32_t visible_index = _height > 0 ? (uint32_t)((scroll_y + _height / 2) / _height) : 0;
+    if (visible_index >= card_count) visible_index = card_count - 1;
+    lv_obj_t* visible_card = lv_obj_get_child(_main_container, visible_index);
+    
     _current_card = index;
     lv_obj_t* target_card = lv_obj_get_child(_main_container, _current_card);
     if (!target_card) {
@@ -142,6 +149,48 @@ void CardNavigationStack::goToCard(uint8_t index) {
         return;
     }
     
+    // Rebuild the target and its neighbours before scrolling to them
+    _update_window();
+    
+    bool started = false;
+    if (_snapshot_transitions && visible_card && visible_card != target_card) {
+        // Slide in the direction navigation wraps: forward when the target
+        // is at most half the stack ahead
+        uint32_t forward = (index + card_count - visible_index) % card_count;
+        int8_t direction = (forward <= card_count / 2) ? 1 : -1;
+        started = _start_snapshot_transition(visible_card, target_card, direction);
+    }
+    if (!started) {
+        _start_scroll_transition(target_card);
+    }
+    
+    _update_scroll_indicator(_current_card);
+}
+
+void CardNavigationStack::jumpToCard(uint8_t index) {
+    uint32_t card_count = lv_obj_get_child_cnt(_main_container);
+    if (index >= card_count) return;
+    
+    if (_transition_layer) {
+        lv_anim_delete(this, _transition_anim_cb);
+        _finish_snapshot_transition();
+    }
+    lv_anim_delete(_main_container, (lv_anim_exec_xcb_t)lv_obj_scroll_to_y);
+    
+    _current_card = index;
+    _update_window();
+    lv_obj_update_layout(_main_container);
+    
+    lv_obj_t* target_card = lv_obj_get_child(_main_container, _current_card);
+    lv_obj_scroll_to_y(_main_container, lv_obj_get_y(target_card), LV_ANIM_OFF);
+    _update_scroll_indicator(_current_card);
+}
+
+void CardNavigationStack::setSnapshotTransitions(bool enabled) {
+    _snapshot_transitions = enabled;
+}
+
+void CardNavigationStack::_start_scroll_transition(lv_obj_t* target_card) {
     // Get the actual position of the target card
     lv_coord_t target_y = lv_obj_get_y(target_card);
     
@@ -151,20 +200,156 @@ void CardNavigationStack::goToCard(uint8_t index) {
     lv_anim_set_var(&a, _main_container);
     lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_scroll_to_y);
     lv_anim_set_values(&a, lv_obj_get_scroll_y(_main_container), target_y);
-    lv_anim_set_time(&a, 200);
+    lv_anim_set_time(&a, TRANSITION_TIME_MS);
     lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
     lv_anim_start(&a);
     
     // Short delay after animation
     vTaskDelay(pdMS_TO_TICKS(1));
+}
+
+bool CardNavigationStack::_ensure_snapshot_buffers() {
+    uint32_t w = _width - 7;
+    uint32_t h = _height;
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * h;
+    if (_snapshot_data[0] && _snapshot_data[1] && _snapshot_data_size >= size) {
+        return true;
+    }
     
-    _update_scroll_indicator(_current_card);
+    for (int i = 0; i < 2; i++) {
+        if (_snapshot_data[i]) {
+            heap_caps_free(_snapshot_data[i]);
+            _snapshot_data[i] = nullptr;
+        }
+    }
+    _snapshot_data_size = 0;
+    
+    // PSRAM only: the buffers are only read once per frame while sliding, and
+    // two card-sized buffers would take internal RAM the render stripes need
+    for (int i = 0; i < 2; i++) {
+        _snapshot_data[i] = (uint8_t*)heap_caps_aligned_alloc(LV_DRAW_BUF_ALIGN, size, MALLOC_CAP_SPIRAM);
+        if (!_snapshot_data[i]) {
+            Serial.printf("[CardStack] Could not allocate %lu byte snapshot buffer in PSRAM, using live scrolling\n",
+                          (unsigned long)size);
+            if (i == 1) {
+                heap_caps_free(_snapshot_data[0]);
+                _snapshot_data[0] = nullptr;
+            }
+            _snapshot_transitions = false;
+            return false;
+        }
+    }
+    _snapshot_data_size = size;
+    return true;
+}
+
+bool CardNavigationStack::_start_snapshot_transition(lv_obj_t* from_card, lv_obj_t* to_card, int8_t direction) {
+    if (!_ensure_snapshot_buffers()) {
+        return false;
+    }
+    
+    uint32_t start_us = micros();
+    
+    lv_obj_t* cards[2] = { from_card, to_card };
+    for (int i = 0; i < 2; i++) {
+        lv_draw_buf_init(&_snapshot_bufs[i], _width - 7, _height, LV_COLOR_FORMAT_RGB565,
+                         LV_STRIDE_AUTO, _snapshot_data[i], _snapshot_data_size);
+        if (lv_snapshot_take_to_draw_buf(cards[i], LV_COLOR_FORMAT_RGB565, &_snapshot_bufs[i]) != LV_RESULT_OK) {
+            Serial.printf("[CardStack] Snapshot of card %d failed, using live scrolling\n", i);
+            return false;
+        }
+        // The buffers are reused, so never serve a cached decode of the previous image
+        lv_image_cache_drop(&_snapshot_bufs[i]);
+    }
+    _transition_capture_us = micros() - start_us;
+    
+    // Jump the live container to its final position and keep it out of the
+    // render path until the slide completes
+    lv_obj_scroll_to_y(_main_container, lv_obj_get_y(to_card), LV_ANIM_OFF);
+    lv_obj_add_flag(_main_container, LV_OBJ_FLAG_HIDDEN);
+    
+    _transition_layer = lv_obj_create(_parent);
+    lv_obj_remove_style_all(_transition_layer);
+    lv_obj_set_size(_transition_layer, _width - 7, _height);
+    lv_obj_align(_transition_layer, LV_ALIGN_LEFT_MID, 0, 0);
+    lv_obj_set_style_bg_color(_transition_layer, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(_transition_layer, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(_transition_layer, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(_transition_layer, LV_OBJ_FLAG_CLICKABLE);
+    
+    for (int i = 0; i < 2; i++) {
+        _transition_images[i] = lv_image_create(_transition_layer);
+        lv_image_set_src(_transition_images[i], &_snapshot_bufs[i]);
+        lv_obj_set_pos(_transition_images[i], 0, 0);
+    }
+    _transition_direction = direction;
+    _transition_frames = 0;
+    _transition_start_ms = lv_tick_get();
+    _transition_anim_cb(this, 0);
+    
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, this);
+    lv_anim_set_exec_cb(&a, _transition_anim_cb);
+    lv_anim_set_values(&a, 0, _height);
+    lv_anim_set_time(&a, TRANSITION_TIME_MS);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+    lv_anim_set_completed_cb(&a, _transition_done_cb);
+    lv_anim_start(&a);
+    return true;
+}
+
+void CardNavigationStack::_transition_anim_cb(void* var, int32_t value) {
+    CardNavigationStack* self = static_cast<CardNavigationStack*>(var);
+    if (!self->_transition_layer) return;
+    
+    // Outgoing image leaves as the incoming one arrives from the other side
+    int32_t offset = self->_transition_direction * value;
+    lv_obj_set_y(self->_transition_images[0], -offset);
+    lv_obj_set_y(self->_transition_images[1], self->_transition_direction * (int32_t)self->_height - offset);
+    self->_transition_frames++;
+}
+
+void CardNavigationStack::_transition_done_cb(lv_anim_t* a) {
+    static_cast<CardNavigationStack*>(a->var)->_finish_snapshot_transition();
+}
+
+void CardNavigationStack::_finish_snapshot_transition() {
+    if (!_transition_layer) return;
+    
+    // Deleting the overlay drops the only references to the snapshot buffers,
+    // which stay allocated for the next transition
+    lv_obj_delete(_transition_layer);
+    _transition_layer = nullptr;
+    _transition_images[0] = nullptr;
+    _transition_images[1] = nullptr;
+    
+    // Resume live rendering of the card stack
+    lv_obj_clear_flag(_main_container, LV_OBJ_FLAG_HIDDEN);
+    
+#if RENDER_PROFILER
+    uint32_t elapsed_ms = lv_tick_elaps(_transition_start_ms);
+    
+    // The refresh period follows the active card's frame rate, so ask the timer
+    lv_timer_t* refr_timer = lv_display_get_refr_timer(lv_obj_get_display(_main_container));
+    uint32_t period_ms = (refr_timer && refr_timer->period > 0) ? refr_timer->period : LV_DEF_REFR_PERIOD;
+    uint32_t expected = elapsed_ms / period_ms;
+    uint32_t dropped = expected > _transition_frames ? expected - _transition_frames : 0;
+    Serial.printf("[CardStack] Snapshot transition: captured in %lu us, %lu ms, %lu frames at %lu ms, %lu dropped\n",
+                  (unsigned long)_transition_capture_us, (unsigned long)elapsed_ms,
+                  (unsigned long)_transition_frames, (unsigned long)period_ms, (unsigned long)dropped);
+#endif
 }
 
 uint8_t CardNavigationStack::getCurrentIndex() const {
     return _current_card;
 }
 
+lv_obj_t* CardNavigationStack::getCurrentCard() const {
+    return lv_obj_get_child(_main_container, _current_card);
+}
+
 uint32_t CardNavigationStack::getCardCount() const {
     return lv_obj_get_child_cnt(_main_container);
 }
@@ -182,23 +367,17 @@ void CardNavigationStack::handleButtonPress(uint8_t button_index) {
     }
     
     // Try to delegate button press to active card's input handler first
-    lv_obj_t* current_card = lv_obj_get_child(_main_container, _current_card);
+    InputHandler* handler = _handler_for(lv_obj_get_child(_main_container, _current_card));
     bool handled = false;
     
-    for (const auto& handler_pair : _input_handlers) {
-        if (handler_pair.first == current_card) {
-            // Found a handler for the current card
-            if (handler_pair.second) {
-                handled = handler_pair.second->handleButtonPress(button_index);
-                if (handled) {
-                    // Handler processed the button press, don't do default behavior
-                    if (_mutex_ptr) {
-                        xSemaphoreGive(*_mutex_ptr);
-                    }
-                    return;
-                }
+    if (handler) {
+        handled = handler->handleButtonPress(button_index);
+        if (handled) {
+            // Handler processed the button press, don't do default behavior
+            if (_mutex_ptr) {
+                xSemaphoreGive(*_mutex_ptr);
             }
-            break;
+            return;
         }
     }
     
@@ -218,10 +397,33 @@ void CardNavigationStack::handleButtonPress(uint8_t button_index) {
     }
 }
 
+void CardNavigationStack::handleButtonRepeat(uint8_t button_index) {
+    if (_mutex_ptr) {
+        if (xSemaphoreTake(*_mutex_ptr, pdMS_TO_TICKS(10)) != pdTRUE) {
+            return;
+        }
+    }
+
+    if (!activeCardNeedsFrames()) {
+        if (button_index == Input::BUTTON_DOWN) {
+            nextCard();
+        } else if (button_index == Input::BUTTON_UP) {
+            prevCard();
+        }
+    }
+
+    if (_mutex_ptr) {
+        xSemaphoreGive(*_mutex_ptr);
+    }
+}
+
 void CardNavigationStack::registerInputHandler(lv_obj_t* card, InputHandler* handler) {
     // Don't register null handlers
     if (!card || !handler) return;
     
+    // The hot paths read the handler straight from the card object
+    lv_obj_set_user_data(card, handler);
+    
     // Check if this card already has a handler
     for (auto& handler_pair : _input_handlers) {
         if (handler_pair.first == card) {
@@ -235,6 +437,17 @@ void CardNavigationStack::registerInputHandler(lv_obj_t* card, InputHandler* han
     _input_handlers.push_back(std::make_pair(card, handler));
 }
 
+bool CardNavigationStack::moveCard(lv_obj_t* card, uint32_t index) {
+    if (!card || lv_obj_get_parent(card) != _main_container) {
+        return false;
+    }
+    
+    if ((uint32_t)lv_obj_get_index(card) != index) {
+        lv_obj_move_to_index(card, index);
+    }
+    return true;
+}
+
 void CardNavigationStack::forceUpdateIndicators() {
     // Force update pip count
     _update_pip_count();
@@ -242,46 +455,97 @@ void CardNavigationStack::forceUpdateIndicators() {
     // Force update active indicator
     _update_scroll_indicator(_current_card);
     
-    // Force LVGL to redraw the indicator container
+    // Force LVGL to redraw the indicator column
     lv_obj_invalidate(_scroll_indicator);
+    
+    // Bulk operations can move cards in or out of the window
+    _update_window();
 }
 
-void CardNavigationStack::updateActiveCard() {
-    // Get the current card
-    lv_obj_t* currentCard = lv_obj_get_child(_main_container, _current_card);
-    if (!currentCard) return;
+void CardNavigationStack::setWindowRadius(uint8_t radius) {
+    _window_radius = radius;
+    _update_window();
+}
+
+void CardNavigationStack::_update_window() {
+    int32_t card_count = lv_obj_get_child_cnt(_main_container);
+    if (card_count == 0) return;
+    
+#if RENDER_PROFILER
+    uint32_t start_us = micros();
+    uint32_t live = 0;
+    uint32_t changed = 0;
+#endif
     
-    // Find the input handler for this card
     for (const auto& handler_pair : _input_handlers) {
-        if (handler_pair.first == currentCard) {
-            // Call update on the handler
-            handler_pair.second->update();
-            break;
+        int32_t index = lv_obj_get_index(handler_pair.first);
+        if (index < 0 || !handler_pair.second) continue;
+        
+        // Navigation wraps around, so distance is measured both ways
+        int32_t distance = abs(index - (int32_t)_current_card);
+        distance = std::min(distance, card_count - distance);
+        
+        bool in_window = (_window_radius == 0) || (distance <= _window_radius);
+#if RENDER_PROFILER
+        bool was_materialized = handler_pair.second->isMaterialized();
+#endif
+        if (in_window) {
+            handler_pair.second->materialize();
+        } else {
+            handler_pair.second->dematerialize();
         }
+        
+#if RENDER_PROFILER
+        if (handler_pair.second->isMaterialized()) {
+            live++;
+        }
+        if (handler_pair.second->isMaterialized() != was_materialized) {
+            changed++;
+        }
+#endif
+    }
+    
+#if RENDER_PROFILER
+    if (changed > 0) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        Serial.printf("[CardStack] Window at %u: %u/%u cards live, %u changed in %lu us, LVGL heap used %u bytes\n",
+                      _current_card, (unsigned)live, (unsigned)_input_handlers.size(), (unsigned)changed,
+                      (unsigned long)(micros() - start_us), (unsigned)(mon.total_size - mon.free_size));
     }
+#endif
 }
 
-void CardNavigationStack::_scroll_event_cb(lv_event_t* e) {
-    lv_obj_t* cont = static_cast<lv_obj_t*>(lv_event_get_target(e));
-    lv_area_t cont_a;
-    lv_obj_get_coords(cont, &cont_a);
-    int32_t cont_y_center = cont_a.y1 + lv_area_get_height(&cont_a) / 2;
-
-    uint32_t child_cnt = lv_obj_get_child_cnt(cont);
+void CardNavigationStack::updateActiveCard() {
+    // Runs every LVGL iteration: child lookup and user data are both O(1)
+    InputHandler* handler = _handler_for(lv_obj_get_child(_main_container, _current_card));
     
-    for(uint32_t i = 0; i < child_cnt; i++) {
-        lv_obj_t* child = lv_obj_get_child(cont, i);
-        // Remove all opacity effects - everything is fully opaque
-        lv_obj_set_style_opa(child, LV_OPA_COVER, 0);
+    // Static cards are never ticked
+    if (handler && handler->needsPerFrameUpdate()) {
+        handler->update();
     }
 }
 
+bool CardNavigationStack::activeCardNeedsFrames() {
+    InputHandler* handler = _handler_for(lv_obj_get_child(_main_container, _current_card));
+    return handler && handler->needsPerFrameUpdate();
+}
+
+uint8_t CardNavigationStack::activeFrameRate() {
+    InputHandler* handler = _handler_for(lv_obj_get_child(_main_container, _current_card));
+    return handler ? handler->desiredFrameRate() : 0;
+}
+
+InputHandler* CardNavigationStack::_handler_for(lv_obj_t* card) {
+    if (!card) return nullptr;
+    return static_cast<InputHandler*>(lv_obj_get_user_data(card));
+}
+
 void CardNavigationStack::_update_scroll_indicator(int active_index) {
     uint32_t card_count = lv_obj_get_child_cnt(_main_container);
-    uint32_t pip_count = lv_obj_get_child_cnt(_scroll_indicator);
     
     // Safety check - if we have no cards, don't update anything
-    if (card_count == 0 || pip_count == 0) return;
+    if (card_count == 0) return;
     
     // Ensure active_index is valid
     if (active_index >= card_count) {
@@ -289,40 +553,13 @@ void CardNavigationStack::_update_scroll_indicator(int active_index) {
         _current_card = active_index; // Update the current card too
     }
     
-    // Safety check for pip count
-    if (pip_count != card_count) {
-        // Force re-sync pips with cards
-        _update_pip_count();
-        pip_count = lv_obj_get_child_cnt(_scroll_indicator);
-    }
-    
-    // Keep track of previous active index with a static variable
-    static int previous_index = 0;
+    // Keep the pip count in sync with the cards
+    _update_pip_count();
     
-    // Only update if we're changing to a different pip
-    if (previous_index != active_index) {
-        // Bounds checking for previous pip
-        if (previous_index < pip_count) {
-            // Get previous pip with bounds check
-            lv_obj_t* prev_pip = lv_obj_get_child(_scroll_indicator, previous_index);
-            if (prev_pip) {
-                // Change color of inactive pip
-                lv_obj_set_style_bg_color(prev_pip, lv_color_hex(0x808080), 0);
-            }
-        }
-
-        // Bounds checking for new pip
-        if (active_index < pip_count) {
-            // Get new pip with bounds check
-            lv_obj_t* new_pip = lv_obj_get_child(_scroll_indicator, active_index);
-            if (new_pip) {
-                // Change color of active pip
-                lv_obj_set_style_bg_color(new_pip, lv_color_white(), 0);
-            }
-        }
-
-        // Update previous index for next time
-        previous_index = active_index;
+    // Only repaint if the active pip changed
+    if (_active_pip != (uint32_t)active_index) {
+        _active_pip = active_index;
+        lv_obj_invalidate(_scroll_indicator);
     }
 }
 
@@ -334,6 +571,12 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
         return false; // Card not in our container
     }
     
+    // Never leave the live container hidden behind a stale slide
+    if (_transition_layer) {
+        lv_anim_delete(this, _transition_anim_cb);
+        _finish_snapshot_transition();
+    }
+    
     // Find the index of the card
     uint32_t card_index = 0;
     bool found = false;
@@ -375,6 +618,7 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
     }
     
     // Remove input handler for this card if it exists
+    lv_obj_set_user_data(card, nullptr);
     for (auto it = _input_handlers.begin(); it != _input_handlers.end(); ++it) {
         if (it->first == card) {
             _input_handlers.erase(it);
@@ -385,8 +629,8 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
     // Delete the card from LVGL
     lv_obj_del(card);
     
-    // Force LVGL to process the deletion
-    lv_refr_now(NULL);
+    // Recompute card positions for scroll_to_view below, without rendering
+    lv_obj_update_layout(_main_container);
     
     // Update the scroll indicator (this will recreate all pips)
     _update_pip_count();
@@ -405,6 +649,7 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
         
         // Update scroll indicator after scrolling
         _update_scroll_indicator(_current_card);
+        _update_window();
     } else {
         // No cards left, reset current card index
         _current_card = 0;
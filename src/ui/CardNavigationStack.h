@@ -2,23 +2,46 @@
 
 #include <lvgl.h>
 #include <Arduino.h>
-#include <Bounce2.h>
 #include <vector>
 #include "ui/InputHandler.h"
 
 // Forward declaration
 class DisplayInterface;
 
+/**
+ * @brief Number of cards on each side of the current card kept materialized
+ * 
+ * Cards further away are asked to dematerialize() their LVGL content.
+ * Set to 0 to keep every card live (windowing disabled).
+ */
+#ifndef CARD_STACK_WINDOW_RADIUS
+#define CARD_STACK_WINDOW_RADIUS 1
+#endif
+
+/**
+ * @brief Animate card transitions from cached snapshots
+ * 
+ * When enabled, goToCard() captures the outgoing and incoming cards into
+ * RGB565 buffers and slides those images instead of scrolling the live
+ * container, so only two blits are rendered per animation frame. The
+ * buffers need PSRAM; without it the live container is scrolled.
+ * Set to 0 to always scroll the live container.
+ */
+#ifndef CARD_STACK_SNAPSHOT_TRANSITIONS
+#define CARD_STACK_SNAPSHOT_TRANSITIONS 1
+#endif
+
 /**
  * @class CardNavigationStack
  * @brief Manages a vertically scrolling stack of cards with visual indicators
  * 
  * Provides a container for card-based UI elements with:
- * - Smooth animated transitions between cards
+ * - Smooth animated transitions between cards, slid from cached snapshots
  * - Visual scroll indicators (pips) showing current position
  * - Button-based navigation
  * - Support for card-specific input handling
  * - Thread-safe button handling via mutex
+ * - Windowed mode that keeps only the current card and its neighbours materialized
  */
 class CardNavigationStack {
 public:
@@ -71,12 +94,26 @@ public:
      */
     void goToCard(uint8_t index);
     
+    /**
+     * @brief Show a card immediately, without a transition
+     * @param index Zero-based index of target card
+     * 
+     * Used where the move itself must not be animated, e.g. render benchmarks.
+     */
+    void jumpToCard(uint8_t index);
+    
     /**
      * @brief Get index of currently visible card
      * @return Zero-based index of current card
      */
     uint8_t getCurrentIndex() const;
     
+    /**
+     * @brief Get the LVGL object of the current card
+     * @return Card object, or nullptr if the stack is empty
+     */
+    lv_obj_t* getCurrentCard() const;
+    
     /**
      * @brief Get the total number of cards in the stack
      * @return Total card count
@@ -97,14 +134,51 @@ public:
      * to card-specific input handlers if registered.
      */
     void handleButtonPress(uint8_t button_index);
+
+    /**
+     * @brief Process auto-repeat while UP or DOWN is held
+     * @param button_index Index of the held button
+     * 
+     * Only navigates; cards never see repeats as presses. Ignored while a
+     * per-frame card (a game) is active, since it reads held buttons itself.
+     */
+    void handleButtonRepeat(uint8_t button_index);
     
     /**
      * @brief Register an input handler for a specific card
      * @param card LVGL object to handle input for
      * @param handler InputHandler implementation
+     * 
+     * The handler is stored as the card object's LVGL user data so lookups
+     * on the button and per-frame paths are O(1).
      */
     void registerInputHandler(lv_obj_t* card, InputHandler* handler);
     
+    /**
+     * @brief Move an existing card to a new position in the stack
+     * @param card LVGL card object already added to the stack
+     * @param index Target position (0 = top)
+     * @return true if the card belongs to this stack and was moved
+     * 
+     * Does not change the current index; callers re-select the card they want shown.
+     */
+    bool moveCard(lv_obj_t* card, uint32_t index);
+    
+    /**
+     * @brief Set how many neighbours of the current card stay materialized
+     * @param radius Cards on each side to keep live, 0 keeps every card live
+     */
+    void setWindowRadius(uint8_t radius);
+    
+    /**
+     * @brief Choose between snapshot transitions and live scrolling
+     * @param enabled true to slide cached snapshots, false to scroll the live container
+     * 
+     * The buffers live in PSRAM only. If they cannot be allocated, snapshot
+     * transitions are switched off and the stack scrolls live.
+     */
+    void setSnapshotTransitions(bool enabled);
+    
     /**
      * @brief Force update of pip indicators
      * 
@@ -116,26 +190,69 @@ public:
     /**
      * @brief Update the active card if it needs updates
      * 
-     * Calls the update() method on the currently active card's InputHandler.
-     * Should be called regularly from the main LVGL task.
+     * Calls the update() method on the currently active card's InputHandler
+     * if it reports needsPerFrameUpdate(). Should be called regularly from
+     * the main LVGL task.
      */
     void updateActiveCard();
     
+    /**
+     * @brief True if the active card must be ticked every loop iteration
+     * 
+     * The LVGL task keeps a fixed cadence while this holds instead of
+     * sleeping until the next LVGL timer.
+     */
+    bool activeCardNeedsFrames();
+    
+    /**
+     * @brief Refresh rate requested by the active card, 0 for on demand
+     */
+    uint8_t activeFrameRate();
+    
 private:
     /**
-     * @brief LVGL scroll event callback
-     * Updates scroll indicators when scrolling occurs
+     * @brief Scroll the live container to the current card over 200ms
+     */
+    void _start_scroll_transition(lv_obj_t* target_card);
+
+    /**
+     * @brief Slide snapshots of two cards over the hidden live container
+     * @param from_card Card currently on screen
+     * @param to_card Card being navigated to
+     * @param direction 1 when the new card enters from below, -1 from above
+     * @return false if a snapshot could not be taken; nothing was changed
+     */
+    bool _start_snapshot_transition(lv_obj_t* from_card, lv_obj_t* to_card, int8_t direction);
+
+    /**
+     * @brief Delete the snapshot overlay and show the live container again
+     */
+    void _finish_snapshot_transition();
+
+    /**
+     * @brief Allocate the two snapshot buffers, sized for one card
+     * @return false if PSRAM and internal RAM are both exhausted
      */
-    static void _scroll_event_cb(lv_event_t* e);
+    bool _ensure_snapshot_buffers();
+
+    static void _transition_anim_cb(void* var, int32_t value);
+    static void _transition_done_cb(lv_anim_t* a);
     
     /**
      * @brief Update number of scroll indicator pips
      * 
-     * Adds or removes pips to match card count.
-     * Adjusts pip height to fill container evenly.
+     * Syncs the pip count with the card count and invalidates the
+     * indicator column if it changed. No objects are created.
      */
     void _update_pip_count();
 
+    /**
+     * @brief Draw callback painting all pips into the indicator column
+     * 
+     * Pip height fills the column evenly; the active pip is white.
+     */
+    static void _pip_draw_cb(lv_event_t* e);
+
     /**
      * @brief Update active scroll indicator
      * @param active_index Index of currently active card
@@ -143,11 +260,22 @@ private:
      * Highlights the pip corresponding to active card.
      */
     void _update_scroll_indicator(int active_index);
+
+    /**
+     * @brief Materialize cards inside the window around the current card
+     * and dematerialize the rest
+     */
+    void _update_window();
+
+    /**
+     * @brief Input handler registered for a card, read from its user data
+     */
+    static InputHandler* _handler_for(lv_obj_t* card);
     
     // UI elements
     lv_obj_t* _parent;              ///< Parent LVGL object
     lv_obj_t* _main_container;      ///< Container for cards
-    lv_obj_t* _scroll_indicator;    ///< Container for indicator pips
+    lv_obj_t* _scroll_indicator;    ///< Custom-drawn column showing one pip per card
     
     // Dimensions
     uint16_t _width;                ///< Width of card stack
@@ -155,10 +283,29 @@ private:
     
     // Navigation state
     uint8_t _current_card;          ///< Index of currently visible card
+    uint8_t _window_radius;         ///< Live cards on each side of the current one (0 = all)
+    
+    // Indicator state painted by _pip_draw_cb
+    static constexpr int32_t PIP_GAP = 5;  ///< Gap between pips in pixels
+    uint32_t _pip_count;            ///< Number of pips drawn
+    uint32_t _active_pip;           ///< Index of the highlighted pip
+    
+    // Snapshot transition state
+    static constexpr uint32_t TRANSITION_TIME_MS = 200;
+    bool _snapshot_transitions;     ///< Slide snapshots instead of scrolling the live container
+    lv_draw_buf_t _snapshot_bufs[2];  ///< Outgoing and incoming card images
+    uint8_t* _snapshot_data[2];     ///< Pixel storage behind _snapshot_bufs
+    uint32_t _snapshot_data_size;   ///< Bytes allocated for each buffer
+    lv_obj_t* _transition_layer;    ///< Overlay holding the two images, nullptr when idle
+    lv_obj_t* _transition_images[2];
+    int8_t _transition_direction;   ///< 1 = incoming card slides up from below, -1 = down from above
+    uint32_t _transition_start_ms;  ///< lv_tick at animation start
+    uint32_t _transition_frames;    ///< Animation steps rendered so far
+    uint32_t _transition_capture_us;  ///< Time spent taking both snapshots
     
     // Thread safety
     SemaphoreHandle_t* _mutex_ptr;  ///< Optional mutex for thread-safe updates
     
     // Input handling
-    std::vector<std::pair<lv_obj_t*, InputHandler*>> _input_handlers;  ///< Card-specific input handlers
+    std::vector<std::pair<lv_obj_t*, InputHandler*>> _input_handlers;  ///< All registered handlers, for whole-stack passes
 }; 
\ No newline at end of file
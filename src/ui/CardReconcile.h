@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Diff of the live cards against a new card configuration
+ *
+ * Plain bookkeeping with no LVGL or network access, so reconcile decisions
+ * can be tested on the host. CardController::reconcileCards() applies it.
+ */
+struct CardReconcilePlan {
+    static constexpr size_t CREATE = (size_t)-1;
+
+    std::vector<size_t> reuse;  ///< Per configured card: index of the live card it keeps, or CREATE
+    std::vector<bool> kept;     ///< Per live card: still configured
+    size_t created = 0;         ///< Configured cards that need their factory run
+    size_t removed = 0;         ///< Live cards to delete
+};
+
+/**
+ * @brief Match configured cards to live ones by key
+ *
+ * Keys are compared with ==, typically (CardType, config value). Duplicate
+ * keys are matched one-to-one in order, so two cards showing the same insight
+ * both survive a reorder.
+ *
+ * @param live Keys of the cards that exist now
+ * @param wanted Keys of the configured cards, in display order
+ */
+template <typename Key>
+CardReconcilePlan planCardReconcile(const std::vector<Key>& live, const std::vector<Key>& wanted) {
+    CardReconcilePlan plan;
+    plan.reuse.assign(wanted.size(), CardReconcilePlan::CREATE);
+    plan.kept.assign(live.size(), false);
+
+    for (size_t i = 0; i < wanted.size(); i++) {
+        for (size_t j = 0; j < live.size(); j++) {
+            if (!plan.kept[j] && live[j] == wanted[i]) {
+                plan.kept[j] = true;
+                plan.reuse[i] = j;
+                break;
+            }
+        }
+        if (plan.reuse[i] == CardReconcilePlan::CREATE) {
+            plan.created++;
+        }
+    }
+
+    for (size_t j = 0; j < live.size(); j++) {
+        if (!plan.kept[j]) {
+            plan.removed++;
+        }
+    }
+    return plan;
+}
@@ -50,6 +50,19 @@ void FlappyHogCard::prepareForRemoval() {
     // We just need to ensure we don't try to delete it again
 }
 
+void FlappyHogCard::materialize() {
+    if (!game || game->has_objects() || !lv_obj_is_valid(cardContainer)) {
+        return;
+    }
+    game->setup(lv_obj_get_parent(cardContainer));
+}
+
+void FlappyHogCard::dematerialize() {
+    if (game && !markedForRemoval) {
+        game->release_objects();
+    }
+}
+
 bool FlappyHogCard::update() {
     if (game) {
         game->loop();
@@ -53,6 +53,27 @@ public:
      */
     bool update() override;
 
+    /**
+     * @brief The game loop runs in update(), so tick every frame
+     */
+    bool needsPerFrameUpdate() const override { return true; }
+
+    /**
+     * @brief Scrolling pipes need a steady game frame rate
+     */
+    uint8_t desiredFrameRate() const override { return 33; }
+
+    /**
+     * @brief Rebuild the bird, pipes and labels; the game restarts at the start screen
+     */
+    void materialize() override;
+
+    /**
+     * @brief Delete the game objects, keeping only the background container
+     */
+    void dematerialize() override;
+    bool isMaterialized() const override { return game && game->has_objects(); }
+
 private:
     FlappyBirdGame* game;           ///< The actual game instance
     lv_obj_t* cardContainer;        ///< LVGL container for the game
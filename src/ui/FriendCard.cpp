@@ -24,6 +24,27 @@ FriendCard::FriendCard(lv_obj_t* parent)
     lv_obj_set_style_pad_all(_card, 5, 0);
     lv_obj_set_style_margin_all(_card, 0, 0);
     
+    createContent();
+    
+    // Add default message
+    addMessage("YOUR CHOICES ARE ADEQUATE");
+    addMessage("I APPROVE OF YOU AS A PERSON");
+    addMessage("YOU MEET MY EXPECTATIONS");
+    addMessage("YOUR PRODUCT IS GOOD");
+    addMessage("I ACCEPT YOUR LIMITATIONS");
+    addMessage("YOUR DREAM IS ATTAINABLE");
+    addMessage("YOU WILL DO THINGS");
+
+    // Display the first message
+    if (!_messages.empty()) {
+        setText(_messages[0].c_str());
+    }
+    
+    // Start animation automatically
+    startAnimation();
+}
+
+void FriendCard::createContent() {
     // Create green container with rounded corners
     _background = lv_obj_create(_card);
     if (!_background) return;
@@ -59,25 +80,31 @@ FriendCard::FriendCard(lv_obj_t* parent)
     
     // Create main label (white, no shadow offset)
     _label = createStyledLabel(_background, lv_color_white(), -1, 0);
-    
-    // Add default message
-    addMessage("YOUR CHOICES ARE ADEQUATE");
-    addMessage("I APPROVE OF YOU AS A PERSON");
-    addMessage("YOU MEET MY EXPECTATIONS");
-    addMessage("YOUR PRODUCT IS GOOD");
-    addMessage("I ACCEPT YOUR LIMITATIONS");
-    addMessage("YOUR DREAM IS ATTAINABLE");
-    addMessage("YOU WILL DO THINGS");
+}
 
-    // Display the first message
-    if (!_messages.empty()) {
-        setText(_messages[0].c_str());
+void FriendCard::materialize() {
+    if (!_background && isValidObject(_card)) {
+        createContent();
+        if (!_messages.empty()) {
+            setText(_messages[_current_message_index].c_str());
+        }
     }
-    
-    // Start animation automatically
     startAnimation();
 }
 
+void FriendCard::dematerialize() {
+    stopAnimation();
+    
+    // Deleting the background also deletes the sprite and both labels
+    if (isValidObject(_background)) {
+        lv_obj_delete(_background);
+    }
+    _background = nullptr;
+    _anim_img = nullptr;
+    _label = nullptr;
+    _label_shadow = nullptr;
+}
+
 lv_obj_t* FriendCard::createStyledLabel(lv_obj_t* parent, lv_color_t color, int16_t x_offset, int16_t y_offset) {
     lv_obj_t* label = lv_label_create(parent);
     if (!label) return nullptr;
@@ -131,8 +158,10 @@ void FriendCard::stopAnimation() {
     // Do nothing if animation is not running
     if (!_animation_running) return;
     
-    // We could pause the animation here if lv_animimg had a pause function
-    // For now, just mark it as not running
+    // Remove the running animation so its timer stops invalidating the card
+    if (isValidObject(_anim_img)) {
+        lv_animimg_delete(_anim_img);
+    }
     _animation_running = false;
 }
 
@@ -52,7 +52,7 @@ public:
     /**
      * @brief Stop the sprite animation
      * 
-     * Currently only marks animation as stopped (no pause functionality).
+     * Deletes the running animation; startAnimation() restarts it from the first frame.
      */
     void stopAnimation();
     
@@ -90,6 +90,19 @@ public:
      */
     bool handleButtonPress(uint8_t button_index) override;
     void prepareForRemoval() override { _card = nullptr; }
+
+    /**
+     * @brief Rebuild the sprite and labels and resume the walking animation
+     */
+    void materialize() override;
+
+    /**
+     * @brief Stop the animation and delete everything but the black card
+     * 
+     * The current message is kept and shown again when rebuilt.
+     */
+    void dematerialize() override;
+    bool isMaterialized() const override { return _background != nullptr; }
     
 private:
     // Animation timing
@@ -103,6 +116,11 @@ private:
      */
     bool isValidObject(lv_obj_t* obj) const;
     
+    /**
+     * @brief Create the green background, sprite and labels inside _card
+     */
+    void createContent();
+    
     /**
      * @brief Create a text label with consistent styling
      * 
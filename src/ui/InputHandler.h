@@ -36,4 +36,45 @@ public:
      * @return true if the card needs continuous updates, false to stop updates
      */
     virtual bool update() { return false; }
+
+    /**
+     * @brief Whether update() should be called every frame while active
+     * 
+     * Only cards that animate or run game logic in update() should return
+     * true; static cards are then never ticked.
+     */
+    virtual bool needsPerFrameUpdate() const { return false; }
+
+    /**
+     * @brief Refresh rate the card wants while it is on screen, in frames per second
+     * 
+     * 0 means on demand: LVGL redraws only what was invalidated, and running
+     * animations raise the rate to LVGL_ANIMATION_FPS while they last.
+     */
+    virtual uint8_t desiredFrameRate() const { return 0; }
+
+    /**
+     * @brief Rebuild the card's LVGL content when it enters the live window
+     * 
+     * CardNavigationStack keeps only the current card and its neighbours
+     * materialized. Called on the LVGL thread; must be idempotent.
+     */
+    virtual void materialize() {}
+
+    /**
+     * @brief Release heavy LVGL content when the card leaves the live window
+     * 
+     * The card's root object must stay alive since it holds the card's place
+     * in the stack; only its children may be deleted or paused. Cards that
+     * cannot rebuild their content keep the default no-op. Called on the
+     * LVGL thread; must be idempotent.
+     */
+    virtual void dematerialize() {}
+
+    /**
+     * @brief Whether the card's LVGL content is currently live
+     * 
+     * Cards that do not support dematerializing are always live.
+     */
+    virtual bool isMaterialized() const { return true; }
 }; 
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "renderers/NumericCardRenderer.h"
 #include "renderers/LineGraphRenderer.h"
+#include "renderers/AreaChartRenderer.h"
 #include "renderers/FunnelRenderer.h"
 #include "hardware/Input.h"
 
@@ -18,7 +19,8 @@ InsightCard::InsightCard(lv_obj_t* parent, ConfigManager& config, EventQueue& ev
     , _title_label(nullptr)
     , _content_container(nullptr)
     , _active_renderer(nullptr)
-    , _current_type(InsightParser::InsightType::INSIGHT_NOT_SUPPORTED) {
+    , _current_type(InsightParser::InsightType::INSIGHT_NOT_SUPPORTED)
+    , _materialized(true) {
     
     // NOTE: UI queue is now initialized by CardController
 
@@ -78,13 +80,18 @@ InsightCard::InsightCard(lv_obj_t* parent, ConfigManager& config, EventQueue& ev
 
 InsightCard::~InsightCard() {
     Serial.printf("[InsightCard-%s] DESTRUCTOR called\n", _insight_id.c_str());
+    // Pending keyed updates capture `this`
+    if (globalUICancel) {
+        globalUICancel(this);
+    }
     std::shared_ptr<InsightRendererBase> renderer_for_lambda = std::move(_active_renderer);
-    if (globalUIDispatch) {
-        globalUIDispatch([card_obj = _card, renderer = renderer_for_lambda]() mutable {
+    if (globalUISubmit) {
+        // The chart may still point into the model until its elements are cleared
+        dispatchUICallback([card_obj = _card, renderer = renderer_for_lambda, data = _data]() mutable {
             if (renderer) {
                 renderer->clearElements();
             }
-            if (card_obj && lv_obj_is_valid(card_obj)) {
+            if (card_obj.isValid()) {
                 lv_obj_del_async(card_obj);
             }
         }, true);
@@ -108,25 +115,26 @@ void InsightCard::onEvent(const Event& event) {
 void InsightCard::handleParsedData(std::shared_ptr<InsightParser> parser) {
     if (!parser || !parser->isValid()) {
         Serial.printf("[InsightCard-%s] Invalid data or parse error.\n", _insight_id.c_str());
-        if (globalUIDispatch) {
-            globalUIDispatch([this]() {
+        if (globalUISubmit) {
+            dispatchKeyedUICallback(UIUpdateKey(this, UI_UPDATE_DATA), [this]() {
                 if(isValidObject(_title_label)) lv_label_set_text(_title_label, "Data Error");
                 if (_active_renderer) {
                     _active_renderer->clearElements();
                     _active_renderer.reset();
                 }
+                _data.reset();
                 _current_type = InsightParser::InsightType::INSIGHT_NOT_SUPPORTED;
             }, true);
         }
         return;
     }
 
-    InsightParser::InsightType new_insight_type = parser->getInsightType();
-    char title_buffer[64];
-    if (!parser->getName(title_buffer, sizeof(title_buffer))) {
-        strcpy(title_buffer, "Insight");
-    }
-    String new_title(title_buffer);
+    // Extract the display model here, on the event task, so series are reduced
+    // off the UI task and the parser (with its JSON document) is freed once
+    // the event has been handled instead of living as long as the card
+    std::shared_ptr<InsightData> data = std::make_shared<InsightData>();
+    data->extract(*parser);
+    String new_title(data->title);
 
     // Only dispatch title update event if the title has actually changed
     if (_current_title != new_title) {
@@ -135,78 +143,114 @@ void InsightCard::handleParsedData(std::shared_ptr<InsightParser> parser) {
         Serial.printf("[InsightCard-%s] Title updated to: %s\n", _insight_id.c_str(), new_title.c_str());
     }
 
-    if (globalUIDispatch) {
-        globalUIDispatch([this, new_insight_type, new_title, parser, id = _insight_id]() mutable {
-        if (isValidObject(_title_label)) {
-            lv_label_set_text(_title_label, new_title.c_str());
-        }
-
-        bool needs_rebuild = false;
-        if (new_insight_type != _current_type || !_active_renderer) {
-            needs_rebuild = true;
-        } else if (_active_renderer && !_active_renderer->areElementsValid()) {
-            Serial.printf("[InsightCard-%s] Active renderer elements are invalid. Rebuilding.\n", id.c_str());
-            needs_rebuild = true;
-        }
+    if (globalUISubmit) {
+        std::shared_ptr<const InsightData> model = std::move(data);
+        dispatchKeyedUICallback(UIUpdateKey(this, UI_UPDATE_DATA), [this, model]() {
+            if (isValidObject(_title_label)) {
+                lv_label_set_text(_title_label, model->title);
+            }
 
-        if (needs_rebuild) {
-            Serial.printf("[InsightCard-%s] Rebuilding renderer START. Old type: %d, New type: %d. Core: %d, Card: %p, Container: %p\n", 
-                id.c_str(), (int)_current_type, (int)new_insight_type, xPortGetCoreID(), _card, _content_container);
+            // Keep the model so the card can be rebuilt after leaving the live window
+            _data = model;
 
-            if (_active_renderer) {
-                _active_renderer->clearElements();
-                _active_renderer.reset();
-            }
-            clearContentContainer();
-            _current_type = new_insight_type;
-
-            switch (new_insight_type) {
-                case InsightParser::InsightType::NUMERIC_CARD:
-                    _active_renderer = std::make_unique<NumericCardRenderer>();
-                    break;
-                case InsightParser::InsightType::LINE_GRAPH:
-                    _active_renderer = std::make_unique<LineGraphRenderer>();
-                    break;
-                case InsightParser::InsightType::FUNNEL:
-                    _active_renderer = std::make_unique<FunnelRenderer>();
-                    break;
-                default:
-                    Serial.printf("[InsightCard-%s] Unsupported insight type %d. Using Numeric as fallback.\n", 
-                        id.c_str(), (int)new_insight_type);
-                    _active_renderer = std::make_unique<NumericCardRenderer>(); 
-                    break;
+            if (_materialized) {
+                applyParsedData(*model);
             }
+        }, true);
+    }
+}
 
-            if (_active_renderer) {
-                _active_renderer->createElements(_content_container);
-                if (isValidObject(_content_container)) {
-                    lv_obj_invalidate(_content_container);
-                }
-                lv_display_t* disp = lv_display_get_default();
-                if (disp) {
-                    lv_refr_now(disp);
-                }
-            } else {
-                Serial.printf("[InsightCard-%s] CRITICAL: Failed to create a renderer!\n", id.c_str());
-            }
-        }
+void InsightCard::applyParsedData(const InsightData& data) {
+    InsightParser::InsightType new_insight_type = data.type;
+    const String& id = _insight_id;
+
+    bool needs_rebuild = false;
+    if (new_insight_type != _current_type || !_active_renderer) {
+        needs_rebuild = true;
+    } else if (_active_renderer && !_active_renderer->areElementsValid()) {
+        Serial.printf("[InsightCard-%s] Active renderer elements are invalid. Rebuilding.\n", id.c_str());
+        needs_rebuild = true;
+    }
+
+    if (needs_rebuild) {
+        uint32_t rebuild_start_us = micros();
+        Serial.printf("[InsightCard-%s] Rebuilding renderer START. Old type: %d, New type: %d. Core: %d, Card: %p, Container: %p\n", 
+            id.c_str(), (int)_current_type, (int)new_insight_type, xPortGetCoreID(), _card.get(), _content_container.get());
 
         if (_active_renderer) {
-            char prefix_buffer[16] = "";
-            char suffix_buffer[16] = "";
+            _active_renderer->clearElements();
+            _active_renderer.reset();
+        }
+        clearContentContainer();
+        _current_type = new_insight_type;
 
-            if (new_insight_type == InsightParser::InsightType::NUMERIC_CARD && parser) {
-                parser->getNumericFormattingPrefix(prefix_buffer, sizeof(prefix_buffer));
-                parser->getNumericFormattingSuffix(suffix_buffer, sizeof(suffix_buffer));
+        switch (new_insight_type) {
+            case InsightParser::InsightType::NUMERIC_CARD:
+                _active_renderer = std::make_unique<NumericCardRenderer>();
+                break;
+            case InsightParser::InsightType::LINE_GRAPH:
+                _active_renderer = std::make_unique<LineGraphRenderer>();
+                break;
+            case InsightParser::InsightType::AREA_CHART:
+                _active_renderer = std::make_unique<AreaChartRenderer>();
+                break;
+            case InsightParser::InsightType::FUNNEL:
+                _active_renderer = std::make_unique<FunnelRenderer>();
+                break;
+            default:
+                Serial.printf("[InsightCard-%s] Unsupported insight type %d. Using Numeric as fallback.\n", 
+                    id.c_str(), (int)new_insight_type);
+                _active_renderer = std::make_unique<NumericCardRenderer>(); 
+                break;
+        }
+
+        if (_active_renderer) {
+            _active_renderer->createElements(_content_container);
+            if (isValidObject(_content_container)) {
+                // Resolve sizes and positions for updateDisplay() without rendering;
+                // the new elements are drawn with everything else in the next frame
+                lv_obj_update_layout(_content_container);
+                lv_obj_invalidate(_content_container);
             }
-            _active_renderer->updateDisplay(*parser, new_title, prefix_buffer, suffix_buffer);
-        } else if (!needs_rebuild) {
-            Serial.printf("[InsightCard-%s] No active renderer to update and no rebuild was triggered. Type: %d\n",
-                id.c_str(), (int)_current_type);
+            Serial.printf("[InsightCard-%s] Rebuilding renderer DONE in %lu us\n",
+                id.c_str(), (unsigned long)(micros() - rebuild_start_us));
+        } else {
+            Serial.printf("[InsightCard-%s] CRITICAL: Failed to create a renderer!\n", id.c_str());
         }
+    }
 
-        }, true);
+    if (_active_renderer) {
+        _active_renderer->updateDisplay(data);
+    } else if (!needs_rebuild) {
+        Serial.printf("[InsightCard-%s] No active renderer to update and no rebuild was triggered. Type: %d\n",
+            id.c_str(), (int)_current_type);
+    }
+}
+
+void InsightCard::materialize() {
+    if (_materialized) {
+        return;
+    }
+    _materialized = true;
+
+    if (_data) {
+        applyParsedData(*_data);
+    }
+}
+
+void InsightCard::dematerialize() {
+    if (!_materialized) {
+        return;
+    }
+    _materialized = false;
+
+    // Drop the renderer and its object tree; the title label and _data stay
+    if (_active_renderer) {
+        _active_renderer->clearElements();
+        _active_renderer.reset();
     }
+    clearContentContainer();
+    _current_type = InsightParser::InsightType::INSIGHT_NOT_SUPPORTED;
 }
 
 void InsightCard::clearContentContainer() {
@@ -215,8 +259,8 @@ void InsightCard::clearContentContainer() {
     }
 }
 
-bool InsightCard::isValidObject(lv_obj_t* obj) const {
-    return obj && lv_obj_is_valid(obj);
+bool InsightCard::isValidObject(const LvObjHandle& obj) const {
+    return obj.isValid();
 }
 
 bool InsightCard::handleButtonPress(uint8_t button_index) {
@@ -229,8 +273,8 @@ bool InsightCard::handleButtonPress(uint8_t button_index) {
         _event_queue.publishEvent(refreshEvent);
         
         // Update UI to show we're refreshing
-        if (globalUIDispatch) {
-            globalUIDispatch([this]() {
+        if (globalUISubmit) {
+            dispatchKeyedUICallback(UIUpdateKey(this, UI_UPDATE_TITLE), [this]() {
                 if (isValidObject(_title_label)) {
                     lv_label_set_text(_title_label, "Refreshing...");
                 }
@@ -7,7 +7,9 @@
 #include "ConfigManager.h"
 #include "EventQueue.h"
 #include "posthog/parsers/InsightParser.h"
+#include "InsightData.h"
 #include "UICallback.h"
+#include "LvObjHandle.h"
 #include "ui/InputHandler.h"
 
 // Forward declaration for the renderer base class
@@ -81,6 +83,22 @@ public:
     bool handleButtonPress(uint8_t button_index) override;
     void prepareForRemoval() override { _card = nullptr; }
 
+    /**
+     * @brief Rebuild the renderer from the last received data
+     * 
+     * Called on the LVGL thread when the card comes back into the live window.
+     */
+    void materialize() override;
+
+    /**
+     * @brief Delete the renderer's object tree, keeping the data model
+     * 
+     * The card container and title label stay alive so the card keeps its
+     * place in the stack; data that arrives meanwhile is stored, not rendered.
+     */
+    void dematerialize() override;
+    bool isMaterialized() const override { return _materialized; }
+
 private:
     // Constants for UI layout and limits
     static constexpr int MAX_FUNNEL_STEPS = 5;     ///< Maximum number of steps in a funnel
@@ -92,6 +110,10 @@ private:
     static constexpr int FUNNEL_LEFT_MARGIN = 0;   ///< Left margin for funnel bars
     static constexpr int FUNNEL_LABEL_HEIGHT = 20; ///< Height of funnel step labels
 
+    // Coalescing purposes for keyed UI dispatch (see UIUpdateKey)
+    static constexpr uint32_t UI_UPDATE_TITLE = 1; ///< Transient title text
+    static constexpr uint32_t UI_UPDATE_DATA = 2;  ///< Apply parsed data / error state
+
     
     /**
      * @brief Handle events from the event queue
@@ -108,10 +130,20 @@ private:
      * 
      * @param parser Shared pointer to parsed insight data
      * 
-     * Updates the card's visualization based on the insight type.
-     * Handles type changes by recreating UI elements as needed.
+     * Runs on the event task. Extracts an InsightData model and dispatches
+     * it to the UI; the card does not hold on to the parser.
      */
     void handleParsedData(std::shared_ptr<InsightParser> parser);
+
+    /**
+     * @brief Build or update the renderer for extracted data
+     * 
+     * @param data Display model of the insight
+     * 
+     * Runs on the LVGL thread. Recreates the renderer if the insight type
+     * changed or its elements are gone, then updates it with the data.
+     */
+    void applyParsedData(const InsightData& data);
     
     /**
      * @brief Clear the content container
@@ -124,13 +156,13 @@ private:
     /**
      * @brief Check if an LVGL object is valid
      * 
-     * @param obj LVGL object to check
-     * @return true if object exists and is valid
+     * @param obj Handle of the LVGL object to check
+     * @return true if object exists and has not been deleted
      * 
-     * Thread-safe method to verify LVGL object validity
+     * O(1) generation check, safe to call from any thread
      * before performing operations.
      */
-    bool isValidObject(lv_obj_t* obj) const;
+    bool isValidObject(const LvObjHandle& obj) const;
     
     // Configuration and state
     ConfigManager& _config;              ///< Configuration manager reference
@@ -140,10 +172,14 @@ private:
     InsightParser::InsightType _current_type; ///< Current visualization type
     
     // UI Elements
-    lv_obj_t* _card;                    ///< Main card container
-    lv_obj_t* _title_label;             ///< Title text label
-    lv_obj_t* _content_container;       ///< Container for visualization
+    LvObjHandle _card;                  ///< Main card container
+    LvObjHandle _title_label;           ///< Title text label
+    LvObjHandle _content_container;     ///< Container for visualization
     
     // Renderer related members
     std::unique_ptr<InsightRendererBase> _active_renderer; // Smart pointer to the current renderer
+
+    // Virtualization state, only touched on the LVGL thread
+    bool _materialized;                          ///< Renderer objects exist
+    std::shared_ptr<const InsightData> _data;    ///< Last valid data, used to rebuild; renderers may point into it
 };
\ No newline at end of file
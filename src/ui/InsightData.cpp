@@ -0,0 +1,53 @@
+#include "InsightData.h"
+#include "renderers/LineGraphRenderer.h"
+#include "renderers/AreaChartRenderer.h"
+#include <algorithm>
+#include <vector>
+
+void InsightData::extract(const InsightParser& parser) {
+    type = parser.getInsightType();
+    if (!parser.getName(title, sizeof(title))) {
+        strlcpy(title, "Insight", sizeof(title));
+    }
+
+    switch (type) {
+        case InsightParser::InsightType::NUMERIC_CARD:
+            value = parser.getNumericCardValue();
+            parser.getNumericFormattingPrefix(prefix, sizeof(prefix));
+            parser.getNumericFormattingSuffix(suffix, sizeof(suffix));
+            break;
+
+        case InsightParser::InsightType::LINE_GRAPH:
+            LineGraphRenderer::prepareSeries(parser, series);
+            break;
+
+        case InsightParser::InsightType::AREA_CHART:
+            AreaChartRenderer::prepareSeries(parser, series);
+            break;
+
+        case InsightParser::InsightType::FUNNEL: {
+            size_t all_steps = parser.getFunnelStepCount();
+            funnelStepCount = (uint8_t)std::min(all_steps, MAX_FUNNEL_STEPS);
+            funnelBreakdownCount = (uint8_t)std::min(parser.getFunnelBreakdownCount(), MAX_BREAKDOWNS);
+
+            // The parser fills a count for every step, not just the ones shown
+            std::vector<uint32_t> totals(all_steps, 0);
+            if (all_steps > 0 && !parser.getFunnelTotalCounts(0, totals.data(), nullptr)) {
+                Serial.println("[InsightData-ERROR] Failed to get funnel total counts from parser.");
+                funnelStepCount = 0;
+                break;
+            }
+            for (size_t i = 0; i < funnelStepCount; i++) {
+                FunnelStep& step = funnelSteps[i];
+                step.total = totals[i];
+                step.name[0] = '\0';
+                parser.getFunnelStepData(0, i, step.name, sizeof(step.name), nullptr, nullptr, nullptr);
+                step.hasBreakdowns = parser.getFunnelBreakdownComparison(i, step.breakdowns, nullptr);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
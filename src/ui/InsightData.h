@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include "posthog/parsers/InsightParser.h"
+
+/**
+ * @struct InsightData
+ * @brief Compact display model of one insight
+ *
+ * Holds only what the renderers draw: type, title, the numeric value and
+ * its affixes, chart-ready series and the funnel step table. InsightCard
+ * extracts it on the event task and then lets the parser, and the JSON
+ * document behind it, go; the model is what the card keeps to rebuild
+ * its renderer after being dematerialized.
+ */
+struct InsightData {
+    static constexpr size_t TITLE_LENGTH = 64;
+    static constexpr size_t AFFIX_LENGTH = 16;
+    static constexpr size_t MAX_FUNNEL_STEPS = 5;
+    static constexpr size_t MAX_BREAKDOWNS = 5;
+    static constexpr size_t STEP_NAME_LENGTH = 64;
+
+    struct FunnelStep {
+        uint32_t total;                       ///< Users reaching the step, all breakdowns
+        uint32_t breakdowns[MAX_BREAKDOWNS];  ///< Users reaching the step, per breakdown
+        bool hasBreakdowns;                   ///< breakdowns[] was filled
+        char name[STEP_NAME_LENGTH];
+    };
+
+    InsightParser::InsightType type = InsightParser::InsightType::INSIGHT_NOT_SUPPORTED;
+    char title[TITLE_LENGTH] = {};
+
+    // Numeric card
+    double value = 0.0;
+    char prefix[AFFIX_LENGTH] = {};
+    char suffix[AFFIX_LENGTH] = {};
+
+    // Line graph and area chart, scaled and decimated
+    SeriesSet series;
+
+    // Funnel
+    uint8_t funnelStepCount = 0;
+    uint8_t funnelBreakdownCount = 0;
+    FunnelStep funnelSteps[MAX_FUNNEL_STEPS] = {};
+
+    /**
+     * @brief Fill the model from a parsed insight
+     *
+     * Runs on the event task: series are scaled and decimated here so the
+     * UI task only copies them.
+     */
+    void extract(const InsightParser& parser);
+};
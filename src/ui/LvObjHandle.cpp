@@ -0,0 +1,97 @@
+#include "LvObjHandle.h"
+#include <freertos/FreeRTOS.h>
+
+namespace {
+
+struct HandleSlot {
+    lv_obj_t* obj;        ///< Tracked object, nullptr while the slot is free
+    uint32_t generation;  ///< Bumped every time the tracked object is deleted
+};
+
+HandleSlot slots[LV_OBJ_HANDLE_SLOTS];
+uint16_t nextFree[LV_OBJ_HANDLE_SLOTS];
+uint16_t freeHead = 0;
+bool slotsInitialized = false;
+
+uint32_t trackedObjects = 0;
+uint32_t fallbackHandles = 0;
+
+portMUX_TYPE slotLock = portMUX_INITIALIZER_UNLOCKED;
+
+constexpr uint16_t END_OF_LIST = 0xFFFF;
+
+} // namespace
+
+void LvObjHandle::track(lv_obj_t* obj) {
+    _obj = obj;
+    _slot = NO_SLOT;
+    _generation = 0;
+    if (!obj) {
+        return;
+    }
+
+    uint16_t slot = END_OF_LIST;
+
+    portENTER_CRITICAL(&slotLock);
+    if (!slotsInitialized) {
+        for (uint16_t i = 0; i < LV_OBJ_HANDLE_SLOTS; i++) {
+            slots[i].obj = nullptr;
+            slots[i].generation = 1;
+            nextFree[i] = (i + 1 < LV_OBJ_HANDLE_SLOTS) ? i + 1 : END_OF_LIST;
+        }
+        freeHead = 0;
+        slotsInitialized = true;
+    }
+    if (freeHead != END_OF_LIST) {
+        slot = freeHead;
+        freeHead = nextFree[slot];
+        slots[slot].obj = obj;
+        _generation = slots[slot].generation;
+        trackedObjects++;
+    } else {
+        fallbackHandles++;
+    }
+    portEXIT_CRITICAL(&slotLock);
+
+    if (slot == END_OF_LIST) {
+        // Table full: isValid() falls back to lv_obj_is_valid()
+        return;
+    }
+
+    _slot = slot;
+    lv_obj_add_event_cb(obj, deleteEventCb, LV_EVENT_DELETE, (void*)(uintptr_t)slot);
+}
+
+bool LvObjHandle::isValid() const {
+    if (!_obj) {
+        return false;
+    }
+    if (_slot == NO_SLOT) {
+        return lv_obj_is_valid(_obj);
+    }
+    // Aligned 32-bit reads are atomic, so no lock is needed for the check itself
+    return slots[_slot].generation == _generation && slots[_slot].obj == _obj;
+}
+
+void LvObjHandle::deleteEventCb(lv_event_t* e) {
+    uint16_t slot = (uint16_t)(uintptr_t)lv_event_get_user_data(e);
+    if (slot >= LV_OBJ_HANDLE_SLOTS) {
+        return;
+    }
+
+    portENTER_CRITICAL(&slotLock);
+    slots[slot].generation++;
+    slots[slot].obj = nullptr;
+    nextFree[slot] = freeHead;
+    freeHead = slot;
+    trackedObjects--;
+    portEXIT_CRITICAL(&slotLock);
+}
+
+uint32_t LvObjHandle::trackedCount() {
+    return trackedObjects;
+}
+
+uint32_t LvObjHandle::fallbackCount() {
+    return fallbackHandles;
+}
@@ -0,0 +1,78 @@
+#ifndef LV_OBJ_HANDLE_H
+#define LV_OBJ_HANDLE_H
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/**
+ * @brief Number of objects that can be tracked at once
+ *
+ * Handles beyond this fall back to lv_obj_is_valid(), which walks the
+ * whole object tree. Each slot costs 8 bytes.
+ */
+#ifndef LV_OBJ_HANDLE_SLOTS
+#define LV_OBJ_HANDLE_SLOTS 512
+#endif
+
+/**
+ * @class LvObjHandle
+ * @brief LVGL object pointer with an O(1) "still alive" check
+ *
+ * Assigning an object registers an LV_EVENT_DELETE hook that bumps the
+ * generation of the object's tracking slot when LVGL deletes it (directly
+ * or as part of a parent). A handle is valid while its slot still holds the
+ * generation it was created with, so stale pointers are detected without
+ * lv_obj_is_valid() walking every display's object tree.
+ *
+ * Handles convert implicitly to lv_obj_t* so they can be passed straight to
+ * LVGL calls. Copies share the same slot and are safe to capture in
+ * dispatched UI closures.
+ *
+ * Assignment must happen on the LVGL thread (it adds an event callback);
+ * isValid() may be called from any thread.
+ */
+class LvObjHandle {
+public:
+    LvObjHandle() : _obj(nullptr), _slot(NO_SLOT), _generation(0) {}
+    explicit LvObjHandle(lv_obj_t* obj) : LvObjHandle() { track(obj); }
+
+    LvObjHandle& operator=(lv_obj_t* obj) {
+        track(obj);
+        return *this;
+    }
+
+    operator lv_obj_t*() const { return _obj; }
+    lv_obj_t* get() const { return _obj; }
+
+    /**
+     * @brief True if the object has not been deleted since it was assigned
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Forget the object without deleting it
+     */
+    void reset() {
+        _obj = nullptr;
+        _slot = NO_SLOT;
+        _generation = 0;
+    }
+
+    /**
+     * @brief Objects currently tracked and handles that had to fall back
+     */
+    static uint32_t trackedCount();
+    static uint32_t fallbackCount();
+
+private:
+    static constexpr uint16_t NO_SLOT = 0xFFFF;
+
+    void track(lv_obj_t* obj);
+    static void deleteEventCb(lv_event_t* e);
+
+    lv_obj_t* _obj;
+    uint16_t _slot;
+    uint32_t _generation;
+};
+
+#endif // LV_OBJ_HANDLE_H
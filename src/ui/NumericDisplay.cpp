@@ -0,0 +1,195 @@
+#include "ui/NumericDisplay.h"
+#include "NumberFormat.h"
+#include <string.h>
+
+NumericDisplay::NumericDisplay()
+    : _obj(nullptr), _font(nullptr), _text{}, _prefix{}, _suffix{}, _cells{}, _cell_count(0),
+      _text_width(0), _value(0.0), _anim_from(0.0), _anim_to(0.0), _has_value(false), _last_redraw_px(0) {
+}
+
+NumericDisplay::~NumericDisplay() {
+    // The animation points at this object; never let it outlive us
+    lv_anim_delete(this, _count_anim_cb);
+}
+
+lv_obj_t* NumericDisplay::create(lv_obj_t* parent, const lv_font_t* font, lv_color_t color) {
+    _font = font;
+    _obj = lv_obj_create(parent);
+    if (!_obj) {
+        return nullptr;
+    }
+    lv_obj_remove_style_all(_obj);
+    lv_obj_set_size(_obj, lv_pct(100), lv_font_get_line_height(font));
+    lv_obj_set_style_text_color(_obj, color, 0);
+    lv_obj_clear_flag(_obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(_obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_obj, _draw_cb, LV_EVENT_DRAW_MAIN, this);
+
+    _text[0] = '\0';
+    _cell_count = 0;
+    _text_width = 0;
+    _has_value = false;
+    return _obj;
+}
+
+void NumericDisplay::destroy() {
+    lv_anim_delete(this, _count_anim_cb);
+    if (isValid()) {
+        lv_obj_del(_obj);
+    }
+    _obj.reset();
+    _text[0] = '\0';
+    _cell_count = 0;
+    _has_value = false;
+}
+
+bool NumericDisplay::isValid() const {
+    return _obj.isValid();
+}
+
+void NumericDisplay::setAffixes(const char* prefix, const char* suffix) {
+    strlcpy(_prefix, prefix ? prefix : "", sizeof(_prefix));
+    strlcpy(_suffix, suffix ? suffix : "", sizeof(_suffix));
+}
+
+void NumericDisplay::setValue(double value, bool animate) {
+    lv_anim_delete(this, _count_anim_cb);
+
+    if (NUMERIC_COUNT_UP_MS > 0 && animate && _has_value && value != _value && isValid()) {
+        _anim_from = _value;
+        _anim_to = value;
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, this);
+        lv_anim_set_exec_cb(&a, _count_anim_cb);
+        lv_anim_set_values(&a, 0, 1000);
+        lv_anim_set_time(&a, NUMERIC_COUNT_UP_MS);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+        lv_anim_start(&a);
+        return;
+    }
+
+    _value = value;
+    _has_value = true;
+    char text[TEXT_LENGTH];
+    format(value, text, sizeof(text));
+    apply(text);
+}
+
+void NumericDisplay::setText(const char* text) {
+    lv_anim_delete(this, _count_anim_cb);
+    _has_value = false;
+    apply(text ? text : "");
+}
+
+void NumericDisplay::_count_anim_cb(void* var, int32_t progress) {
+    NumericDisplay* self = static_cast<NumericDisplay*>(var);
+    double value = self->_anim_to;
+    if (progress < 1000) {
+        value = self->_anim_from + (self->_anim_to - self->_anim_from) * progress / 1000.0;
+        // Count whole numbers in whole steps rather than flashing decimals
+        if (self->_anim_from == floor(self->_anim_from) && self->_anim_to == floor(self->_anim_to)) {
+            value = round(value);
+        }
+    }
+
+    self->_value = value;
+    self->_has_value = true;
+    char text[TEXT_LENGTH];
+    self->format(value, text, sizeof(text));
+    self->apply(text);
+}
+
+void NumericDisplay::format(double value, char* text, size_t size) const {
+    size_t length = strlcpy(text, _prefix, size);
+    if (length >= size) return;
+    length += NumberFormat::formatCompact(text + length, size - length, value);
+    strlcpy(text + length, _suffix, size - length);
+}
+
+size_t NumericDisplay::layout(const char* text, Cell* cells, int32_t* width) const {
+    size_t count = 0;
+    int32_t x = 0;
+    uint32_t i = 0;
+    uint32_t letter = lv_text_encoded_next(text, &i);
+    while (letter != 0 && count < MAX_CELLS) {
+        uint32_t next = lv_text_encoded_next(text, &i);
+        int32_t advance = lv_font_get_glyph_width(_font, letter, next);
+        cells[count++] = { letter, (int16_t)x, (int16_t)advance };
+        x += advance;
+        letter = next;
+    }
+    *width = x;
+    return count;
+}
+
+void NumericDisplay::invalidateCell(int32_t origin, const Cell& cell, const lv_area_t& coords) {
+    lv_area_t area = { origin + cell.x - CELL_OVERHANG, coords.y1,
+                       origin + cell.x + cell.width - 1 + CELL_OVERHANG, coords.y2 };
+    lv_obj_invalidate_area(_obj, &area);
+    _last_redraw_px += (uint32_t)lv_area_get_size(&area);
+}
+
+void NumericDisplay::apply(const char* text) {
+    if (strcmp(text, _text) == 0) {
+        _last_redraw_px = 0;
+        return;
+    }
+
+    Cell cells[MAX_CELLS];
+    int32_t width = 0;
+    size_t count = _font ? layout(text, cells, &width) : 0;
+
+    _last_redraw_px = 0;
+    if (isValid()) {
+        lv_area_t coords;
+        lv_obj_get_coords(_obj, &coords);
+        int32_t obj_width = lv_area_get_width(&coords);
+        if (obj_width <= 1) {
+            // Not laid out yet; nothing drawn to compare against
+            lv_obj_invalidate(_obj);
+        } else {
+            // Same centring as _draw_cb; a change in total width moves every cell
+            int32_t old_origin = coords.x1 + (obj_width - _text_width) / 2;
+            int32_t new_origin = coords.x1 + (obj_width - width) / 2;
+            size_t cell_count = count > _cell_count ? count : _cell_count;
+            for (size_t i = 0; i < cell_count; i++) {
+                bool in_old = i < _cell_count;
+                bool in_new = i < count;
+                if (in_old && in_new && _cells[i].letter == cells[i].letter &&
+                    old_origin + _cells[i].x == new_origin + cells[i].x && _cells[i].width == cells[i].width) {
+                    continue;
+                }
+                if (in_old) invalidateCell(old_origin, _cells[i], coords);
+                if (in_new) invalidateCell(new_origin, cells[i], coords);
+            }
+        }
+    }
+
+    strlcpy(_text, text, sizeof(_text));
+    memcpy(_cells, cells, count * sizeof(Cell));
+    _cell_count = count;
+    _text_width = width;
+}
+
+void NumericDisplay::_draw_cb(lv_event_t* e) {
+    NumericDisplay* self = static_cast<NumericDisplay*>(lv_event_get_user_data(e));
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    lv_layer_t* layer = lv_event_get_layer(e);
+    if (self->_text[0] == '\0' || !self->_font) return;
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    int32_t origin = coords.x1 + (lv_area_get_width(&coords) - self->_text_width) / 2;
+
+    // Everything is drawn, but LVGL clips it to the invalidated cells
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = self->_font;
+    dsc.color = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+    dsc.text = self->_text;
+    dsc.flag = LV_TEXT_FLAG_EXPAND;
+    lv_area_t area = { origin, coords.y1, origin + self->_text_width, coords.y2 };
+    lv_draw_label(layer, &dsc, &area);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <lvgl.h>
+#include "ui/LvObjHandle.h"
+
+// Count-up animation length when a shown value changes; 0 jumps straight to it
+#ifndef NUMERIC_COUNT_UP_MS
+#define NUMERIC_COUNT_UP_MS 0
+#endif
+
+/**
+ * @class NumericDisplay
+ * @brief Single-line number readout that redraws only the characters that change
+ *
+ * The value is formatted with NumberFormat::formatCompact() into a fixed
+ * buffer between an optional prefix and suffix, then drawn centred by one
+ * object's draw handler. Each update lays the text out as glyph cells and
+ * invalidates only cells whose character or position changed, so a ticking
+ * counter repaints a digit or two instead of the whole label. An optional
+ * count-up animation runs on a single lv_anim.
+ */
+class NumericDisplay {
+public:
+    NumericDisplay();
+    ~NumericDisplay();
+
+    /**
+     * @brief Create the object, full width and one line of font tall
+     */
+    lv_obj_t* create(lv_obj_t* parent, const lv_font_t* font, lv_color_t color);
+
+    /**
+     * @brief Delete the object and stop any animation
+     */
+    void destroy();
+
+    bool isValid() const;
+    lv_obj_t* getObject() const { return _obj; }
+
+    /**
+     * @brief Set text shown around the number; takes effect on the next setValue()
+     */
+    void setAffixes(const char* prefix, const char* suffix);
+
+    /**
+     * @brief Show a value
+     *
+     * @param animate Count up from the value shown now, if NUMERIC_COUNT_UP_MS is set
+     */
+    void setValue(double value, bool animate = true);
+
+    /**
+     * @brief Show fixed text, such as a placeholder
+     */
+    void setText(const char* text);
+
+    /**
+     * @brief Pixels invalidated by the last text change, for profiling
+     */
+    uint32_t lastRedrawPixels() const { return _last_redraw_px; }
+
+private:
+    static constexpr size_t TEXT_LENGTH = 48;
+    static constexpr size_t AFFIX_LENGTH = 16;
+    static constexpr size_t MAX_CELLS = TEXT_LENGTH;
+    static constexpr int32_t CELL_OVERHANG = 2;  // Glyphs may ink a little past their advance
+
+    struct Cell {
+        uint32_t letter;
+        int16_t x;       // From the start of the text
+        int16_t width;   // Advance, including kerning against the next letter
+    };
+
+    static void _draw_cb(lv_event_t* e);
+    static void _count_anim_cb(void* var, int32_t value);
+
+    // Format value with the affixes into text
+    void format(double value, char* text, size_t size) const;
+    // Lay out text into cells; returns the cell count
+    size_t layout(const char* text, Cell* cells, int32_t* width) const;
+    // Replace the shown text, invalidating only changed cells
+    void apply(const char* text);
+    void invalidateCell(int32_t origin, const Cell& cell, const lv_area_t& coords);
+
+    LvObjHandle _obj;
+    const lv_font_t* _font;
+    char _text[TEXT_LENGTH];          ///< Text currently drawn
+    char _prefix[AFFIX_LENGTH];
+    char _suffix[AFFIX_LENGTH];
+    Cell _cells[MAX_CELLS];
+    size_t _cell_count;
+    int32_t _text_width;
+    double _value;                    ///< Value currently shown
+    double _anim_from;
+    double _anim_to;
+    bool _has_value;
+    uint32_t _last_redraw_px;
+};
@@ -57,6 +57,10 @@ void PaddleCard::createUi(lv_obj_t* parent) {
     lv_obj_set_style_bg_color(_card_root_obj, lv_color_black(), 0);
     lv_obj_set_style_pad_all(_card_root_obj, 0, 0); 
 
+    createGameObjects();
+}
+
+void PaddleCard::createGameObjects() {
     _player_paddle_obj = lv_obj_create(_card_root_obj);
     lv_obj_set_size(_player_paddle_obj, PADDLE_WIDTH, PADDLE_HEIGHT); // Uses PaddleCard constants for UI size
     lv_obj_set_style_bg_color(_player_paddle_obj, lv_color_white(), 0);
@@ -91,10 +95,34 @@ void PaddleCard::createUi(lv_obj_t* parent) {
     lv_obj_set_width(_message_label_obj, lv_pct(80)); 
 }
 
+void PaddleCard::materialize() {
+    if (_player_paddle_obj || !lv_obj_is_valid(_card_root_obj)) return;
+    createGameObjects();
+    updateUi();
+}
+
+void PaddleCard::dematerialize() {
+    if (!_player_paddle_obj) return;
+
+    // A rally can't continue off screen
+    if (_paddle_game_instance.getState() == PaddleGame::GameState::Playing) {
+        _paddle_game_instance.setState(PaddleGame::GameState::Paused);
+        _paddle_game_instance.movePlayerPaddle(true, false);
+        _paddle_game_instance.movePlayerPaddle(false, false);
+    }
+
+    if (lv_obj_is_valid(_card_root_obj)) {
+        lv_obj_clean(_card_root_obj);
+    }
+    _player_paddle_obj = nullptr;
+    _ai_paddle_obj = nullptr;
+    _ball_obj = nullptr;
+    _player_score_label_obj = nullptr;
+    _ai_score_label_obj = nullptr;
+    _message_label_obj = nullptr;
+}
+
 bool PaddleCard::update() {
-    Bounce2::Button& center_button = buttons[Input::BUTTON_CENTER];
-    Bounce2::Button& up_button = buttons[Input::BUTTON_UP];
-    Bounce2::Button& down_button = buttons[Input::BUTTON_DOWN];
     PaddleGame::GameState current_game_state = _paddle_game_instance.getState();
 
     // --- State Transition Logic for Victory Message ---
@@ -113,7 +141,7 @@ bool PaddleCard::update() {
     }
 
     // --- Center button press logic based on current state ---
-    if (center_button.pressed()) {
+    if (Input::wasPressed(Input::BUTTON_CENTER)) {
         if (current_game_state == PaddleGame::GameState::StartScreen || current_game_state == PaddleGame::GameState::GameOver) {
             _paddle_game_instance.reset(); // This now sets the game to ServeDelay internally
             // Player paddle should be reset to non-moving state immediately
@@ -135,20 +163,20 @@ bool PaddleCard::update() {
 
     // Paddle movement input only if Playing
     if (current_game_state == PaddleGame::GameState::Playing) {
-        if (down_button.isPressed()) {
+        if (Input::isHeld(Input::BUTTON_DOWN)) {
             _paddle_game_instance.movePlayerPaddle(false, true);
-        } else if (down_button.released()) {
+        } else if (Input::wasReleased(Input::BUTTON_DOWN)) {
             _paddle_game_instance.movePlayerPaddle(false, false);
         }
 
-        if (up_button.isPressed()) {
+        if (Input::isHeld(Input::BUTTON_UP)) {
             _paddle_game_instance.movePlayerPaddle(true, true);
-        } else if (up_button.released()) {
+        } else if (Input::wasReleased(Input::BUTTON_UP)) {
             _paddle_game_instance.movePlayerPaddle(true, false);
         }
 
         // Check for all three buttons for GameOver (from Playing state)
-        if (up_button.isPressed() && down_button.isPressed() && center_button.isPressed()) {
+        if (Input::isHeld(Input::BUTTON_UP) && Input::isHeld(Input::BUTTON_DOWN) && Input::isHeld(Input::BUTTON_CENTER)) {
             _paddle_game_instance.setState(PaddleGame::GameState::GameOver);
             _paddle_game_instance.movePlayerPaddle(true, false); // Stop player paddle
             _paddle_game_instance.movePlayerPaddle(false, false);
@@ -12,12 +12,18 @@ public:
     ~PaddleCard() override; // Marking as override
 
     bool update() override; // Returns true to keep receiving updates
+    bool needsPerFrameUpdate() const override { return true; }
+    uint8_t desiredFrameRate() const override { return 33; }
     bool handleButtonPress(uint8_t button_index) override;
     lv_obj_t* getCard() const; // Matches main's architecture
     void prepareForRemoval() override { markedForRemoval = true; } // Prevent double deletion
+    void materialize() override; // Recreate paddles, ball and labels
+    void dematerialize() override; // Pause the game and delete everything but the root
+    bool isMaterialized() const override { return _player_paddle_obj != nullptr; }
 
 private:
     void createUi(lv_obj_t* parent);
+    void createGameObjects(); // Children of _card_root_obj, rebuilt on materialize
     void updateUi(); // Replaces drawGameElements, more general for UI updates
     void updateMessageLabel(); // For displaying game state text
 
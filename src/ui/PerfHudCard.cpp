@@ -0,0 +1,135 @@
+#include "ui/PerfHudCard.h"
+#include "ui/CardController.h"
+#include "PerfSampler.h"
+#include "Style.h"
+#include <esp_heap_caps.h>
+#include <string.h>
+
+PerfHudCard::PerfHudCard(lv_obj_t* parent, EventQueue& eventQueue)
+    : _event_queue(eventQueue), _card(nullptr), _rows{}, _row_text{}, _timer(nullptr), _materialized(false) {
+    _card = lv_obj_create(parent);
+    if (!_card) return;
+
+    lv_obj_set_size(_card, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(_card, lv_color_black(), 0);
+    lv_obj_set_style_border_width(_card, 0, 0);
+    lv_obj_set_style_pad_all(_card, 4, 0);
+    lv_obj_clear_flag(_card, LV_OBJ_FLAG_SCROLLABLE);
+
+    // One label per row at a fixed position: no layout pass when text changes
+    const int32_t line_height = lv_font_get_line_height(Style::labelFont());
+    for (size_t i = 0; i < ROW_COUNT; i++) {
+        _rows[i] = lv_label_create(_card);
+        lv_obj_set_style_text_font(_rows[i], Style::labelFont(), 0);
+        lv_obj_set_style_text_color(_rows[i], i < FIXED_ROWS ? Style::valueColor() : Style::labelColor(), 0);
+        lv_obj_set_pos(_rows[i], 0, i * line_height);
+        lv_label_set_text_static(_rows[i], _row_text[i]);
+    }
+
+    _timer = lv_timer_create(refreshTimerCb, REFRESH_INTERVAL_MS, this);
+    lv_timer_pause(_timer);
+}
+
+PerfHudCard::~PerfHudCard() {
+    if (_timer) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    if (_card) {
+        lv_obj_del_async(_card);
+        _card = nullptr;
+    }
+}
+
+void PerfHudCard::prepareForRemoval() {
+    if (_timer) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    _card = nullptr;
+}
+
+bool PerfHudCard::handleButtonPress(uint8_t button_index) {
+    return false;  // Read-only; let CardNavigationStack handle navigation
+}
+
+void PerfHudCard::materialize() {
+    if (_materialized || !_timer) return;
+    _materialized = true;
+    // Prime the samplers so the first readout covers a full interval
+    PerfSampler::sampleFrames();
+    PerfSampler::sampleCpu();
+    lv_timer_reset(_timer);
+    lv_timer_resume(_timer);
+}
+
+void PerfHudCard::dematerialize() {
+    if (!_materialized) return;
+    _materialized = false;
+    if (_timer) {
+        lv_timer_pause(_timer);
+    }
+}
+
+void PerfHudCard::refreshTimerCb(lv_timer_t* timer) {
+    static_cast<PerfHudCard*>(lv_timer_get_user_data(timer))->refresh();
+}
+
+void PerfHudCard::setRow(size_t row, const char* text) {
+    if (strcmp(_row_text[row], text) == 0) return;
+    strlcpy(_row_text[row], text, ROW_LENGTH);
+    // Static text: LVGL keeps the pointer, we only need to trigger a redraw
+    lv_label_set_text_static(_rows[row], _row_text[row]);
+}
+
+void PerfHudCard::refresh() {
+    if (!_card) return;
+
+    char text[ROW_LENGTH];
+
+    PerfSampler::FrameStats frames = PerfSampler::sampleFrames();
+    snprintf(text, sizeof(text), "FPS %.1f  %lu/%lu ms",
+             frames.fps,
+             (unsigned long)(frames.avgFrameUs / 1000),
+             (unsigned long)(frames.maxFrameUs / 1000));
+    setRow(0, text);
+
+    snprintf(text, sizeof(text), "SRAM %luk  blk %luk",
+             (unsigned long)(heap_caps_get_free_size(MALLOC_CAP_INTERNAL) / 1024),
+             (unsigned long)(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL) / 1024));
+    setRow(1, text);
+
+    snprintf(text, sizeof(text), "PSRAM %luk  blk %luk",
+             (unsigned long)(heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024),
+             (unsigned long)(heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM) / 1024));
+    setRow(2, text);
+
+    snprintf(text, sizeof(text), "Queue ev %u  ui %u",
+             (unsigned)_event_queue.getQueueDepth(),
+             (unsigned)CardController::getUIQueueDepth());
+    setRow(3, text);
+
+    PerfSampler::CpuStats cpu = PerfSampler::sampleCpu();
+    if (cpu.available) {
+        snprintf(text, sizeof(text), "CPU %u%% %u%%  UI %u%%",
+                 cpu.coreLoad[0], cpu.coreLoad[1], cpu.lvglShare);
+    } else {
+        strlcpy(text, "CPU n/a", sizeof(text));
+    }
+    setRow(4, text);
+
+    size_t gauge_count = PerfSampler::gaugeCount();
+    for (size_t i = 0; i < GAUGE_ROWS; i++) {
+        const char* name;
+        const char* unit;
+        int32_t value;
+        if (i < gauge_count && PerfSampler::readGauge(i, name, unit, value)) {
+            snprintf(text, sizeof(text), "%s %ld %s", name, (long)value, unit);
+        } else if (i < gauge_count) {
+            snprintf(text, sizeof(text), "%s --", name);
+        } else {
+            text[0] = '\0';
+        }
+        setRow(FIXED_ROWS + i, text);
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <lvgl.h>
+#include "ui/InputHandler.h"
+#include "EventQueue.h"
+
+/**
+ * @class PerfHudCard
+ * @brief Live runtime health readout
+ *
+ * Shows frame rate and frame time, internal and PSRAM heap, queue depths,
+ * CPU share and any gauges registered with PerfSampler. All labels are
+ * created up front and refreshed once a second from static text buffers;
+ * a label is only touched when its text changes, so the HUD itself costs
+ * almost nothing to draw. The refresh timer is paused while the card is
+ * outside the navigation window.
+ */
+class PerfHudCard : public InputHandler {
+public:
+    PerfHudCard(lv_obj_t* parent, EventQueue& eventQueue);
+    ~PerfHudCard();
+
+    lv_obj_t* getCard() const { return _card; }
+
+    bool handleButtonPress(uint8_t button_index) override;
+    void prepareForRemoval() override;
+
+    void materialize() override;
+    void dematerialize() override;
+    bool isMaterialized() const override { return _materialized; }
+
+private:
+    static constexpr uint32_t REFRESH_INTERVAL_MS = 1000;
+    static constexpr size_t FIXED_ROWS = 5;
+    static constexpr size_t GAUGE_ROWS = 2;
+    static constexpr size_t ROW_COUNT = FIXED_ROWS + GAUGE_ROWS;
+    static constexpr size_t ROW_LENGTH = 40;
+
+    static void refreshTimerCb(lv_timer_t* timer);
+    void refresh();
+    void setRow(size_t row, const char* text);
+
+    EventQueue& _event_queue;
+    lv_obj_t* _card;
+    lv_obj_t* _rows[ROW_COUNT];
+    char _row_text[ROW_COUNT][ROW_LENGTH];  ///< Text currently shown, referenced by the labels
+    lv_timer_t* _timer;
+    bool _materialized;
+};
@@ -0,0 +1,233 @@
+#include "RenderProfiler.h"
+
+#if RENDER_PROFILER
+
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint8_t NO_CARD = 0xFF;
+
+struct CardSlot {
+    const void* card;
+    RenderProfiler::CardStats stats;
+};
+
+CardSlot cards[RenderProfiler::MAX_CARDS];
+uint8_t activeCard = NO_CARD;
+
+RenderProfiler::FrameRecord frameLog[RenderProfiler::FRAME_LOG_SIZE];
+size_t frameLogHead = 0;
+size_t frameLogCount = 0;
+
+// Frame being rendered
+uint32_t frameStartUs = 0;
+uint16_t pendingAreas = 0;
+uint32_t framePixels = 0;
+uint32_t frameFlushUs = 0;
+bool inFrame = false;
+
+uint32_t totalFrames = 0;
+uint32_t lastDumpMs = 0;
+
+portMUX_TYPE profilerLock = portMUX_INITIALIZER_UNLOCKED;
+
+uint8_t findSlot(const void* card) {
+    for (uint8_t i = 0; i < RenderProfiler::MAX_CARDS; i++) {
+        if (cards[i].card == card) {
+            return i;
+        }
+    }
+    return NO_CARD;
+}
+
+} // namespace
+
+void RenderProfiler::attach(lv_display_t* display) {
+    lv_display_add_event_cb(display, eventCb, LV_EVENT_INVALIDATE_AREA, nullptr);
+    lv_display_add_event_cb(display, eventCb, LV_EVENT_RENDER_START, nullptr);
+    lv_display_add_event_cb(display, eventCb, LV_EVENT_RENDER_READY, nullptr);
+    lastDumpMs = millis();
+    Serial.println("[RenderProfiler] Attached to display");
+}
+
+void RenderProfiler::setActiveCard(const void* card, const char* label) {
+    portENTER_CRITICAL(&profilerLock);
+    uint8_t slot = findSlot(card);
+    if (slot == NO_CARD) {
+        slot = findSlot(nullptr);
+        if (slot != NO_CARD) {
+            cards[slot].card = card;
+            memset(&cards[slot].stats, 0, sizeof(CardStats));
+            strlcpy(cards[slot].stats.label, label ? label : "?", LABEL_LENGTH);
+        }
+    }
+    activeCard = slot;
+    portEXIT_CRITICAL(&profilerLock);
+}
+
+void RenderProfiler::forgetCard(const void* card) {
+    portENTER_CRITICAL(&profilerLock);
+    uint8_t slot = findSlot(card);
+    if (slot != NO_CARD) {
+        cards[slot].card = nullptr;
+        if (activeCard == slot) {
+            activeCard = NO_CARD;
+        }
+        // Frames in the log still name the slot; drop them so it can be reused
+        frameLogCount = 0;
+    }
+    portEXIT_CRITICAL(&profilerLock);
+}
+
+void RenderProfiler::noteFlush(const lv_area_t* area, uint32_t elapsed_us) {
+    framePixels += (uint32_t)lv_area_get_size(area);
+    frameFlushUs += elapsed_us;
+}
+
+void RenderProfiler::eventCb(lv_event_t* e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA:
+            if (pendingAreas < UINT16_MAX) {
+                pendingAreas++;
+            }
+            break;
+
+        case LV_EVENT_RENDER_START:
+            frameStartUs = micros();
+            framePixels = 0;
+            frameFlushUs = 0;
+            inFrame = true;
+            break;
+
+        case LV_EVENT_RENDER_READY: {
+            if (!inFrame) break;
+            inFrame = false;
+
+            uint32_t total_us = micros() - frameStartUs;
+            FrameRecord record;
+            record.areas = pendingAreas;
+            record.pixels = framePixels;
+            record.flushUs = frameFlushUs;
+            record.renderUs = total_us > frameFlushUs ? total_us - frameFlushUs : 0;
+            pendingAreas = 0;
+
+            portENTER_CRITICAL(&profilerLock);
+            record.card = activeCard;
+            frameLog[(frameLogHead + frameLogCount) % FRAME_LOG_SIZE] = record;
+            if (frameLogCount < FRAME_LOG_SIZE) {
+                frameLogCount++;
+            } else {
+                frameLogHead = (frameLogHead + 1) % FRAME_LOG_SIZE;
+            }
+            if (activeCard != NO_CARD) {
+                CardStats& stats = cards[activeCard].stats;
+                stats.frames++;
+                stats.pixels += record.pixels;
+                stats.areas += record.areas;
+                stats.renderUs += record.renderUs;
+                stats.flushUs += record.flushUs;
+                if (total_us > stats.worstFrameUs) {
+                    stats.worstFrameUs = total_us;
+                }
+            }
+            totalFrames++;
+            portEXIT_CRITICAL(&profilerLock);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void RenderProfiler::dump(Print& out) {
+    CardSlot snapshot[MAX_CARDS];
+    uint32_t frames;
+    portENTER_CRITICAL(&profilerLock);
+    memcpy(snapshot, cards, sizeof(snapshot));
+    frames = totalFrames;
+    portEXIT_CRITICAL(&profilerLock);
+
+    out.printf("[RenderProfiler] %lu frames\n", (unsigned long)frames);
+    for (size_t i = 0; i < MAX_CARDS; i++) {
+        const CardStats& stats = snapshot[i].stats;
+        if (!snapshot[i].card || stats.frames == 0) continue;
+        out.printf("  %-24s frames=%lu avg_px=%lu avg_areas=%lu avg_render=%luus avg_flush=%luus worst=%luus\n",
+                   stats.label, (unsigned long)stats.frames,
+                   (unsigned long)(stats.pixels / stats.frames),
+                   (unsigned long)(stats.areas / stats.frames),
+                   (unsigned long)(stats.renderUs / stats.frames),
+                   (unsigned long)(stats.flushUs / stats.frames),
+                   (unsigned long)stats.worstFrameUs);
+    }
+}
+
+void RenderProfiler::writeJson(JsonObject root) {
+    CardSlot snapshot[MAX_CARDS];
+    FrameRecord frames[FRAME_LOG_SIZE];
+    size_t frame_count;
+    size_t frame_head;
+    uint32_t total;
+    portENTER_CRITICAL(&profilerLock);
+    memcpy(snapshot, cards, sizeof(snapshot));
+    memcpy(frames, frameLog, sizeof(frames));
+    frame_count = frameLogCount;
+    frame_head = frameLogHead;
+    total = totalFrames;
+    portEXIT_CRITICAL(&profilerLock);
+
+    root["frames"] = total;
+
+    JsonArray card_array = root.createNestedArray("cards");
+    for (size_t i = 0; i < MAX_CARDS; i++) {
+        const CardStats& stats = snapshot[i].stats;
+        if (!snapshot[i].card || stats.frames == 0) continue;
+        JsonObject card = card_array.createNestedObject();
+        // Labels live in this stack frame, so make the document copy them
+        card["card"] = String(stats.label);
+        card["frames"] = stats.frames;
+        card["pixels"] = (double)stats.pixels;
+        card["areas"] = stats.areas;
+        card["renderUs"] = (double)stats.renderUs;
+        card["flushUs"] = (double)stats.flushUs;
+        card["worstFrameUs"] = stats.worstFrameUs;
+    }
+
+    JsonArray recent = root.createNestedArray("recent");
+    for (size_t i = 0; i < frame_count; i++) {
+        const FrameRecord& record = frames[(frame_head + i) % FRAME_LOG_SIZE];
+        JsonObject frame = recent.createNestedObject();
+        frame["card"] = record.card != NO_CARD ? String(snapshot[record.card].stats.label) : String();
+        frame["areas"] = record.areas;
+        frame["pixels"] = record.pixels;
+        frame["renderUs"] = record.renderUs;
+        frame["flushUs"] = record.flushUs;
+    }
+}
+
+void RenderProfiler::reset() {
+    portENTER_CRITICAL(&profilerLock);
+    for (size_t i = 0; i < MAX_CARDS; i++) {
+        char label[LABEL_LENGTH];
+        memcpy(label, cards[i].stats.label, LABEL_LENGTH);
+        memset(&cards[i].stats, 0, sizeof(CardStats));
+        memcpy(cards[i].stats.label, label, LABEL_LENGTH);
+    }
+    frameLogCount = 0;
+    frameLogHead = 0;
+    totalFrames = 0;
+    portEXIT_CRITICAL(&profilerLock);
+}
+
+void RenderProfiler::maybeDump() {
+    if (RENDER_PROFILER_DUMP_INTERVAL_MS == 0) return;
+    uint32_t now = millis();
+    if (now - lastDumpMs >= RENDER_PROFILER_DUMP_INTERVAL_MS) {
+        lastDumpMs = now;
+        dump(Serial);
+    }
+}
+
+#endif // RENDER_PROFILER
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <ArduinoJson.h>
+
+/**
+ * @brief Compile-time switch for the render profiler
+ *
+ * Set -DRENDER_PROFILER=1 in build_flags to record, for every LVGL frame,
+ * the invalidated areas, pixels flushed, render time and flush time,
+ * attributed to the card on screen. When 0 (the default) the hooks compile
+ * to nothing.
+ */
+#ifndef RENDER_PROFILER
+#define RENDER_PROFILER 0
+#endif
+
+/**
+ * @brief Interval for the periodic serial summary in milliseconds (0 disables)
+ */
+#ifndef RENDER_PROFILER_DUMP_INTERVAL_MS
+#define RENDER_PROFILER_DUMP_INTERVAL_MS 30000
+#endif
+
+#if RENDER_PROFILER
+
+/**
+ * @class RenderProfiler
+ * @brief Per-card frame cost accounting for the LVGL display
+ *
+ * attach() hooks the display's invalidate and render start/ready events;
+ * DisplayInterface reports each flush through noteFlush(). Frames are kept
+ * in a short rolling log and folded into per-card totals keyed by the card
+ * that was active when the frame was rendered.
+ *
+ * Recording happens on the LVGL task; summaries may be read from any task.
+ */
+class RenderProfiler {
+public:
+    static constexpr size_t MAX_CARDS = 24;
+    static constexpr size_t FRAME_LOG_SIZE = 32;
+    static constexpr size_t LABEL_LENGTH = 32;
+
+    struct FrameRecord {
+        uint8_t card;         ///< Index into the card table
+        uint16_t areas;       ///< Invalidations since the previous frame
+        uint32_t pixels;      ///< Pixels sent to the panel
+        uint32_t renderUs;    ///< Drawing time, excluding flushes
+        uint32_t flushUs;     ///< Time spent in the flush callback
+    };
+
+    struct CardStats {
+        char label[LABEL_LENGTH];
+        uint32_t frames;
+        uint64_t pixels;
+        uint32_t areas;
+        uint64_t renderUs;
+        uint64_t flushUs;
+        uint32_t worstFrameUs;
+    };
+
+    /**
+     * @brief Register the display event hooks
+     */
+    static void attach(lv_display_t* display);
+
+    /**
+     * @brief Attribute the following frames to a card
+     * @param card Card object on screen (identity only, never dereferenced)
+     * @param label Human-readable name, copied on first use
+     */
+    static void setActiveCard(const void* card, const char* label);
+
+    /**
+     * @brief Forget a card, e.g. when it is deleted
+     */
+    static void forgetCard(const void* card);
+
+    /**
+     * @brief Record one flush from the display driver
+     */
+    static void noteFlush(const lv_area_t* area, uint32_t elapsed_us);
+
+    static void dump(Print& out);
+    static void writeJson(JsonObject root);
+    static void reset();
+
+    /**
+     * @brief Print the summary if the dump interval has elapsed
+     */
+    static void maybeDump();
+
+private:
+    static void eventCb(lv_event_t* e);
+};
+
+#endif // RENDER_PROFILER
@@ -0,0 +1,456 @@
+#include "UIBenchmark.h"
+
+#if UI_BENCHMARK
+
+#include "CardNavigationStack.h"
+#include "LvObjHandle.h"
+#include "InsightData.h"
+#include "Style.h"
+#include "NumberFormat.h"
+#include "renderers/FunnelRenderer.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CARD_COUNT = 10;
+constexpr uint32_t FUNNEL_STEPS = 5;
+constexpr uint32_t FUNNEL_BREAKDOWNS = 5;
+// Container, then a bar, a label and a segment per breakdown for each step
+constexpr uint32_t OBJECTS_PER_CARD = 1 + FUNNEL_STEPS * (2 + FUNNEL_BREAKDOWNS);
+constexpr uint32_t UPDATES = 200;
+// Leave room for the real UI; the LVGL heap is only LV_MEM_SIZE bytes
+constexpr uint32_t MIN_FREE_LVGL_HEAP = 8 * 1024;
+
+uint32_t lvglHeapFree() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.free_size;
+}
+
+// Object tree of a funnel card before the renderer drew it on one object
+void buildLegacyFunnelTree(lv_obj_t* parent, lv_obj_t** objects) {
+    uint32_t n = 0;
+    lv_obj_t* container = lv_obj_create(parent);
+    objects[n++] = container;
+    for (uint32_t i = 0; i < FUNNEL_STEPS; i++) {
+        lv_obj_t* bar = lv_obj_create(container);
+        objects[n++] = bar;
+        objects[n++] = lv_label_create(container);
+        for (uint32_t j = 0; j < FUNNEL_BREAKDOWNS; j++) {
+            objects[n++] = lv_obj_create(bar);
+        }
+    }
+}
+
+constexpr uint32_t STACK_CARDS = 30;
+constexpr uint16_t STACK_WIDTH = 240;
+constexpr uint16_t STACK_HEIGHT = 135;
+
+uint32_t lvglHeapUsed() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+// CardNavigationStack before the pip indicator was drawn: a flex column of
+// pip objects, all deleted and recreated every time a card was added
+class LegacyPipStack {
+public:
+    LegacyPipStack(lv_obj_t* parent, uint16_t width, uint16_t height) : _width(width), _height(height) {
+        _cards = lv_obj_create(parent);
+        lv_obj_set_size(_cards, _width - 7, _height);
+        lv_obj_set_flex_flow(_cards, LV_FLEX_FLOW_COLUMN);
+
+        _indicator = lv_obj_create(parent);
+        lv_obj_set_size(_indicator, 2, _height);
+        lv_obj_align(_indicator, LV_ALIGN_RIGHT_MID, 0, 0);
+        lv_obj_set_style_bg_opa(_indicator, LV_OPA_TRANSP, 0);
+        lv_obj_set_style_border_width(_indicator, 0, 0);
+        lv_obj_set_style_pad_all(_indicator, 0, 0);
+        lv_obj_set_style_pad_row(_indicator, 5, 0);
+        lv_obj_set_flex_flow(_indicator, LV_FLEX_FLOW_COLUMN);
+        lv_obj_set_flex_align(_indicator, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+        lv_obj_clear_flag(_indicator, LV_OBJ_FLAG_SCROLLABLE);
+    }
+
+    void addCard(lv_obj_t* card) {
+        lv_obj_set_parent(card, _cards);
+        lv_obj_set_size(card, _width - 7, _height);
+        lv_obj_set_style_border_width(card, 0, 0);
+        lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+        updatePipCount();
+    }
+
+    void updatePipCount() {
+        uint32_t card_count = lv_obj_get_child_cnt(_cards);
+        int32_t total_gaps = (card_count > 1) ? ((card_count - 1) * 5) : 0;
+        int32_t pip_height = (_height - total_gaps) / (int32_t)card_count;
+        if (pip_height < 2) pip_height = 2;
+
+        lv_obj_clean(_indicator);
+        for (uint32_t i = 0; i < card_count; i++) {
+            lv_obj_t* pip = lv_obj_create(_indicator);
+            lv_obj_set_size(pip, 2, pip_height);
+            lv_obj_set_style_radius(pip, 0, 0);
+            lv_obj_set_style_bg_color(pip, i == 0 ? lv_color_white() : lv_color_hex(0x808080), 0);
+            lv_obj_set_style_border_width(pip, 0, 0);
+            lv_obj_clear_flag(pip, LV_OBJ_FLAG_SCROLLABLE);
+        }
+    }
+
+private:
+    uint16_t _width;
+    uint16_t _height;
+    lv_obj_t* _cards;
+    lv_obj_t* _indicator;
+};
+
+void createPlainCards(lv_obj_t* parent, lv_obj_t** cards) {
+    for (uint32_t i = 0; i < STACK_CARDS; i++) {
+        cards[i] = lv_obj_create(parent);
+    }
+}
+
+lv_obj_tree_walk_res_t countObject(lv_obj_t* obj, void* user_data) {
+    (void)obj;
+    (*static_cast<uint32_t*>(user_data))++;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+uint32_t countTree(lv_obj_t* root) {
+    uint32_t count = 0;
+    lv_obj_tree_walk(root, countObject, &count);
+    return count;
+}
+
+constexpr int32_t FUNNEL_WIDTH = 230;
+constexpr int32_t FUNNEL_HEIGHT = 100;
+constexpr int32_t FUNNEL_BAR_HEIGHT = 5;
+constexpr int32_t FUNNEL_BAR_GAP = 24;
+constexpr int32_t FUNNEL_LABEL_HEIGHT = 20;
+constexpr uint32_t FUNNEL_UPDATES = 100;
+const uint32_t FUNNEL_COLORS[FUNNEL_BREAKDOWNS] = {0x2980b9, 0x8e44ad, 0xd35400, 0xc0392b, 0x27ae60};
+
+// Five steps with five breakdowns; variant shifts the counts so every update changes something
+void fillFunnel(InsightData& data, uint32_t variant) {
+    static const char* const names[FUNNEL_STEPS] = {
+        "Viewed pricing page", "Started signup", "Verified email", "Created first project", "Invited a teammate"};
+    data.type = InsightParser::InsightType::FUNNEL;
+    data.funnelStepCount = FUNNEL_STEPS;
+    data.funnelBreakdownCount = FUNNEL_BREAKDOWNS;
+    uint32_t total = 12000 + variant * 700;
+    for (uint32_t i = 0; i < FUNNEL_STEPS; i++) {
+        InsightData::FunnelStep& step = data.funnelSteps[i];
+        step.total = 0;
+        for (uint32_t k = 0; k < FUNNEL_BREAKDOWNS; k++) {
+            step.breakdowns[k] = total / (2 + (k + variant + i) % FUNNEL_BREAKDOWNS);
+            step.total += step.breakdowns[k];
+        }
+        step.hasBreakdowns = true;
+        strlcpy(step.name, names[i], sizeof(step.name));
+        total = total * 3 / 5;
+    }
+}
+
+// What the old FunnelRenderer computed off the UI task for its update lambda
+struct LegacyFunnelStep {
+    String label;
+    struct {
+        float width;
+        float offset;
+        lv_color_t color;
+    } segments[FUNNEL_BREAKDOWNS];
+};
+
+void prepareLegacyFunnel(const InsightData& data, int32_t bar_width, LegacyFunnelStep* steps) {
+    uint32_t first = data.funnelSteps[0].total;
+    for (uint32_t i = 0; i < FUNNEL_STEPS; i++) {
+        const InsightData::FunnelStep& source = data.funnelSteps[i];
+        char number[20];
+        NumberFormat::addThousandsSeparators(number, sizeof(number), source.total);
+        uint32_t percentage = first > 0 ? (uint32_t)((uint64_t)source.total * 100 / first) : 0;
+        steps[i].label = (percentage == 100 && i == 0) ? String(number) : String(percentage) + "% - " + String(number);
+        steps[i].label += " - ";
+        steps[i].label += source.name;
+
+        uint8_t order[FUNNEL_BREAKDOWNS];
+        for (uint32_t k = 0; k < FUNNEL_BREAKDOWNS; k++) order[k] = (uint8_t)k;
+        std::sort(order, order + FUNNEL_BREAKDOWNS, [&](uint8_t a, uint8_t b) {
+            return source.breakdowns[a] > source.breakdowns[b];
+        });
+        float step_width = first > 0 ? bar_width * (float)source.total / first : 0.0f;
+        float offset = 0.0f;
+        for (uint32_t k = 0; k < FUNNEL_BREAKDOWNS; k++) {
+            float width = source.total > 0 ? step_width * source.breakdowns[order[k]] / source.total : 0.0f;
+            steps[i].segments[k].width = width;
+            steps[i].segments[k].offset = offset;
+            steps[i].segments[k].color = lv_color_hex(FUNNEL_COLORS[order[k]]);
+            offset += width;
+        }
+    }
+}
+
+// FunnelRenderer before it drew on one object: a container, and a bar with
+// five segment objects and a LONG_DOT label per step, restyled on every update
+class LegacyFunnel {
+public:
+    // Stops early, leaving built() false, if the LVGL heap runs low
+    explicit LegacyFunnel(lv_obj_t* parent) : _built(false) {
+        _container = lv_obj_create(parent);
+        lv_obj_set_size(_container, lv_pct(100), lv_pct(100));
+        lv_obj_align(_container, LV_ALIGN_TOP_LEFT, 0, 0);
+        lv_obj_clear_flag(_container, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_style_pad_all(_container, 0, 0);
+        lv_obj_set_style_border_width(_container, 0, 0);
+        lv_obj_set_style_bg_opa(_container, LV_OPA_0, 0);
+        lv_obj_update_layout(_container);
+        _width = lv_obj_get_content_width(_container);
+
+        for (uint32_t i = 0; i < FUNNEL_STEPS; i++) {
+            if (lvglHeapFree() < MIN_FREE_LVGL_HEAP) return;
+            _bars[i] = lv_obj_create(_container);
+            lv_obj_set_size(_bars[i], _width, FUNNEL_BAR_HEIGHT);
+            lv_obj_set_style_bg_opa(_bars[i], LV_OPA_0, 0);
+            lv_obj_set_style_border_width(_bars[i], 0, 0);
+            lv_obj_set_style_pad_all(_bars[i], 0, 0);
+            lv_obj_clear_flag(_bars[i], LV_OBJ_FLAG_SCROLLABLE);
+            lv_obj_add_flag(_bars[i], LV_OBJ_FLAG_HIDDEN);
+
+            _labels[i] = lv_label_create(_container);
+            lv_obj_set_style_text_color(_labels[i], Style::valueColor(), 0);
+            lv_obj_set_style_text_font(_labels[i], Style::valueFont(), 0);
+            lv_label_set_long_mode(_labels[i], LV_LABEL_LONG_DOT);
+            lv_obj_set_width(_labels[i], _width);
+            lv_obj_set_height(_labels[i], FUNNEL_LABEL_HEIGHT);
+            lv_obj_add_flag(_labels[i], LV_OBJ_FLAG_HIDDEN);
+
+            for (uint32_t k = 0; k < FUNNEL_BREAKDOWNS; k++) {
+                lv_obj_t* segment = lv_obj_create(_bars[i]);
+                _segments[i][k] = segment;
+                lv_obj_set_height(segment, FUNNEL_BAR_HEIGHT);
+                lv_obj_set_style_bg_color(segment, lv_color_hex(FUNNEL_COLORS[k]), 0);
+                lv_obj_set_style_border_width(segment, 0, 0);
+                lv_obj_set_style_radius(segment, 0, 0);
+                lv_obj_set_style_pad_all(segment, 0, 0);
+                lv_obj_add_flag(segment, LV_OBJ_FLAG_HIDDEN);
+            }
+        }
+        _built = true;
+    }
+
+    bool built() const { return _built; }
+
+    // The old update lambda, run on the LVGL task
+    void apply(const LegacyFunnelStep* steps) {
+        int32_t y = 0;
+        for (uint32_t i = 0; i < FUNNEL_STEPS; i++) {
+            lv_obj_clear_flag(_bars[i], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_align(_bars[i], LV_ALIGN_TOP_LEFT, 0, y);
+            lv_obj_set_width(_bars[i], _width);
+            for (uint32_t k = 0; k < FUNNEL_BREAKDOWNS; k++) {
+                lv_obj_t* segment = _segments[i][k];
+                int32_t width = (int32_t)steps[i].segments[k].width;
+                if (width == 0 && steps[i].segments[k].width > 0) width = 1;
+                if (width > 0) {
+                    lv_obj_set_size(segment, width, FUNNEL_BAR_HEIGHT);
+                    lv_obj_align(segment, LV_ALIGN_LEFT_MID, (int32_t)steps[i].segments[k].offset, 0);
+                    lv_obj_set_style_bg_color(segment, steps[i].segments[k].color, 0);
+                    lv_obj_clear_flag(segment, LV_OBJ_FLAG_HIDDEN);
+                } else {
+                    lv_obj_add_flag(segment, LV_OBJ_FLAG_HIDDEN);
+                }
+            }
+            lv_obj_set_width(_labels[i], _width);
+            lv_label_set_text(_labels[i], steps[i].label.c_str());
+            lv_obj_clear_flag(_labels[i], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_align(_labels[i], LV_ALIGN_TOP_LEFT, 1, y + FUNNEL_BAR_HEIGHT + 2);
+            y += FUNNEL_BAR_HEIGHT + FUNNEL_BAR_GAP;
+        }
+    }
+
+private:
+    bool _built;
+    int32_t _width;
+    lv_obj_t* _container;
+    lv_obj_t* _bars[FUNNEL_STEPS];
+    lv_obj_t* _labels[FUNNEL_STEPS];
+    lv_obj_t* _segments[FUNNEL_STEPS][FUNNEL_BREAKDOWNS];
+};
+
+lv_obj_t* createFunnelParent(lv_obj_t* screen) {
+    lv_obj_t* parent = lv_obj_create(screen);
+    lv_obj_remove_style_all(parent);
+    lv_obj_set_size(parent, FUNNEL_WIDTH, FUNNEL_HEIGHT);
+    return parent;
+}
+
+} // namespace
+
+void UIBenchmark::run() {
+    Serial.println("[UIBench] Starting");
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    benchObjectValidity(screen);
+    lv_obj_clean(screen);
+    benchPipIndicator(screen);
+    lv_obj_clean(screen);
+    benchFunnel(screen);
+    lv_obj_delete(screen);
+    Serial.println("[UIBench] Done");
+}
+
+void UIBenchmark::benchObjectValidity(lv_obj_t* screen) {
+    std::vector<lv_obj_t*> objects(CARD_COUNT * OBJECTS_PER_CARD);
+    uint32_t cards = 0;
+    while (cards < CARD_COUNT && lvglHeapFree() > MIN_FREE_LVGL_HEAP) {
+        lv_obj_t* card_obj = lv_obj_create(screen);
+        buildLegacyFunnelTree(card_obj, &objects[cards * OBJECTS_PER_CARD]);
+        cards++;
+    }
+    if (cards == 0) {
+        Serial.println("[UIBench] Validity: skipped, LVGL heap too small");
+        return;
+    }
+
+    // Update a card in the middle of the stack; later cards cost the walk more
+    lv_obj_t** updated = &objects[(cards / 2) * OBJECTS_PER_CARD];
+    uint32_t fallbacks_before = LvObjHandle::fallbackCount();
+    std::vector<LvObjHandle> handles(OBJECTS_PER_CARD);
+    for (uint32_t i = 0; i < OBJECTS_PER_CARD; i++) {
+        handles[i] = updated[i];
+    }
+    uint32_t fallbacks = LvObjHandle::fallbackCount() - fallbacks_before;
+
+    volatile uint32_t valid = 0;
+    uint32_t start = micros();
+    for (uint32_t u = 0; u < UPDATES; u++) {
+        for (uint32_t i = 0; i < OBJECTS_PER_CARD; i++) {
+            valid += lv_obj_is_valid(updated[i]);
+        }
+    }
+    uint32_t walk_us = micros() - start;
+
+    start = micros();
+    for (uint32_t u = 0; u < UPDATES; u++) {
+        for (uint32_t i = 0; i < OBJECTS_PER_CARD; i++) {
+            valid += handles[i].isValid();
+        }
+    }
+    uint32_t handle_us = micros() - start;
+
+    uint32_t tree_objects = countTree(lv_screen_active()) + countTree(screen);
+    float walk = walk_us / (float)UPDATES;
+    float handle = handle_us / (float)UPDATES;
+    Serial.printf("[UIBench] Validity, %lu cards, %lu objects in the tree, %lu checks per update\n",
+                  (unsigned long)cards, (unsigned long)tree_objects, (unsigned long)OBJECTS_PER_CARD);
+    Serial.printf("[UIBench]   lv_obj_is_valid %.2f us/update, LvObjHandle %.2f us/update (%.0fx)%s\n",
+                  walk, handle, handle > 0 ? walk / handle : 0.0f,
+                  fallbacks ? ", some handles fell back to lv_obj_is_valid" : "");
+}
+
+void UIBenchmark::benchPipIndicator(lv_obj_t* screen) {
+    lv_obj_t* cards[STACK_CARDS];
+
+    // Layout is resolved once at the end, as it would be at the next refresh
+    createPlainCards(screen, cards);
+    uint32_t heap_before = lvglHeapUsed();
+    uint32_t start = micros();
+    LegacyPipStack legacy(screen, STACK_WIDTH, STACK_HEIGHT);
+    for (uint32_t i = 0; i < STACK_CARDS; i++) {
+        legacy.addCard(cards[i]);
+    }
+    lv_obj_update_layout(screen);
+    uint32_t legacy_us = micros() - start;
+    uint32_t legacy_heap = lvglHeapUsed() - heap_before;
+    lv_obj_clean(screen);
+
+    createPlainCards(screen, cards);
+    heap_before = lvglHeapUsed();
+    start = micros();
+    CardNavigationStack* stack = new CardNavigationStack(screen, STACK_WIDTH, STACK_HEIGHT);
+    for (uint32_t i = 0; i < STACK_CARDS; i++) {
+        stack->addCard(cards[i]);
+    }
+    stack->forceUpdateIndicators();
+    lv_obj_update_layout(screen);
+    uint32_t drawn_us = micros() - start;
+    uint32_t drawn_heap = lvglHeapUsed() - heap_before;
+    lv_obj_clean(screen);
+    delete stack;
+
+    Serial.printf("[UIBench] Pip indicator, %lu-card stack\n", (unsigned long)STACK_CARDS);
+    Serial.printf("[UIBench]   recreated pips %lu us, %lu bytes LVGL heap\n",
+                  (unsigned long)legacy_us, (unsigned long)legacy_heap);
+    Serial.printf("[UIBench]   drawn column   %lu us, %lu bytes LVGL heap\n",
+                  (unsigned long)drawn_us, (unsigned long)drawn_heap);
+}
+
+void UIBenchmark::benchFunnel(lv_obj_t* screen) {
+    // The models are large for the LVGL task stack
+    std::unique_ptr<InsightData> data[2] = {std::unique_ptr<InsightData>(new InsightData()),
+                                            std::unique_ptr<InsightData>(new InsightData())};
+    fillFunnel(*data[0], 0);
+    fillFunnel(*data[1], 1);
+
+    // The old renderer prepared labels and segments on the event task
+    LegacyFunnelStep legacy_steps[2][FUNNEL_STEPS];
+    prepareLegacyFunnel(*data[0], FUNNEL_WIDTH, legacy_steps[0]);
+    prepareLegacyFunnel(*data[1], FUNNEL_WIDTH, legacy_steps[1]);
+
+    // Object tree: build, first update, layout; then updates alternating between two data sets
+    uint32_t heap_before = lvglHeapUsed();
+    uint32_t start = micros();
+    LegacyFunnel legacy(createFunnelParent(screen));
+    if (!legacy.built()) {
+        lv_obj_clean(screen);
+        Serial.println("[UIBench] Funnel: skipped, LVGL heap too small for the object tree");
+        return;
+    }
+    legacy.apply(legacy_steps[0]);
+    lv_obj_update_layout(screen);
+    uint32_t legacy_build_us = micros() - start;
+    uint32_t legacy_heap = lvglHeapUsed() - heap_before;
+
+    start = micros();
+    for (uint32_t u = 0; u < FUNNEL_UPDATES; u++) {
+        legacy.apply(legacy_steps[u % 2]);
+        lv_obj_update_layout(screen);
+    }
+    uint32_t legacy_update_us = micros() - start;
+    lv_obj_clean(screen);
+
+    // One drawn object and the step table
+    heap_before = lvglHeapUsed();
+    start = micros();
+    FunnelRenderer* renderer = new FunnelRenderer();
+    lv_obj_t* parent = createFunnelParent(screen);
+    renderer->createElements(parent);
+    lv_obj_update_layout(parent);
+    renderer->updateDisplay(*data[0]);
+    lv_obj_update_layout(screen);
+    uint32_t drawn_build_us = micros() - start;
+    uint32_t drawn_heap = lvglHeapUsed() - heap_before;
+
+    start = micros();
+    for (uint32_t u = 0; u < FUNNEL_UPDATES; u++) {
+        renderer->updateDisplay(*data[u % 2]);
+        lv_obj_update_layout(screen);
+    }
+    uint32_t drawn_update_us = micros() - start;
+    renderer->clearElements();
+    delete renderer;
+    lv_obj_clean(screen);
+
+    Serial.printf("[UIBench] Funnel, %lu steps x %lu breakdowns, build + first update, then %lu updates\n",
+                  (unsigned long)FUNNEL_STEPS, (unsigned long)FUNNEL_BREAKDOWNS, (unsigned long)FUNNEL_UPDATES);
+    Serial.printf("[UIBench]   object tree  build %lu us, %.1f us/update, %lu bytes LVGL heap\n",
+                  (unsigned long)legacy_build_us, legacy_update_us / (float)FUNNEL_UPDATES,
+                  (unsigned long)legacy_heap);
+    Serial.printf("[UIBench]   drawn object build %lu us, %.1f us/update, %lu bytes LVGL heap + %u bytes step table\n",
+                  (unsigned long)drawn_build_us, drawn_update_us / (float)FUNNEL_UPDATES,
+                  (unsigned long)drawn_heap, (unsigned)sizeof(FunnelRenderer));
+    Serial.println("[UIBench]   object tree labels and segments were prepared on the event task; not timed");
+}
+
+#endif // UI_BENCHMARK
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+/**
+ * @brief Compile-time switch for the UI cost benchmarks
+ *
+ * Set -DUI_BENCHMARK=1 in build_flags to run, once after the first card
+ * reconcile, micro-benchmarks that time the current UI building blocks
+ * against the implementations they replaced. Results are printed as
+ * "[UIBench]" lines. When 0 (the default) nothing is compiled.
+ */
+#ifndef UI_BENCHMARK
+#define UI_BENCHMARK 0
+#endif
+
+#if UI_BENCHMARK
+
+/**
+ * @class UIBenchmark
+ * @brief Before/after timings for UI changes, measured on the device
+ *
+ * Each benchmark builds its objects on a scratch screen that is never
+ * loaded, so nothing is drawn, while the real card tree stays in place and
+ * is paid for by anything that walks the object tree. The "before" side is
+ * a faithful replica of the replaced code, kept here only for comparison.
+ * Benchmarks stop adding objects before the LVGL heap runs low and report
+ * how many they actually built.
+ */
+class UIBenchmark {
+public:
+    /**
+     * @brief Run every benchmark and log the results
+     *
+     * Must be called on the LVGL task; the UI is unresponsive until it finishes.
+     */
+    static void run();
+
+private:
+    /**
+     * @brief Validity checks of one card update: lv_obj_is_valid vs LvObjHandle
+     */
+    static void benchObjectValidity(lv_obj_t* screen);
+
+    /**
+     * @brief Building a 30-card stack: pip objects recreated per add vs one drawn column
+     */
+    static void benchPipIndicator(lv_obj_t* screen);
+
+    /**
+     * @brief Funnel card heap and update cost: 36-object tree vs one drawn object
+     */
+    static void benchFunnel(lv_obj_t* screen);
+};
+
+#endif // UI_BENCHMARK
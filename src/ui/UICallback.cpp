@@ -0,0 +1,78 @@
+#include "UICallback.h"
+
+UICallback UICallbackPool::_slots[UICallbackPool::CAPACITY];
+std::atomic<uint16_t> UICallbackPool::_next[UICallbackPool::CAPACITY];
+std::atomic<uint32_t> UICallbackPool::_head(UICallbackPool::EMPTY);
+
+std::atomic<uint32_t> UICallbackPool::_acquired(0);
+std::atomic<uint32_t> UICallbackPool::_heapFallbacks(0);
+std::atomic<uint32_t> UICallbackPool::_poolExhausted(0);
+std::atomic<uint32_t> UICallbackPool::_inUse(0);
+std::atomic<uint32_t> UICallbackPool::_highWater(0);
+
+UISubmitFn globalUISubmit = nullptr;
+UICancelFn globalUICancel = nullptr;
+
+void UICallbackPool::begin() {
+    // Chain every slot: 0 -> 1 -> ... -> CAPACITY-1 -> EMPTY
+    for (uint16_t i = 0; i < CAPACITY; i++) {
+        _next[i].store(i + 1 < CAPACITY ? i + 1 : EMPTY, std::memory_order_relaxed);
+    }
+    _head.store(0, std::memory_order_release);
+}
+
+UICallback* UICallbackPool::acquire() {
+    _acquired.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t head = _head.load(std::memory_order_acquire);
+    while ((head & 0xFFFF) != EMPTY) {
+        uint16_t index = head & 0xFFFF;
+        // Bump the tag on every pop so a slot recycled between the load and
+        // the CAS cannot be mistaken for the head we read (ABA)
+        uint32_t next = ((head + 0x10000) & 0xFFFF0000) | _next[index].load(std::memory_order_relaxed);
+        if (_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            uint32_t in_use = _inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+            uint32_t high_water = _highWater.load(std::memory_order_relaxed);
+            while (in_use > high_water &&
+                   !_highWater.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed)) {
+            }
+            return &_slots[index];
+        }
+    }
+
+    // Pool empty (or never initialized): fall back to a heap slot
+    _poolExhausted.fetch_add(1, std::memory_order_relaxed);
+    return new (std::nothrow) UICallback();
+}
+
+void UICallbackPool::release(UICallback* callback) {
+    if (!callback) {
+        return;
+    }
+
+    if (!owns(callback)) {
+        delete callback;
+        return;
+    }
+
+    callback->reset();
+
+    uint16_t index = static_cast<uint16_t>(callback - &_slots[0]);
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    do {
+        _next[index].store(head & 0xFFFF, std::memory_order_relaxed);
+    } while (!_head.compare_exchange_weak(head, (head & 0xFFFF0000) | index,
+                                          std::memory_order_release, std::memory_order_relaxed));
+
+    _inUse.fetch_sub(1, std::memory_order_relaxed);
+}
+
+UICallbackPool::Stats UICallbackPool::getStats() {
+    Stats stats;
+    stats.acquired = _acquired.load(std::memory_order_relaxed);
+    stats.heapFallbacks = _heapFallbacks.load(std::memory_order_relaxed);
+    stats.poolExhausted = _poolExhausted.load(std::memory_order_relaxed);
+    stats.inUse = _inUse.load(std::memory_order_relaxed);
+    stats.highWater = _highWater.load(std::memory_order_relaxed);
+    return stats;
+}
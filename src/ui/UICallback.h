@@ -1,32 +1,264 @@
 #ifndef UI_CALLBACK_H
 #define UI_CALLBACK_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
-// Helper class for memory-safe UI callbacks, typically for LVGL operations
+/**
+ * @brief Type-erased UI callback with inline capture storage
+ *
+ * Closures up to INLINE_CAPACITY bytes are constructed directly inside the
+ * callback object, so dispatching a UI update does not touch the heap.
+ * Larger closures fall back to a single heap allocation, which is counted
+ * in UICallbackPool::Stats::heapFallbacks.
+ */
 class UICallback {
 public:
-    UICallback(std::function<void()> func) : _func(std::move(func)) {}
-    
+    static constexpr size_t INLINE_CAPACITY = 96;
+
+    UICallback() : _invoke(nullptr), _destroy(nullptr) {}
+
+    template <typename F>
+    explicit UICallback(F&& func) : UICallback() {
+        assign(std::forward<F>(func));
+    }
+
+    ~UICallback() { reset(); }
+
+    UICallback(const UICallback&) = delete;
+    UICallback& operator=(const UICallback&) = delete;
+
+    /**
+     * @brief Store a new closure, destroying any previous one
+     * @return false only if an oversize closure could not be heap-allocated
+     */
+    template <typename F>
+    bool assign(F&& func);
+
     void execute() {
-        if (_func) {
-            _func();
+        if (_invoke) {
+            _invoke(_storage);
         }
     }
-    
+
+    /**
+     * @brief Destroy the stored closure (and its heap block, if any)
+     */
+    void reset() {
+        if (_destroy) {
+            _destroy(_storage);
+        }
+        _invoke = nullptr;
+        _destroy = nullptr;
+    }
+
+    bool empty() const { return _invoke == nullptr; }
+
 private:
-    std::function<void()> _func;
+    using InvokeFn = void (*)(void*);
+    using DestroyFn = void (*)(void*);
+
+    alignas(std::max_align_t) unsigned char _storage[INLINE_CAPACITY];
+    InvokeFn _invoke;
+    DestroyFn _destroy;
+};
+
+/**
+ * @brief Fixed pool of UICallback slots shared by all producers
+ *
+ * Free slots are kept on a lock-free stack (index + ABA tag packed into one
+ * 32-bit word) so both cores can acquire and release without a mutex. When
+ * the pool is exhausted a UICallback is allocated on the heap instead and
+ * the event is counted, so the pool can be sized from real numbers.
+ */
+class UICallbackPool {
+public:
+    static constexpr uint16_t CAPACITY = 32;
+
+    struct Stats {
+        uint32_t acquired;       ///< Total callbacks handed out
+        uint32_t heapFallbacks;  ///< Closures too large for inline storage
+        uint32_t poolExhausted;  ///< Acquires served by a heap UICallback
+        uint32_t inUse;          ///< Pool slots currently outstanding
+        uint32_t highWater;      ///< Most pool slots outstanding at once
+    };
+
+    /**
+     * @brief Build the free list. Must run once before the first acquire.
+     */
+    static void begin();
+
+    /**
+     * @brief Get an empty callback, from the pool if possible
+     * @return Callback to fill, or nullptr if even the heap fallback failed
+     */
+    static UICallback* acquire();
+
+    /**
+     * @brief Destroy the stored closure and return the callback to its origin
+     */
+    static void release(UICallback* callback);
+
+    /**
+     * @brief Acquire a callback and store func in it
+     */
+    template <typename F>
+    static UICallback* make(F&& func) {
+        UICallback* callback = acquire();
+        if (callback && !callback->assign(std::forward<F>(func))) {
+            release(callback);
+            return nullptr;
+        }
+        return callback;
+    }
+
+    static Stats getStats();
+
+    static void noteHeapFallback() {
+        _heapFallbacks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint16_t EMPTY = 0xFFFF;
+
+    static bool owns(const UICallback* callback) {
+        return callback >= &_slots[0] && callback < &_slots[CAPACITY];
+    }
+
+    static UICallback _slots[CAPACITY];
+    static std::atomic<uint16_t> _next[CAPACITY];
+    static std::atomic<uint32_t> _head;  ///< (tag << 16) | index of first free slot
+
+    static std::atomic<uint32_t> _acquired;
+    static std::atomic<uint32_t> _heapFallbacks;
+    static std::atomic<uint32_t> _poolExhausted;
+    static std::atomic<uint32_t> _inUse;
+    static std::atomic<uint32_t> _highWater;
 };
 
+template <typename F>
+bool UICallback::assign(F&& func) {
+    using Fn = typename std::decay<F>::type;
+    reset();
+
+    if constexpr (sizeof(Fn) <= INLINE_CAPACITY && alignof(Fn) <= alignof(std::max_align_t)) {
+        new (_storage) Fn(std::forward<F>(func));
+        _invoke = [](void* storage) { (*static_cast<Fn*>(storage))(); };
+        _destroy = [](void* storage) { static_cast<Fn*>(storage)->~Fn(); };
+        return true;
+    } else {
+        Fn* heap_func = new (std::nothrow) Fn(std::forward<F>(func));
+        if (!heap_func) {
+            return false;
+        }
+        UICallbackPool::noteHeapFallback();
+        new (_storage) Fn*(heap_func);
+        _invoke = [](void* storage) { (**static_cast<Fn**>(storage))(); };
+        _destroy = [](void* storage) { delete *static_cast<Fn**>(storage); };
+        return true;
+    }
+}
+
+/**
+ * @brief Coalescing key for UI updates
+ *
+ * A pending update with the same (owner, purpose) is replaced by a newer one
+ * instead of both running. The default key (no owner) means plain FIFO work.
+ */
+struct UIUpdateKey {
+    const void* owner;  ///< Object the update belongs to, usually a card or renderer
+    uint32_t purpose;   ///< What the update does, scoped to the owner
+
+    UIUpdateKey() : owner(nullptr), purpose(0) {}
+    UIUpdateKey(const void* owner, uint32_t purpose) : owner(owner), purpose(purpose) {}
+
+    bool isValid() const { return owner != nullptr; }
+    bool operator==(const UIUpdateKey& other) const {
+        return owner == other.owner && purpose == other.purpose;
+    }
+};
+
+/**
+ * @brief Hand a filled callback to the LVGL task
+ *
+ * Set by CardController during initialization. Takes ownership of the
+ * callback and releases it itself if it cannot be queued.
+ *
+ * @return true if the callback was queued
+ */
+using UISubmitFn = bool (*)(UICallback* callback, bool to_front, const UIUpdateKey& key);
+extern UISubmitFn globalUISubmit;
+
+/**
+ * @brief Dispatch a closure to the LVGL task without going through std::function
+ *
+ * Preferred over globalUIDispatch on hot paths: the closure is constructed
+ * straight into a pooled slot instead of a heap-allocated std::function.
+ *
+ * @param func The function to execute on the UI thread
+ * @param to_front Whether to add to front of queue (higher priority)
+ * @return true if the update was queued
+ */
+template <typename F>
+bool dispatchUICallback(F&& func, bool to_front = false) {
+    if (!globalUISubmit) {
+        return false;
+    }
+    UICallback* callback = UICallbackPool::make(std::forward<F>(func));
+    if (!callback) {
+        return false;
+    }
+    return globalUISubmit(callback, to_front, UIUpdateKey());
+}
+
+/**
+ * @brief Dispatch a closure that supersedes any pending update with the same key
+ *
+ * Use for "show the latest state" updates (redraws, label text) where only
+ * the newest closure matters. The replaced closure keeps its queue position.
+ *
+ * @param key Coalescing key, e.g. UIUpdateKey(this, PURPOSE_DATA)
+ * @param func The function to execute on the UI thread
+ * @param to_front Whether to add to front of queue if nothing is coalesced
+ * @return true if the update was queued or coalesced
+ */
+template <typename F>
+bool dispatchKeyedUICallback(const UIUpdateKey& key, F&& func, bool to_front = false) {
+    if (!globalUISubmit) {
+        return false;
+    }
+    UICallback* callback = UICallbackPool::make(std::forward<F>(func));
+    if (!callback) {
+        return false;
+    }
+    return globalUISubmit(callback, to_front, key);
+}
+
+/**
+ * @brief Drop pending keyed updates owned by an object that is going away
+ *
+ * Set by CardController during initialization. Must be called on the LVGL
+ * thread, typically from the owner's destructor.
+ *
+ * @return Number of pending updates removed
+ */
+using UICancelFn = size_t (*)(const void* owner);
+extern UICancelFn globalUICancel;
+
 /**
  * @brief Global UI dispatch function
- * 
+ *
  * This function allows any component to dispatch UI updates to the LVGL thread safely.
  * It should be set by CardController during initialization.
- * 
+ *
  * @param func The function to execute on the UI thread
  * @param to_front Whether to add to front of queue (higher priority)
  */
 extern std::function<void(std::function<void()>, bool)> globalUIDispatch;
 
-#endif // UI_CALLBACK_H 
\ No newline at end of file
+#endif // UI_CALLBACK_H
@@ -0,0 +1,118 @@
+#include "UIUpdateQueue.h"
+
+UIUpdateQueue::UIUpdateQueue() : _head(0), _count(0), _unkeyed_count(0) {
+    _lock = portMUX_INITIALIZER_UNLOCKED;
+    for (size_t i = 0; i < CAPACITY; i++) {
+        _entries[i].callback = nullptr;
+    }
+}
+
+UIUpdateQueue::~UIUpdateQueue() {
+    UICallback* callback;
+    while ((callback = pop()) != nullptr) {
+        UICallbackPool::release(callback);
+    }
+}
+
+bool UIUpdateQueue::push(UICallback* callback, const UIUpdateKey& key, bool to_front, bool* coalesced) {
+    UICallback* to_release = nullptr;
+    bool queued = true;
+
+    portENTER_CRITICAL(&_lock);
+    bool replaced = false;
+    if (key.isValid()) {
+        for (size_t i = 0; i < _count; i++) {
+            Entry& entry = _entries[(_head + i) % CAPACITY];
+            if (entry.key == key) {
+                to_release = entry.callback;
+                entry.callback = callback;
+                replaced = true;
+                break;
+            }
+        }
+    }
+
+    if (!replaced) {
+        // Unkeyed work stops short of the keyed reserve, so it can never
+        // crowd out the newest state of a widget
+        bool full = _count == CAPACITY || (!key.isValid() && _unkeyed_count >= CAPACITY - KEYED_RESERVE);
+        if (full) {
+            to_release = callback;
+            queued = false;
+        } else if (to_front) {
+            _head = (_head + CAPACITY - 1) % CAPACITY;
+            _entries[_head] = {callback, key};
+            _count++;
+        } else {
+            _entries[(_head + _count) % CAPACITY] = {callback, key};
+            _count++;
+        }
+        if (queued && !key.isValid()) {
+            _unkeyed_count++;
+        }
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    // Destroy the superseded or rejected closure outside the lock
+    if (to_release) {
+        UICallbackPool::release(to_release);
+    }
+    if (coalesced) {
+        *coalesced = replaced;
+    }
+    return queued;
+}
+
+size_t UIUpdateQueue::cancel(const void* owner) {
+    if (!owner) {
+        return 0;
+    }
+
+    UICallback* removed[CAPACITY];
+    size_t removed_count = 0;
+
+    portENTER_CRITICAL(&_lock);
+    // Compact the ring in place, keeping the order of the survivors
+    size_t kept = 0;
+    for (size_t i = 0; i < _count; i++) {
+        Entry entry = _entries[(_head + i) % CAPACITY];
+        if (entry.key.owner == owner) {
+            removed[removed_count++] = entry.callback;
+        } else {
+            _entries[(_head + kept) % CAPACITY] = entry;
+            kept++;
+        }
+    }
+    _count = kept;
+    portEXIT_CRITICAL(&_lock);
+
+    for (size_t i = 0; i < removed_count; i++) {
+        UICallbackPool::release(removed[i]);
+    }
+    return removed_count;
+}
+
+UICallback* UIUpdateQueue::pop() {
+    UICallback* callback = nullptr;
+
+    portENTER_CRITICAL(&_lock);
+    if (_count > 0) {
+        callback = _entries[_head].callback;
+        if (!_entries[_head].key.isValid()) {
+            _unkeyed_count--;
+        }
+        _entries[_head].callback = nullptr;
+        _head = (_head + 1) % CAPACITY;
+        _count--;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    return callback;
+}
+
+size_t UIUpdateQueue::size() const {
+    portENTER_CRITICAL(&_lock);
+    size_t count = _count;
+    portEXIT_CRITICAL(&_lock);
+    return count;
+}
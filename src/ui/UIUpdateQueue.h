@@ -0,0 +1,78 @@
+#ifndef UI_UPDATE_QUEUE_H
+#define UI_UPDATE_QUEUE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include "UICallback.h"
+
+/**
+ * @class UIUpdateQueue
+ * @brief Bounded queue of pending UI callbacks with per-key coalescing
+ *
+ * Unkeyed callbacks run in FIFO order (or at the front when requested).
+ * A keyed callback replaces any pending callback with the same key in place,
+ * keeping its queue position, so the queue never holds two redraws for the
+ * same widget and superseded updates never run.
+ *
+ * Unkeyed callbacks are structural work (card creation, reconcile) and are
+ * never dropped once queued. They may fill at most CAPACITY - KEYED_RESERVE
+ * slots, so a flood of them cannot lock keyed state out of the queue.
+ *
+ * Entries live in a fixed ring; all operations hold a spinlock for a short
+ * scan of at most CAPACITY entries. Replaced or rejected callbacks are
+ * released after the lock is dropped.
+ */
+class UIUpdateQueue {
+public:
+    static constexpr size_t CAPACITY = 32;
+    static constexpr size_t KEYED_RESERVE = 8;  ///< Slots only keyed callbacks may use
+
+    UIUpdateQueue();
+    ~UIUpdateQueue();
+
+    /**
+     * @brief Queue a callback, coalescing with a pending one of the same key
+     *
+     * Nothing already queued is ever evicted. An unkeyed callback is
+     * rejected once unkeyed work fills its share of the ring; a keyed one
+     * that coalesces with nothing is rejected only when the ring is full.
+     *
+     * @param callback Callback from UICallbackPool; ownership passes to the queue
+     * @param key Coalescing key, UIUpdateKey() for plain FIFO work
+     * @param to_front Insert at the head of the queue (ignored when coalescing)
+     * @param coalesced Set to true if a pending callback was replaced
+     * @return false if the queue was full; the callback has been released
+     *         and the caller must undo anything that relied on it running
+     */
+    bool push(UICallback* callback, const UIUpdateKey& key, bool to_front, bool* coalesced = nullptr);
+
+    /**
+     * @brief Drop every pending keyed callback belonging to owner
+     *
+     * Used when the owner is destroyed so its queued closures never run.
+     * @return Number of callbacks removed
+     */
+    size_t cancel(const void* owner);
+
+    /**
+     * @brief Take the oldest pending callback
+     * @return Callback to execute and release, or nullptr if empty
+     */
+    UICallback* pop();
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        UICallback* callback;
+        UIUpdateKey key;
+    };
+
+    Entry _entries[CAPACITY];
+    size_t _head;   ///< Index of the oldest entry
+    size_t _count;  ///< Number of pending entries
+    size_t _unkeyed_count;  ///< Pending entries without a key
+    mutable portMUX_TYPE _lock;
+};
+
+#endif // UI_UPDATE_QUEUE_H
@@ -0,0 +1,206 @@
+#include "AreaChartRenderer.h"
+#include "LineGraphRenderer.h"
+#include "SeriesDecimator.h"
+#include "../RenderProfiler.h"
+#include <algorithm> // For std::min, std::max
+
+AreaChartRenderer::AreaChartRenderer()
+    : _chart(nullptr) {
+}
+
+AreaChartRenderer::~AreaChartRenderer() {
+    // Relies on InsightCard calling clearElements before destruction.
+}
+
+void AreaChartRenderer::createElements(lv_obj_t* parent_container) {
+    if (!isValidLVGLObject(parent_container)) {
+        Serial.println("[AreaChartRenderer-ERROR] Parent container invalid in createElements.");
+        return;
+    }
+
+    _chart = lv_obj_create(parent_container);
+    if (!_chart) {
+        Serial.println("[AreaChartRenderer-ERROR] Failed to create chart object.");
+        return;
+    }
+    lv_obj_remove_style_all(_chart);
+    lv_obj_set_size(_chart, lv_obj_get_content_width(parent_container), lv_obj_get_content_height(parent_container));
+    lv_obj_align(_chart, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_style_bg_color(_chart, lv_color_hex(0x050505), 0); // Same background as line graphs
+    lv_obj_set_style_bg_opa(_chart, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(_chart, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(_chart, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_chart, _draw_cb, LV_EVENT_DRAW_MAIN_END, this);
+}
+
+void AreaChartRenderer::prepareSeries(const InsightParser& parser, SeriesSet& set) {
+    set = SeriesSet();
+#if RENDER_PROFILER
+    uint32_t start_us = micros();
+#endif
+    size_t point_count = std::min(parser.getSeriesPointCount(), (size_t)UINT16_MAX);
+    if (point_count == 0) {
+        return;
+    }
+
+    size_t current = 0;
+    size_t previous = 0;
+    bool compare = parser.getCompareSeries(&current, &previous);
+
+    // One range over both periods so they share the y-axis; breakdown
+    // series listed between them are not drawn and must not stretch it
+    double min_value;
+    double max_value;
+    bool has_range = parser.getSeriesValueRange(current, &min_value, &max_value);
+    double previous_min;
+    double previous_max;
+    if (compare && parser.getSeriesValueRange(previous, &previous_min, &previous_max)) {
+        min_value = has_range ? std::min(min_value, previous_min) : previous_min;
+        max_value = has_range ? std::max(max_value, previous_max) : previous_max;
+    }
+    double offset;
+    double scale;
+    ChartScale::compute(min_value, max_value, &offset, &scale);
+
+    std::vector<int32_t> current_points(point_count);
+    std::vector<int32_t> previous_points(compare ? point_count : 0);
+    if (!parser.getSeriesYValues(current, current_points.data(), point_count, offset, scale) ||
+        (compare && !parser.getSeriesYValues(previous, previous_points.data(), point_count, offset, scale))) {
+        Serial.println("[AreaChartRenderer-ERROR] Failed to get Y series values from parser.");
+        return;
+    }
+
+    size_t kept;
+    if (compare) {
+        kept = SeriesDecimator::minMaxPair(current_points.data(), previous_points.data(), point_count,
+                                           MAX_AREA_POINTS, nullptr);
+    } else {
+        kept = SeriesDecimator::minMax(current_points.data(), point_count, MAX_AREA_POINTS);
+    }
+
+    current_points.resize(kept);
+    current_points.shrink_to_fit();
+    set.y = std::move(current_points);
+    if (compare) {
+        // Both periods are scaled into 0..CHART_Y_MAX, so the difference fits in 16 bits
+        set.compareDelta.resize(kept);
+        for (size_t i = 0; i < kept; i++) {
+            int32_t delta = previous_points[i] - set.y[i];
+            set.compareDelta[i] = (int16_t)std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, delta));
+        }
+    }
+
+    parser.getSeriesLabel(current, set.labels[0], SeriesSet::LABEL_LENGTH);
+    set.colors[0] = CURRENT_LINE_COLOR;
+    set.seriesCount = 1;
+    set.pointCount = (uint16_t)kept;
+#if RENDER_PROFILER
+    Serial.printf("[AreaChartRenderer] %u points -> %u, %s, prepared in %lu us\n",
+                  (unsigned int)point_count, (unsigned int)kept, compare ? "with previous period" : "no comparison",
+                  (unsigned long)(micros() - start_us));
+#endif
+}
+
+void AreaChartRenderer::updateDisplay(const InsightData& data) {
+    // Title is handled by InsightCard.
+    //
+    // InsightCard applies parsed data on the LVGL task, which is also where
+    // _draw_cb reads the points, so they are replaced in place.
+    if (!areElementsValid()) {
+        Serial.println("[AreaChartRenderer-WARN] Chart invalid in updateDisplay.");
+        return;
+    }
+
+    const SeriesSet& set = data.series;
+    _current.assign(set.y.begin(), set.y.begin() + (set.empty() ? 0 : set.pointCount));
+    _previous.assign(set.compareDelta.begin(), set.compareDelta.end());
+    lv_obj_invalidate(_chart);
+}
+
+void AreaChartRenderer::_draw_cb(lv_event_t* e) {
+    AreaChartRenderer* self = static_cast<AreaChartRenderer*>(lv_event_get_user_data(e));
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    lv_layer_t* layer = lv_event_get_layer(e);
+    size_t count = self->_current.size();
+    if (count < 2) return;
+    bool compare = self->_previous.size() == count;
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+    int32_t width = lv_area_get_width(&coords);
+    int32_t height = lv_area_get_height(&coords);
+
+    // Chart units to pixels, evenly spaced along x
+    auto point_x = [&](size_t i) { return coords.x1 + (int32_t)(i * (width - 1) / (count - 1)); };
+    auto point_y = [&](int32_t value) {
+        return coords.y2 - (int32_t)((int64_t)value * (height - 1) / LineGraphRenderer::CHART_Y_MAX);
+    };
+
+    lv_draw_rect_dsc_t fill_rect;
+    lv_draw_rect_dsc_init(&fill_rect);
+    fill_rect.radius = 0;
+    fill_rect.bg_opa = LV_OPA_COVER;
+    fill_rect.bg_color = lv_color_hex(CURRENT_FILL_COLOR);
+
+    lv_draw_triangle_dsc_t fill_wedge;
+    lv_draw_triangle_dsc_init(&fill_wedge);
+    fill_wedge.bg_opa = LV_OPA_COVER;
+    fill_wedge.bg_color = fill_rect.bg_color;
+
+    lv_draw_line_dsc_t line;
+    lv_draw_line_dsc_init(&line);
+    line.width = 2;
+    line.round_start = 1;
+    line.round_end = 1;
+
+    // Current period area: a wedge under each segment's slope and a rectangle
+    // down to the baseline, as the fill can't be a single polygon here
+    for (size_t i = 0; i + 1 < count; i++) {
+        int32_t xa = point_x(i);
+        int32_t xb = point_x(i + 1);
+        int32_t ya = point_y(self->_current[i]);
+        int32_t yb = point_y(self->_current[i + 1]);
+        int32_t lower = std::max(ya, yb);
+        if (ya != yb) {
+            fill_wedge.p[0] = { (lv_value_precise_t)xa, (lv_value_precise_t)ya };
+            fill_wedge.p[1] = { (lv_value_precise_t)xb, (lv_value_precise_t)yb };
+            fill_wedge.p[2] = { (lv_value_precise_t)(ya < yb ? xa : xb), (lv_value_precise_t)lower };
+            lv_draw_triangle(layer, &fill_wedge);
+        }
+        if (lower < coords.y2) {
+            lv_area_t area = { xa, lower, xb, coords.y2 };
+            lv_draw_rect(layer, &fill_rect, &area);
+        }
+    }
+
+    // Previous period under the current line so the current one reads on top
+    if (compare) {
+        line.color = lv_color_hex(PREVIOUS_LINE_COLOR);
+        for (size_t i = 0; i + 1 < count; i++) {
+            line.p1 = { (lv_value_precise_t)point_x(i), (lv_value_precise_t)point_y(self->_current[i] + self->_previous[i]) };
+            line.p2 = { (lv_value_precise_t)point_x(i + 1), (lv_value_precise_t)point_y(self->_current[i + 1] + self->_previous[i + 1]) };
+            lv_draw_line(layer, &line);
+        }
+    }
+
+    line.color = lv_color_hex(CURRENT_LINE_COLOR);
+    for (size_t i = 0; i + 1 < count; i++) {
+        line.p1 = { (lv_value_precise_t)point_x(i), (lv_value_precise_t)point_y(self->_current[i]) };
+        line.p2 = { (lv_value_precise_t)point_x(i + 1), (lv_value_precise_t)point_y(self->_current[i + 1]) };
+        lv_draw_line(layer, &line);
+    }
+}
+
+void AreaChartRenderer::clearElements() {
+    // Expected to be called from LVGL UI thread.
+    if (isValidLVGLObject(_chart)) {
+        lv_obj_del(_chart);
+    }
+    _chart = nullptr;
+    std::vector<int32_t>().swap(_current);
+    std::vector<int16_t>().swap(_previous);
+}
+
+bool AreaChartRenderer::areElementsValid() const {
+    return isValidLVGLObject(_chart);
+}
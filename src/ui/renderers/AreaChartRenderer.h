@@ -0,0 +1,50 @@
+#ifndef AREA_CHART_RENDERER_H
+#define AREA_CHART_RENDERER_H
+
+#include "InsightRendererBase.h"
+#include "../Style.h" // For styles, colors, fonts
+#include <vector>
+
+/**
+ * @class AreaChartRenderer
+ * @brief Draws a trends comparison: current period filled, previous as a line
+ *
+ * Both periods come from one SeriesSet, decimated together so they stay
+ * aligned, with the previous period kept as int16 deltas against the
+ * current one. Everything is painted by one object's draw handler.
+ */
+class AreaChartRenderer : public InsightRendererBase {
+public:
+    AreaChartRenderer();
+    ~AreaChartRenderer() override;
+
+    void createElements(lv_obj_t* parent_container) override;
+    void updateDisplay(const InsightData& data) override;
+    void clearElements() override;
+    bool areElementsValid() const override;
+
+    /**
+     * @brief Scale and decimate the current and previous periods for display
+     *
+     * Runs off the UI task, from InsightData::extract(). Both periods share
+     * one range and one decimation pass. set is left empty if the parser
+     * has no usable series.
+     */
+    static void prepareSeries(const InsightParser& parser, SeriesSet& set);
+
+    // Two pixels per segment: each segment costs a fill and two line draws
+    static constexpr size_t MAX_AREA_POINTS = 116;
+
+private:
+    static constexpr uint32_t CURRENT_LINE_COLOR = 0x2980b9;
+    static constexpr uint32_t CURRENT_FILL_COLOR = 0x0f3047;
+    static constexpr uint32_t PREVIOUS_LINE_COLOR = 0x7f8c8d;
+
+    LvObjHandle _chart;               // The only LVGL object; the periods are drawn
+    std::vector<int32_t> _current;    // Chart units, 0..LineGraphRenderer::CHART_Y_MAX
+    std::vector<int16_t> _previous;   // Previous minus current; empty without comparison
+
+    static void _draw_cb(lv_event_t* e);
+};
+
+#endif // AREA_CHART_RENDERER_H
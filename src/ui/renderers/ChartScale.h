@@ -0,0 +1,41 @@
+#ifndef CHART_SCALE_H
+#define CHART_SCALE_H
+
+#include <stdint.h>
+
+/**
+ * @class ChartScale
+ * @brief Maps a data range onto integer chart units
+ *
+ * Shared by the line and area renderers so every chart of a card uses the
+ * same y-axis rules. No Arduino or LVGL dependencies.
+ */
+class ChartScale {
+public:
+    // Chart Y range; well above the plot height so scaled points keep sub-pixel precision
+    static constexpr int32_t Y_MAX = 10000;
+
+    // Fraction of the range added above the top value
+    static constexpr double HEADROOM = 0.1;
+
+    /**
+     * @brief Compute the mapping for a data range
+     *
+     * The range always includes zero so counts keep their baseline and
+     * negative series get one, with headroom above the top value. Data maps
+     * to (value - offset) * scale in [0, Y_MAX].
+     */
+    static void compute(double min_value, double max_value, double* offset, double* scale) {
+        double low = min_value < 0.0 ? min_value : 0.0;
+        double high = max_value > 0.0 ? max_value : 0.0;
+        if (high <= low) {
+            high = low + 1.0; // All zero; draw along the baseline
+        }
+        high += (high - low) * HEADROOM; // So the peak doesn't touch the top edge
+
+        *offset = low;
+        *scale = Y_MAX / (high - low);
+    }
+};
+
+#endif // CHART_SCALE_H
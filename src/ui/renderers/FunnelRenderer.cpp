@@ -1,11 +1,19 @@
 #include "FunnelRenderer.h"
 #include "NumberFormat.h"
-#include <algorithm> // For std::min, std::max
+#include "../RenderProfiler.h"
+#include <algorithm> // For std::min, std::sort
+#include <string.h>
+
+const uint32_t FunnelRenderer::BREAKDOWN_COLORS[MAX_BREAKDOWNS] = {
+    0x2980b9,  // Blue
+    0x8e44ad,  // Purple
+    0xd35400,  // Orange
+    0xc0392b,  // Red
+    0x27ae60,  // Green
+};
 
 FunnelRenderer::FunnelRenderer()
-    : _funnel_main_container(nullptr) {
-    resetElementPointers();
-    initBreakdownColors(); // Initialize colors at construction
+    : _funnel(nullptr), _step_count(0), _steps{} {
     // Serial.println("[FunnelRenderer] Constructor");
 }
 
@@ -14,284 +22,175 @@ FunnelRenderer::~FunnelRenderer() {
     // Relies on InsightCard calling clearElements.
 }
 
-void FunnelRenderer::resetElementPointers() {
-    _funnel_main_container = nullptr;
-    for (int i = 0; i < MAX_FUNNEL_STEPS; ++i) {
-        _funnel_step_bars[i] = nullptr;
-        _funnel_step_labels[i] = nullptr;
-        for (int j = 0; j < MAX_BREAKDOWNS; ++j) {
-            _funnel_bar_segments[i][j] = nullptr;
-        }
-    }
-}
-
-void FunnelRenderer::initBreakdownColors() {
-    _breakdown_colors[0] = lv_color_hex(0x2980b9);  // Blue
-    _breakdown_colors[1] = lv_color_hex(0x8e44ad);  // Purple (was Green)
-    _breakdown_colors[2] = lv_color_hex(0xd35400);  // Orange (was Purple)
-    _breakdown_colors[3] = lv_color_hex(0xc0392b);  // Red (was Orange)
-    _breakdown_colors[4] = lv_color_hex(0x27ae60);  // Green (was Red)
-    // Ensure any unused slots get a default, though MAX_BREAKDOWNS should be respected
-    for (int i = 5; i < MAX_BREAKDOWNS; ++i) { // Should not run if MAX_BREAKDOWNS is 5
-        _breakdown_colors[i] = lv_color_hex(0x7f8c8d); // Gray for extra, if any
-    }
-}
-
 void FunnelRenderer::createElements(lv_obj_t* parent_container) {
     if (!isValidLVGLObject(parent_container)) {
         Serial.println("[FunnelRenderer-ERROR] Parent container invalid in createElements.");
         return;
     }
 
-    // Create a main container for all funnel elements within the parent_container
-    // This allows easier clearing and management.
-    _funnel_main_container = lv_obj_create(parent_container);
-    if (!_funnel_main_container) {
-        Serial.println("[FunnelRenderer-ERROR] Failed to create _funnel_main_container.");
+    _funnel = lv_obj_create(parent_container);
+    if (!_funnel) {
+        Serial.println("[FunnelRenderer-ERROR] Failed to create funnel object.");
         return;
     }
-    lv_obj_set_size(_funnel_main_container, lv_pct(100), lv_pct(100));
-    lv_obj_align(_funnel_main_container, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_obj_clear_flag(_funnel_main_container, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_style_pad_all(_funnel_main_container, 0, 0);
-    lv_obj_set_style_border_width(_funnel_main_container, 0, 0);
-    lv_obj_set_style_bg_opa(_funnel_main_container, LV_OPA_0, 0); // Transparent background
-
-    lv_coord_t available_width = lv_obj_get_content_width(_funnel_main_container);
-
-    for (int i = 0; i < MAX_FUNNEL_STEPS; ++i) {
-        // Create bar container (a simple object to hold segments)
-        _funnel_step_bars[i] = lv_obj_create(_funnel_main_container);
-        if (!_funnel_step_bars[i]) continue; // Error handling: skip if creation fails
-        
-        lv_obj_set_size(_funnel_step_bars[i], available_width, FUNNEL_BAR_HEIGHT);
-        lv_obj_set_style_bg_opa(_funnel_step_bars[i], LV_OPA_0, 0); // Transparent bar container
-        lv_obj_set_style_border_width(_funnel_step_bars[i], 0, 0);
-        lv_obj_set_style_pad_all(_funnel_step_bars[i], 0, 0);
-        lv_obj_clear_flag(_funnel_step_bars[i], LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN); // Initially hidden
-
-        // Create label for the step
-        _funnel_step_labels[i] = lv_label_create(_funnel_main_container);
-        if (!_funnel_step_labels[i]) continue;
-
-        lv_obj_set_style_text_color(_funnel_step_labels[i], Style::valueColor(), 0);
-        lv_obj_set_style_text_font(_funnel_step_labels[i], Style::valueFont(), 0);
-        lv_label_set_long_mode(_funnel_step_labels[i], LV_LABEL_LONG_DOT);
-        lv_obj_set_width(_funnel_step_labels[i], available_width);
-        lv_obj_set_height(_funnel_step_labels[i], FUNNEL_LABEL_HEIGHT);
-        lv_obj_add_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN); // Initially hidden
-
-        // Create segments within the bar container
-        for (int j = 0; j < MAX_BREAKDOWNS; ++j) {
-            _funnel_bar_segments[i][j] = lv_obj_create(_funnel_step_bars[i]);
-            if (!_funnel_bar_segments[i][j]) continue;
+    lv_obj_remove_style_all(_funnel);  // Transparent, no border or padding
+    lv_obj_set_size(_funnel, lv_pct(100), lv_pct(100));
+    lv_obj_align(_funnel, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_clear_flag(_funnel, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(_funnel, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_funnel, _draw_cb, LV_EVENT_DRAW_MAIN, this);
+    _step_count = 0;
+}
 
-            lv_obj_set_height(_funnel_bar_segments[i][j], FUNNEL_BAR_HEIGHT);
-            lv_obj_set_style_bg_color(_funnel_bar_segments[i][j], _breakdown_colors[j], 0);
-            lv_obj_set_style_border_width(_funnel_bar_segments[i][j], 0, 0);
-            lv_obj_set_style_radius(_funnel_bar_segments[i][j], 0, 0);
-            lv_obj_set_style_pad_all(_funnel_bar_segments[i][j], 0, 0);
-            lv_obj_add_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN); // Initially hidden
-        }
+void FunnelRenderer::fitLabel(char* text, const lv_font_t* font, int32_t max_width) {
+    size_t length = strlen(text);
+    if (lv_text_get_width(text, length, font, 0) <= max_width) return;
+
+    int32_t dots_width = lv_text_get_width("...", 3, font, 0);
+    // Step back whole UTF-8 characters so a multi-byte name isn't split
+    while (length > 0) {
+        do {
+            length--;
+        } while (length > 0 && (text[length] & 0xC0) == 0x80);
+        if (lv_text_get_width(text, length, font, 0) + dots_width <= max_width) break;
     }
-    // Serial.println("[FunnelRenderer] Funnel elements created successfully.");
+    if (length + 4 > LABEL_LENGTH) length = LABEL_LENGTH - 4;
+    strcpy(text + length, "...");
 }
 
-void FunnelRenderer::updateDisplay(InsightParser& parser, const String& title_str, const char* prefix, const char* suffix) {
-    // prefix and suffix are ignored for FunnelRenderer.
-    Serial.printf("[FunnelRenderer] updateDisplay for title: %s\n", title_str.c_str()); // Verify this is called
-
-    size_t raw_step_count = parser.getFunnelStepCount();
-    size_t raw_breakdown_count = parser.getFunnelBreakdownCount();
-    Serial.printf("[FunnelRenderer] Parser reports: step_count = %u, breakdown_count = %u\n",
-                  (unsigned int)raw_step_count, (unsigned int)raw_breakdown_count);
-
-    size_t step_count = std::min(raw_step_count, static_cast<size_t>(MAX_FUNNEL_STEPS));
-    size_t breakdown_count = std::min(raw_breakdown_count, static_cast<size_t>(MAX_BREAKDOWNS));
-    Serial.printf("[FunnelRenderer] Effective: step_count = %u, breakdown_count = %u\n",
-                  (unsigned int)step_count, (unsigned int)breakdown_count);
-
-    if (step_count == 0) {
-        Serial.println("[FunnelRenderer] step_count is 0, hiding elements.");
-        // No steps, clear display or show message
-        dispatchToUI([this]() {
-            if (!areElementsValid()) return;
-            for (int i = 0; i < MAX_FUNNEL_STEPS; ++i) {
-                if (isValidLVGLObject(_funnel_step_bars[i])) lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
-                if (isValidLVGLObject(_funnel_step_labels[i])) lv_obj_add_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
-            }
-        });
+void FunnelRenderer::updateDisplay(const InsightData& data) {
+    // InsightCard applies parsed data on the LVGL task, which is also where
+    // _draw_cb reads the step table, so it is rebuilt in place.
+    if (!areElementsValid()) {
+        Serial.println("[FunnelRenderer-WARN] Funnel object invalid in updateDisplay.");
         return;
     }
+#if RENDER_PROFILER
+    uint32_t start_us = micros();
+#endif
 
-    uint32_t step_counts_total[MAX_FUNNEL_STEPS] = {0};
-    // Conversion rates not directly used for display here, but parser might need it.
-    if (!parser.getFunnelTotalCounts(0, step_counts_total, nullptr)) {
-        Serial.println("[FunnelRenderer-ERROR] Failed to get funnel total counts from parser.");
-        return;
-    }
+    size_t step_count = std::min<size_t>(data.funnelStepCount, MAX_FUNNEL_STEPS);
+    size_t breakdown_count = std::min<size_t>(data.funnelBreakdownCount, MAX_BREAKDOWNS);
 
-    uint32_t total_first_step = step_counts_total[0];
-    Serial.printf("[FunnelRenderer] total_first_step = %u\n", (unsigned int)total_first_step);
-    if (total_first_step == 0 && step_count > 0) { // Allow processing if step_count is 0 (handled above)
-        Serial.println("[FunnelRenderer-WARN] First funnel step count is zero. Funnel will appear empty or scaled strangely.");
-        // To avoid division by zero later, if we must proceed, set to 1, but data is effectively empty.
-        // total_first_step = 1; // Or, clear display as above.
+    uint32_t total_first_step = step_count > 0 ? data.funnelSteps[0].total : 0;
+    if (total_first_step == 0 && step_count > 0) {
+        Serial.println("[FunnelRenderer-WARN] First funnel step count is zero. Funnel will appear empty.");
     }
 
-    // Prepare data structure for UI update lambda
-    struct FunnelStepUIData {
-        String label_text;
-        float relative_width_to_first_step; // 0.0 - 1.0
-        struct SegmentUIData {
-            float width_pixels; 
-            float offset_pixels; 
-            lv_color_t color; // Added to store color for sorted segments
-        } segments[MAX_BREAKDOWNS];
-    };
-    std::vector<FunnelStepUIData> ui_steps_data(step_count);
-
-    lv_coord_t available_width_for_bars = lv_obj_get_content_width(_funnel_main_container);
+    lv_coord_t bar_width = std::min<lv_coord_t>(lv_obj_get_content_width(_funnel), UINT8_MAX);
+    const lv_font_t* font = Style::valueFont();
 
     for (size_t i = 0; i < step_count; ++i) {
-        FunnelStepUIData& current_ui_step = ui_steps_data[i];
-        current_ui_step.relative_width_to_first_step = (total_first_step > 0) ? 
-            static_cast<float>(step_counts_total[i]) / total_first_step : 0.0f;
+        Step& step = _steps[i];
+        const InsightData::FunnelStep& source = data.funnelSteps[i];
+        float relative_width = (total_first_step > 0) ?
+            static_cast<float>(source.total) / total_first_step : 0.0f;
 
-        char step_name_buffer[64] = {0};
-        parser.getFunnelStepData(0, i, step_name_buffer, sizeof(step_name_buffer), nullptr, nullptr, nullptr);
-        
         char number_buffer[20];
-        NumberFormat::addThousandsSeparators(number_buffer, sizeof(number_buffer), step_counts_total[i]);
+        NumberFormat::addThousandsSeparators(number_buffer, sizeof(number_buffer), source.total);
 
-        // New label formatting logic
         uint32_t percentage_val = 0;
         if (total_first_step > 0) {
-            percentage_val = (step_counts_total[i] * 100) / total_first_step;
+            percentage_val = (uint32_t)(((uint64_t)source.total * 100) / total_first_step);
         }
 
-        String new_label_format = "";
-        if (percentage_val == 100 && i == 0) { // Only omit for the first step if it's 100%
-            new_label_format = String(number_buffer);
+        // Omit the percentage only for a first step at 100%
+        int written;
+        if (percentage_val == 100 && i == 0) {
+            written = snprintf(step.label, sizeof(step.label), "%s", number_buffer);
         } else {
-            new_label_format = String(percentage_val) + "% - " + String(number_buffer);
+            written = snprintf(step.label, sizeof(step.label), "%lu%% - %s", (unsigned long)percentage_val, number_buffer);
         }
-
-        if (step_name_buffer[0] != '\0') {
-            new_label_format += " - ";
-            new_label_format += step_name_buffer;
+        if (source.name[0] != '\0' && written > 0 && (size_t)written < sizeof(step.label)) {
+            snprintf(step.label + written, sizeof(step.label) - written, " - %s", source.name);
         }
-        current_ui_step.label_text = new_label_format;
-
-        // Calculate breakdown segments for this step
-        uint32_t breakdown_val_counts[MAX_BREAKDOWNS] = {0};
-        if (parser.getFunnelBreakdownComparison(i, breakdown_val_counts, nullptr) && step_counts_total[i] > 0) {
-            float total_width_for_this_step_bar = available_width_for_bars * current_ui_step.relative_width_to_first_step;
-            float current_offset = 0.0f;
-
-            // Create a vector of {count, original_index} to sort breakdowns
-            std::vector<std::pair<uint32_t, int>> sorted_breakdowns_info;
-            for (size_t k = 0; k < breakdown_count; ++k) {
-                sorted_breakdowns_info.push_back({breakdown_val_counts[k], (int)k});
-            }
-
-            // Sort descending by count (largest first)
-            std::sort(sorted_breakdowns_info.begin(), sorted_breakdowns_info.end(), [](const auto& a, const auto& b) {
-                return a.first > b.first; 
+        fitLabel(step.label, font, bar_width - 1);
+
+        // Breakdown segments, largest first, keeping each breakdown's colour
+        step.segment_count = 0;
+        const uint32_t* breakdown_val_counts = source.breakdowns;
+        if (source.hasBreakdowns && source.total > 0) {
+            uint8_t order[MAX_BREAKDOWNS];
+            for (size_t k = 0; k < breakdown_count; ++k) order[k] = (uint8_t)k;
+            std::sort(order, order + breakdown_count, [&](uint8_t a, uint8_t b) {
+                return breakdown_val_counts[a] > breakdown_val_counts[b];
             });
 
+            float step_bar_width = bar_width * relative_width;
+            float offset = 0.0f;
             for (size_t k = 0; k < breakdown_count; ++k) {
-                uint32_t current_segment_count = sorted_breakdowns_info[k].first;
-                int original_segment_index = sorted_breakdowns_info[k].second;
-
-                float segment_percentage_of_step = static_cast<float>(current_segment_count) / step_counts_total[i];
-                float segment_width_pixels = total_width_for_this_step_bar * segment_percentage_of_step;
-                
-                current_ui_step.segments[k].width_pixels = segment_width_pixels;
-                current_ui_step.segments[k].offset_pixels = current_offset;
-                current_ui_step.segments[k].color = _breakdown_colors[original_segment_index]; // Assign color based on original index
-                current_offset += segment_width_pixels;
+                float width = step_bar_width * breakdown_val_counts[order[k]] / source.total;
+                int pixels = static_cast<int>(width);
+                // Ensure visible segments have at least 1px width if they have any data
+                if (pixels == 0 && width > 0) pixels = 1;
+                if (pixels > 0) {
+                    Segment& segment = step.segments[step.segment_count++];
+                    segment.offset = (uint8_t)std::min<int>(static_cast<int>(offset), UINT8_MAX);
+                    segment.width = (uint8_t)std::min<int>(pixels, UINT8_MAX - segment.offset);
+                    segment.color = order[k];
+                }
+                offset += width;
             }
         }
     }
+    _step_count = (uint8_t)step_count;
 
-    // Dispatch UI update
-    dispatchToUI([this, captured_steps_data = std::move(ui_steps_data), step_count, breakdown_count, available_width_for_bars]() {
-        if (!areElementsValid()) {
-            Serial.println("[FunnelRenderer-WARN] Funnel elements invalid in updateDisplay lambda.");
-            return;
-        }
-
-        int y_offset = 0;
-        for (size_t i = 0; i < step_count; ++i) {
-            const auto& step_data = captured_steps_data[i];
-
-            if (isValidLVGLObject(_funnel_step_bars[i])) {
-                lv_obj_clear_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
-                lv_obj_align(_funnel_step_bars[i], LV_ALIGN_TOP_LEFT, 0, y_offset);
-                // Ensure the bar container is set to the full available width before placing segments
-                lv_obj_set_width(_funnel_step_bars[i], available_width_for_bars); 
-
-                for (size_t j = 0; j < breakdown_count; ++j) {
-                    if (isValidLVGLObject(_funnel_bar_segments[i][j])) {
-                        int seg_width = static_cast<int>(step_data.segments[j].width_pixels);
-                        // Ensure visible segments have at least 1px width if they have any data
-                        if (seg_width == 0 && step_data.segments[j].width_pixels > 0) seg_width = 1;
-
-                        if (seg_width > 0) {
-                            lv_obj_set_size(_funnel_bar_segments[i][j], seg_width, FUNNEL_BAR_HEIGHT);
-                            lv_obj_align(_funnel_bar_segments[i][j], LV_ALIGN_LEFT_MID, static_cast<int>(step_data.segments[j].offset_pixels), 0);
-                            lv_obj_set_style_bg_color(_funnel_bar_segments[i][j], step_data.segments[j].color, 0); // Use stored color
-                            lv_obj_clear_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
-                        } else {
-                            lv_obj_add_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
-                        }
-                    }
-                }
-                // Hide unused segments for this step
-                for (size_t j = breakdown_count; j < MAX_BREAKDOWNS; ++j) {
-                     if (isValidLVGLObject(_funnel_bar_segments[i][j])) {
-                        lv_obj_add_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
-                    }
-                }
-            }
+    lv_obj_invalidate(_funnel);
+#if RENDER_PROFILER
+    Serial.printf("[FunnelRenderer] %u steps, %u breakdowns updated in %lu us\n",
+                  (unsigned int)step_count, (unsigned int)breakdown_count, (unsigned long)(micros() - start_us));
+#endif
+}
 
-            if (isValidLVGLObject(_funnel_step_labels[i])) {
-                lv_obj_set_width(_funnel_step_labels[i], available_width_for_bars); // Ensure label width is updated
-                lv_label_set_text(_funnel_step_labels[i], step_data.label_text.c_str());
-                lv_obj_clear_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
-                lv_obj_align(_funnel_step_labels[i], LV_ALIGN_TOP_LEFT, 1, y_offset + FUNNEL_BAR_HEIGHT + 2); // +2 for small gap
-            }
-            y_offset += FUNNEL_BAR_HEIGHT + FUNNEL_BAR_GAP;
+void FunnelRenderer::_draw_cb(lv_event_t* e) {
+    FunnelRenderer* self = static_cast<FunnelRenderer*>(lv_event_get_user_data(e));
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    lv_layer_t* layer = lv_event_get_layer(e);
+    if (self->_step_count == 0) return;
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+
+    lv_draw_rect_dsc_t bar;
+    lv_draw_rect_dsc_init(&bar);
+    bar.radius = 0;
+    bar.bg_opa = LV_OPA_COVER;
+
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    label.font = Style::valueFont();
+    label.color = Style::valueColor();
+
+    int32_t y = coords.y1;
+    for (uint8_t i = 0; i < self->_step_count; i++) {
+        const Step& step = self->_steps[i];
+        for (uint8_t k = 0; k < step.segment_count; k++) {
+            const Segment& segment = step.segments[k];
+            lv_area_t area = { coords.x1 + segment.offset, y,
+                               coords.x1 + segment.offset + segment.width - 1, y + FUNNEL_BAR_HEIGHT - 1 };
+            bar.bg_color = lv_color_hex(BREAKDOWN_COLORS[segment.color]);
+            lv_draw_rect(layer, &bar, &area);
         }
 
-        // Hide unused steps (bars and labels)
-        for (size_t i = step_count; i < MAX_FUNNEL_STEPS; ++i) {
-            if (isValidLVGLObject(_funnel_step_bars[i])) lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
-            if (isValidLVGLObject(_funnel_step_labels[i])) lv_obj_add_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
-        }
-        
-        // Optional: force refresh
-        // lv_obj_invalidate(_funnel_main_container); // Invalidate the specific container
-        // lv_display_t* disp = lv_display_get_default();
-        // if (disp) { lv_refr_now(disp); }
+        // The label buffer outlives the frame, so LVGL can draw from it directly
+        int32_t label_y = y + FUNNEL_BAR_HEIGHT + 2;  // +2 for small gap
+        lv_area_t label_area = { coords.x1 + 1, label_y, coords.x2, label_y + FUNNEL_LABEL_HEIGHT - 1 };
+        label.text = step.label;
+        lv_draw_label(layer, &label, &label_area);
 
-    }, true); // Send to front for responsiveness
+        y += FUNNEL_BAR_HEIGHT + FUNNEL_BAR_GAP;
+    }
 }
 
 void FunnelRenderer::clearElements() {
     // Expected to be called from LVGL UI thread.
-    // Serial.println("[FunnelRenderer] Clearing elements.");
-    if (isValidLVGLObject(_funnel_main_container)) {
-        lv_obj_del(_funnel_main_container); // Deletes main container and all its children
+    if (isValidLVGLObject(_funnel)) {
+        lv_obj_del(_funnel);
     }
-    // All pointers to children are now invalid and should be nullified.
-    resetElementPointers();
+    _funnel = nullptr;
+    _step_count = 0;
 }
 
 bool FunnelRenderer::areElementsValid() const {
-    // A basic check. If main container is valid, assume its children were created (or are correctly null).
-    // More thorough checks could iterate all element pointers if needed.
-    return isValidLVGLObject(_funnel_main_container);
-} 
\ No newline at end of file
+    return isValidLVGLObject(_funnel);
+}
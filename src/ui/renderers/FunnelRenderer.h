@@ -4,15 +4,22 @@
 #include "InsightRendererBase.h"
 #include "../Style.h" // For styles, colors, fonts
 #include "NumberFormat.h" // Corrected path for number formatting
-#include <vector> // May need for storing step data if complex
 
+/**
+ * @class FunnelRenderer
+ * @brief Draws a funnel insight as one LVGL object
+ *
+ * Bars, breakdown segments and step labels are painted from a packed
+ * per-step table in an LV_EVENT_DRAW_MAIN handler, so a funnel costs one
+ * lv_obj plus the table, and a data update is a single invalidate.
+ */
 class FunnelRenderer : public InsightRendererBase {
 public:
     FunnelRenderer();
     ~FunnelRenderer() override;
 
     void createElements(lv_obj_t* parent_container) override;
-    void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) override;
+    void updateDisplay(const InsightData& data) override;
     void clearElements() override;
     bool areElementsValid() const override;
 
@@ -22,21 +29,32 @@ private:
     static constexpr int MAX_BREAKDOWNS = 5;       
     static constexpr int FUNNEL_BAR_HEIGHT = 5;    
     static constexpr int FUNNEL_BAR_GAP = 24;      
-    // static constexpr int FUNNEL_LEFT_MARGIN = 0; // Might not be needed if aligning within container
     static constexpr int FUNNEL_LABEL_HEIGHT = 20; // Restored to original value, as 15 might be too small for Style::valueFont()
+    static constexpr size_t LABEL_LENGTH = 48;
 
-    lv_obj_t* _funnel_main_container; // A container created by this renderer within parent_container
-    
-    // Arrays for LVGL objects
-    lv_obj_t* _funnel_step_bars[MAX_FUNNEL_STEPS];
-    lv_obj_t* _funnel_step_labels[MAX_FUNNEL_STEPS];
-    lv_obj_t* _funnel_bar_segments[MAX_FUNNEL_STEPS][MAX_BREAKDOWNS];
-    lv_color_t _breakdown_colors[MAX_BREAKDOWNS];
+    // One bar segment, in pixels from the left of the bar
+    struct Segment {
+        uint8_t offset;
+        uint8_t width;
+        uint8_t color;  // Index into BREAKDOWN_COLORS
+    };
 
-    void initBreakdownColors();
+    struct Step {
+        uint8_t segment_count;
+        Segment segments[MAX_BREAKDOWNS];
+        char label[LABEL_LENGTH];  // Already shortened to fit the width
+    };
 
-    // Helper to reset all element pointers to nullptr
-    void resetElementPointers();
+    static const uint32_t BREAKDOWN_COLORS[MAX_BREAKDOWNS];
+
+    LvObjHandle _funnel;  // The only LVGL object; everything else is drawn
+    uint8_t _step_count;
+    Step _steps[MAX_FUNNEL_STEPS];
+
+    static void _draw_cb(lv_event_t* e);
+
+    // Cut text with "..." until it fits max_width in font
+    static void fitLabel(char* text, const lv_font_t* font, int32_t max_width);
 };
 
-#endif // FUNNEL_RENDERER_H 
\ No newline at end of file
+#endif // FUNNEL_RENDERER_H
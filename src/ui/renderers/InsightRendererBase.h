@@ -2,11 +2,11 @@
 #define INSIGHT_RENDERER_BASE_H
 
 #include "lvgl.h"
-#include "../../posthog/parsers/InsightParser.h" // Adjusted path
+#include "../InsightData.h" // Display model the renderers draw from
 #include <Arduino.h> // For String, if used in titles or other data
 #include <functional> // For std::function
 
-#include "../UICallback.h" // For global dispatch function
+#include "../LvObjHandle.h" // For O(1) object validity checks
 
 /**
  * @class InsightRendererBase
@@ -24,12 +24,12 @@
  * If a renderer's `updateDisplay` method relies on the final, calculated dimensions of 
  * elements just created in its `createElements` method (e.g., to size or position 
  * children accurately), it's crucial to ensure LVGL has processed these layouts.
- * In the `InsightCard` (which manages these renderers), a forced refresh 
- * (e.g., `lv_obj_invalidate()` on the container followed by `lv_refr_now()`) 
- * is performed *between* calling `createElements()` and `updateDisplay()`.
- * This allows `updateDisplay()` to work with more reliable, up-to-date element dimensions.
- * Failure to account for this can lead to elements appearing incorrectly sized, 
- * misplaced, or not appearing until a later, unrelated refresh cycle.
+ * In the `InsightCard` (which manages these renderers), `lv_obj_update_layout()` 
+ * is called on the content container *between* `createElements()` and `updateDisplay()`.
+ * This resolves positions and sizes without rendering, so `updateDisplay()` sees 
+ * up-to-date element dimensions. Renderers that need layout at another point should 
+ * do the same; never call `lv_refr_now()`, which renders and flushes the whole 
+ * screen synchronously on the UI thread.
  */
 class InsightRendererBase {
 public:
@@ -45,16 +45,17 @@ public:
     virtual void createElements(lv_obj_t* parent_container) = 0;
 
     /**
-     * @brief Updates the display with new data from the parser.
-     * This method will be called when new data for the insight is received.
-     * The renderer is responsible for dispatching its internal LVGL calls to the UI thread.
+     * @brief Updates the display with new data.
+     * Called on the LVGL UI thread when new data for the insight is received,
+     * and again when the card is rebuilt after being dematerialized.
      * 
-     * @param parser The InsightParser instance containing the new data.
-     * @param title The title of the insight.
-     * @param prefix The prefix to prepend to the title.
-     * @param suffix The suffix to append to the title.
+     * InsightCard keeps data alive until the next updateDisplay() or
+     * clearElements(), so renderers may point LVGL at its arrays instead
+     * of copying them.
+     * 
+     * @param data Display model extracted from the parsed insight.
      */
-    virtual void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) = 0;
+    virtual void updateDisplay(const InsightData& data) = 0;
 
     /**
      * @brief Clears/deletes all UI elements created by this renderer.
@@ -71,16 +72,12 @@ public:
     virtual bool areElementsValid() const = 0;
 
 protected:
-    // Helper to dispatch UI updates to the LVGL task using global dispatch function
-    static void dispatchToUI(std::function<void()> func, bool to_front = false) {
-        if (globalUIDispatch) {
-            globalUIDispatch(std::move(func), to_front);
-        } else {
-            Serial.println("[UI-ERROR] Global UI dispatch not set, cannot dispatch UI update.");
-        }
+    // Helper to check LVGL object validity (can be used by derived classes).
+    // Prefer handles: the raw pointer overload walks the whole object tree.
+    static bool isValidLVGLObject(const LvObjHandle& handle) {
+        return handle.isValid();
     }
 
-    // Helper to check LVGL object validity (can be used by derived classes)
     static bool isValidLVGLObject(lv_obj_t* obj) {
         return obj && lv_obj_is_valid(obj);
     }
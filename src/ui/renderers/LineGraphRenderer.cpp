@@ -1,9 +1,16 @@
 #include "LineGraphRenderer.h"
-#include <memory> // For std::unique_ptr for data arrays
-#include <algorithm> // For std::min
+#include "SeriesPacker.h"
+
+const uint32_t LineGraphRenderer::SERIES_COLORS[SeriesSet::MAX_SERIES] = {
+    0x2980b9,  // Blue
+    0x8e44ad,  // Purple
+    0xd35400,  // Orange
+    0xc0392b,  // Red
+    0x27ae60,  // Green
+};
 
 LineGraphRenderer::LineGraphRenderer()
-    : _chart(nullptr), _series(nullptr) {
+    : _chart(nullptr), _series{}, _series_count(0), _no_point(LV_CHART_POINT_NONE) {
     // Serial.println("[LineGraphRenderer] Constructor");
 }
 
@@ -41,8 +48,8 @@ void LineGraphRenderer::createElements(lv_obj_t* parent_container) {
     // Remove padding from the chart itself to use full area
     lv_obj_set_style_pad_all(_chart, 0, LV_PART_MAIN);
 
-    _series = lv_chart_add_series(_chart, lv_color_hex(0x2980b9), LV_CHART_AXIS_PRIMARY_Y);
-    if (!_series) {
+    _series_count = 0;
+    if (!setSeriesCount(1)) {
         Serial.println("[LineGraphRenderer-ERROR] Failed to create chart series.");
         lv_obj_del(_chart); // Clean up chart if series fails
         _chart = nullptr;
@@ -57,87 +64,66 @@ void LineGraphRenderer::createElements(lv_obj_t* parent_container) {
     // InsightCard will do a global refresh after calling createElements if needed.
 }
 
-void LineGraphRenderer::updateDisplay(InsightParser& parser, const String& title, const char* prefix, const char* suffix) {
-    // Title is handled by InsightCard. This renderer updates the chart data.
-    // prefix and suffix are ignored for LineGraphRenderer.
-    size_t point_count = parser.getSeriesPointCount();
-    if (point_count == 0) {
-        // No data points, maybe clear the chart or show a message?
-        // For now, clear existing points if any.
-        dispatchToUI([this]() {
-            if (isValidLVGLObject(_chart) && _series) {
-                lv_chart_set_point_count(_chart, 0);
-                lv_chart_refresh(_chart);
-            }
-        });
+void LineGraphRenderer::prepareSeries(const InsightParser& parser, SeriesSet& set) {
+    if (!SeriesPacker::packLines(parser, set, MAX_DISPLAY_POINTS)) {
         return;
     }
-
-    // Allocate memory for Y values from the parser
-    // Using unique_ptr for automatic memory management.
-    std::unique_ptr<double[]> y_values_from_parser(new double[point_count]);
-    if (!parser.getSeriesYValues(y_values_from_parser.get())) {
-        Serial.println("[LineGraphRenderer-ERROR] Failed to get Y series values from parser.");
-        return;
+    for (size_t s = 0; s < set.seriesCount; s++) {
+        set.colors[s] = SERIES_COLORS[s];
     }
+}
 
-    // Find max value for scaling (logic from original InsightCard)
-    double max_val = 0.0;
-    if (point_count > 0) {
-        max_val = y_values_from_parser[0];
-        for (size_t i = 1; i < point_count; ++i) {
-            if (y_values_from_parser[i] > max_val) max_val = y_values_from_parser[i];
-        }
+bool LineGraphRenderer::setSeriesCount(uint8_t count) {
+    while (_series_count > count) {
+        lv_chart_remove_series(_chart, _series[--_series_count]);
+        _series[_series_count] = nullptr;
     }
-    // Ensure max_val is not zero to avoid division by zero; if all values are <=0, chart range needs care.
-    if (max_val <= 0) max_val = 1.0; // Default to 1 if all data is zero or negative to prevent scaling issues.
-
-    double scale_factor = (max_val > 1000.0) ? (1000.0 / max_val) : 1.0;
-
-    // Copy data for the UI thread: Capture y_values_from_parser by moving its contents to a shared_ptr.
-    // This is because the lambda might outlive the current scope.
-    // The parser itself is passed by reference but assumed to be valid during the lambda's queuing/execution
-    // due to the shared_ptr in InsightCard::handleParsedData.
-    
-    // To pass the array safely to the lambda, we copy it into a structure that can be captured.
-    // A std::vector is easier to capture by value for lambdas.
-    std::vector<double> values_for_lambda(point_count);
-    for(size_t i = 0; i < point_count; ++i) {
-        values_for_lambda[i] = y_values_from_parser[i];
-    }
-
-    dispatchToUI([this, captured_values = std::move(values_for_lambda), point_count, max_val, scale_factor]() {
-        if (!areElementsValid()) {
-            Serial.println("[LineGraphRenderer-WARN] Chart/Series invalid in updateDisplay lambda.");
-            return;
+    while (_series_count < count) {
+        lv_chart_series_t* series = lv_chart_add_series(_chart, lv_color_hex(SERIES_COLORS[_series_count]),
+                                                        LV_CHART_AXIS_PRIMARY_Y);
+        if (!series) {
+            return false;
         }
+        _series[_series_count++] = series;
+    }
+    return true;
+}
 
-        // Limit display points for performance/readability if desired, though original fix was to show all.
-        // const size_t display_points = std::min(point_count, static_cast<size_t>(50)); // Example: Max 50 points
-        const size_t display_points = point_count; // Show all points as per previous fixes
-
-        lv_chart_set_point_count(_chart, display_points);
-        // lv_chart_set_all_value(_chart, _series, 0); // Zero out before setting new values
+void LineGraphRenderer::updateDisplay(const InsightData& data) {
+    // Title is handled by InsightCard. This renderer updates the chart data.
+    //
+    // The chart reads the model's y array directly; InsightCard keeps the
+    // model until the next update or clearElements(). LVGL only writes an
+    // external array through lv_chart_set_value_by_id and friends, which
+    // are never called here, so dropping const is safe.
+    if (!areElementsValid()) {
+        Serial.println("[LineGraphRenderer-WARN] Chart/Series invalid in updateDisplay.");
+        return;
+    }
 
-        for (size_t i = 0; i < display_points; ++i) {
-            int16_t y_val = static_cast<int16_t>(captured_values[i] * scale_factor);
-            // LVGL chart y-values are typically positive. If your data can be negative,
-            // you might need to adjust the range and how y_val is calculated.
-            lv_chart_set_value_by_id(_chart, _series, i, y_val);
+    const SeriesSet& set = data.series;
+    if (set.empty()) {
+        // The previous model may be gone; leave nothing pointing into it
+        for (uint8_t s = 0; s < _series_count; s++) {
+            lv_chart_set_ext_y_array(_chart, _series[s], &_no_point);
         }
-
-        // Set chart range dynamically
-        // LVGL charts typically handle positive values. If your data min is negative or very different,
-        // the Y-axis range (lv_chart_set_range) needs to be set carefully.
-        // For simplicity, assuming positive values and scaling towards a max of ~1000 * 1.1 on chart.
-        lv_chart_set_range(_chart, LV_CHART_AXIS_PRIMARY_Y, 0, static_cast<int32_t>(max_val * scale_factor * 1.1));
-        
+        lv_chart_set_point_count(_chart, 1);
         lv_chart_refresh(_chart);
+        return;
+    }
 
-        // Optional: Force a global display refresh if needed, though InsightCard might handle it.
-        // lv_display_t* disp = lv_display_get_default();
-        // if (disp) { lv_refr_now(disp); }
-    }, true); // Send to front to prioritize data update rendering
+    if (!setSeriesCount(set.seriesCount)) {
+        Serial.println("[LineGraphRenderer-ERROR] Failed to create chart series.");
+    }
+
+    // Rebind every time: each update brings a new model
+    for (uint8_t s = 0; s < _series_count; s++) {
+        lv_chart_set_series_color(_chart, _series[s], lv_color_hex(set.colors[s]));
+        lv_chart_set_ext_y_array(_chart, _series[s], const_cast<int32_t*>(set.series(s)));
+    }
+    lv_chart_set_point_count(_chart, set.pointCount);
+    lv_chart_set_range(_chart, LV_CHART_AXIS_PRIMARY_Y, 0, CHART_Y_MAX);
+    lv_chart_refresh(_chart);
 }
 
 void LineGraphRenderer::clearElements() {
@@ -146,10 +132,14 @@ void LineGraphRenderer::clearElements() {
         lv_obj_del(_chart); // This also deletes series associated with the chart
     }
     _chart = nullptr;
-    _series = nullptr; // Series is owned by chart, but good to nullify pointer.
+    // Series are owned by the chart, but good to nullify pointers.
+    for (uint8_t s = 0; s < SeriesSet::MAX_SERIES; s++) {
+        _series[s] = nullptr;
+    }
+    _series_count = 0;
 }
 
 bool LineGraphRenderer::areElementsValid() const {
     // Can be called from any thread.
-    return isValidLVGLObject(_chart) && _series; // Series validity is tied to chart, but check both for clarity.
+    return isValidLVGLObject(_chart) && _series_count > 0; // Series validity is tied to chart, but check both for clarity.
 } 
\ No newline at end of file
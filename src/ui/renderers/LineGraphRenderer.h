@@ -2,22 +2,54 @@
 #define LINE_GRAPH_RENDERER_H
 
 #include "InsightRendererBase.h"
+#include "ChartScale.h"
 #include "../Style.h" // For styles, colors, fonts
-// NumberFormat might not be directly needed here if data comes pre-formatted or scaling is internal
 
+/**
+ * @class LineGraphRenderer
+ * @brief Draws every series of a trends insight on one chart
+ *
+ * Series come pre-scaled and decimated in a SeriesSet. Each chart series
+ * is bound to its run of the set's y array, which InsightCard keeps alive
+ * with the model, so no points are copied.
+ */
 class LineGraphRenderer : public InsightRendererBase {
 public:
     LineGraphRenderer();
     ~LineGraphRenderer() override;
 
     void createElements(lv_obj_t* parent_container) override;
-    void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) override;
+    void updateDisplay(const InsightData& data) override;
     void clearElements() override;
     bool areElementsValid() const override;
 
+    /**
+     * @brief Scale and decimate line graph series for display
+     *
+     * Runs off the UI task, from InsightData::extract(). SeriesPacker packs
+     * up to SeriesSet::MAX_SERIES series over one range; series longer than
+     * MAX_DISPLAY_POINTS keep each bucket's min and max so spikes survive.
+     * set is left empty if the parser has no usable series.
+     */
+    static void prepareSeries(const InsightParser& parser, SeriesSet& set);
+
+    // Chart Y range shared with the area renderer; see ChartScale
+    static constexpr int32_t CHART_Y_MAX = ChartScale::Y_MAX;
+
+    // One point per pixel column of the widest chart the card can show
+    static constexpr size_t MAX_DISPLAY_POINTS = 230;
+
+    // Series colours in order; the first matches the single-series chart
+    static const uint32_t SERIES_COLORS[SeriesSet::MAX_SERIES];
+
 private:
-    lv_obj_t* _chart;           // LVGL chart object
-    lv_chart_series_t* _series; // LVGL chart series object
+    LvObjHandle _chart;         // LVGL chart object
+    lv_chart_series_t* _series[SeriesSet::MAX_SERIES]; // LVGL chart series, first _series_count in use
+    uint8_t _series_count;
+    int32_t _no_point;          // Bound while there is no data; LVGL keeps at least one point
+
+    // Add or remove chart series until there are count of them
+    bool setSeriesCount(uint8_t count);
 
     // Constants for chart appearance - can be defined here or moved to Style.h if more global
     // For now, keeping them local to the renderer.
@@ -4,6 +4,7 @@
 #include "InsightRendererBase.h"
 #include "../Style.h" // Assuming Style.h is in src/ui/
 #include "NumberFormat.h" // Corrected path based on file search
+#include "../NumericDisplay.h"
 
 class NumericCardRenderer : public InsightRendererBase {
 public:
@@ -11,18 +12,13 @@ public:
     ~NumericCardRenderer() override;
 
     void createElements(lv_obj_t* parent_container) override;
-    void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) override;
+    void updateDisplay(const InsightData& data) override;
     void clearElements() override;
     bool areElementsValid() const override;
 
 private:
-    lv_obj_t* _value_label; // LVGL label object for displaying the numeric value
+    NumericDisplay _value_display; // Value readout; redraws only the digits that change
     // Title is handled by InsightCard itself, this renderer only cares about the value display.
-
-    // Helper to format numbers (can be static or instance method)
-    // If NumberFormat utility is comprehensive, this might not be needed here.
-    // For now, assuming a local helper or direct use of NumberFormat.
-    void formatNumericValue(double value, char* buffer, size_t buffer_size);
 };
 
-#endif // NUMERIC_CARD_RENDERER_H 
\ No newline at end of file
+#endif // NUMERIC_CARD_RENDERER_H
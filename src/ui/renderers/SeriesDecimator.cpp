@@ -0,0 +1,80 @@
+#include "SeriesDecimator.h"
+
+size_t SeriesDecimator::minMax(int32_t* values, size_t count, size_t max_points) {
+    if (!values || count <= max_points || max_points < 2) {
+        return count;
+    }
+
+    // Bucket b spans [b * count / buckets, (b + 1) * count / buckets). Every
+    // bucket holds at least two points, so writing two results for bucket b
+    // never overtakes the start of bucket b + 1.
+    const size_t buckets = max_points / 2;
+    size_t out = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        size_t start = b * count / buckets;
+        size_t end = (b + 1) * count / buckets;
+
+        size_t min_index = start;
+        size_t max_index = start;
+        for (size_t i = start + 1; i < end; i++) {
+            if (values[i] < values[min_index]) min_index = i;
+            if (values[i] > values[max_index]) max_index = i;
+        }
+
+        int32_t min_value = values[min_index];
+        int32_t max_value = values[max_index];
+        if (min_index <= max_index) {
+            values[out++] = min_value;
+            values[out++] = max_value;
+        } else {
+            values[out++] = max_value;
+            values[out++] = min_value;
+        }
+    }
+    return out;
+}
+
+size_t SeriesDecimator::minMaxPair(int32_t* a, int32_t* b, size_t count, size_t max_points, uint16_t* x) {
+    if (!a || !b) {
+        return 0;
+    }
+    if (count <= max_points || max_points < 2) {
+        for (size_t i = 0; x && i < count; i++) {
+            x[i] = (uint16_t)i;
+        }
+        return count;
+    }
+
+    const size_t buckets = max_points / 2;
+    size_t out = 0;
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        size_t start = bucket * count / buckets;
+        size_t end = (bucket + 1) * count / buckets;
+
+        size_t low_index = start;
+        size_t high_index = start;
+        int32_t low = a[start] < b[start] ? a[start] : b[start];
+        int32_t high = a[start] < b[start] ? b[start] : a[start];
+        for (size_t i = start + 1; i < end; i++) {
+            int32_t lower = a[i] < b[i] ? a[i] : b[i];
+            int32_t higher = a[i] < b[i] ? b[i] : a[i];
+            if (lower < low) { low = lower; low_index = i; }
+            if (higher > high) { high = higher; high_index = i; }
+        }
+
+        size_t first = low_index < high_index ? low_index : high_index;
+        size_t second = low_index < high_index ? high_index : low_index;
+        int32_t a_first = a[first], a_second = a[second];
+        int32_t b_first = b[first], b_second = b[second];
+        if (x) {
+            x[out] = (uint16_t)first;
+            x[out + 1] = (uint16_t)second;
+        }
+        a[out] = a_first;
+        b[out] = b_first;
+        a[out + 1] = a_second;
+        b[out + 1] = b_second;
+        out += 2;
+    }
+    return out;
+}
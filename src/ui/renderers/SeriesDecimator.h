@@ -0,0 +1,41 @@
+#ifndef SERIES_DECIMATOR_H
+#define SERIES_DECIMATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @class SeriesDecimator
+ * @brief Reduces a series to what a chart of a given pixel width can show
+ *
+ * Splits the series into max_points / 2 buckets and keeps the minimum and
+ * maximum of each, in the order they occur. Every peak and trough survives,
+ * which averaging or plain striding would lose, and a chart never draws more
+ * segments than it has pixel columns. No Arduino or LVGL dependencies.
+ */
+class SeriesDecimator {
+public:
+    /**
+     * @brief Decimate in place
+     *
+     * @param values Series to reduce; the result is written to its front
+     * @param count Points in values
+     * @param max_points Upper bound on the result, usually the chart width
+     * @return Points kept; count if the series already fits
+     */
+    static size_t minMax(int32_t* values, size_t count, size_t max_points);
+
+    /**
+     * @brief Decimate two aligned series in place with one pass
+     *
+     * Both series keep the same source points: in each bucket, the point
+     * where the higher of the two peaks and the point where the lower of the
+     * two dips. Peaks of either series survive and the pair stays aligned.
+     *
+     * @param x Receives the source index of each kept point; may be null
+     * @return Points kept in each series
+     */
+    static size_t minMaxPair(int32_t* a, int32_t* b, size_t count, size_t max_points, uint16_t* x);
+};
+
+#endif // SERIES_DECIMATOR_H
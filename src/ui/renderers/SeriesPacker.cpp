@@ -0,0 +1,46 @@
+#include "SeriesPacker.h"
+#include "ChartScale.h"
+#include "SeriesDecimator.h"
+#include <Arduino.h>
+#include <algorithm> // For std::min
+#include <string.h>
+
+bool SeriesPacker::packLines(const InsightParser& parser, SeriesSet& set, size_t max_points) {
+    set = SeriesSet();
+    size_t point_count = std::min(parser.getSeriesPointCount(), (size_t)UINT16_MAX);
+    size_t series_count = std::min(parser.getSeriesCount(), SeriesSet::MAX_SERIES);
+    if (point_count == 0 || series_count == 0) {
+        return false;
+    }
+
+    // One range for all series so they share the y-axis
+    double min_value;
+    double max_value;
+    parser.getSeriesRange(&min_value, &max_value, series_count);
+    double offset;
+    double scale;
+    ChartScale::compute(min_value, max_value, &offset, &scale);
+
+    set.y.resize(series_count * point_count);
+    size_t kept = 0;
+    for (size_t s = 0; s < series_count; s++) {
+        int32_t* run = set.y.data() + s * point_count;
+        if (!parser.getSeriesYValues(s, run, point_count, offset, scale)) {
+            Serial.printf("[SeriesPacker-ERROR] Failed to get Y values for series %u.\n", (unsigned int)s);
+            set = SeriesSet();
+            return false;
+        }
+        // Every series decimates to the same length; compact the runs as we go
+        kept = SeriesDecimator::minMax(run, point_count, max_points);
+        if (s > 0) {
+            memmove(set.y.data() + s * kept, run, kept * sizeof(int32_t));
+        }
+        parser.getSeriesLabel(s, set.labels[s], SeriesSet::LABEL_LENGTH);
+    }
+    set.y.resize(series_count * kept);
+    set.y.shrink_to_fit();
+
+    set.seriesCount = (uint8_t)series_count;
+    set.pointCount = (uint16_t)kept;
+    return true;
+}
@@ -0,0 +1,26 @@
+#ifndef SERIES_PACKER_H
+#define SERIES_PACKER_H
+
+#include "../../posthog/parsers/InsightParser.h"
+
+/**
+ * @class SeriesPacker
+ * @brief Fills a SeriesSet with every line graph series of an insight
+ *
+ * Up to SeriesSet::MAX_SERIES series are scaled into ChartScale units over
+ * one shared range, decimated with SeriesDecimator and packed back to back.
+ * Colours are left to the renderer. No LVGL dependencies, so packing can be
+ * tested on the host.
+ */
+class SeriesPacker {
+public:
+    /**
+     * @brief Pack the parser's series
+     *
+     * @param max_points Most points kept per series, usually the chart width
+     * @return false if the parser has no usable series; set is then empty
+     */
+    static bool packLines(const InsightParser& parser, SeriesSet& set, size_t max_points);
+};
+
+#endif // SERIES_PACKER_H
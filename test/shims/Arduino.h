@@ -0,0 +1,67 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the tested sources use.
+// Only for [env:native]; the firmware build never sees this directory.
+
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// The ESP32 core pulls in FreeRTOS for every sketch
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Code placement only matters on the chip
+#define IRAM_ATTR
+
+inline unsigned long millis() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return (unsigned long)duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
+
+inline unsigned long micros() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t length = strlen(src);
+    if (size > 0) {
+        size_t copied = length < size - 1 ? length : size - 1;
+        memcpy(dst, src, copied);
+        dst[copied] = '\0';
+    }
+    return length;
+}
+#endif
+
+// Serial output goes to stdout so it shows up with `pio test -v`
+class HostSerial {
+public:
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        int written = vprintf(format, args);
+        va_end(args);
+        return written;
+    }
+    void println(const char* text = "") { ::printf("%s\n", text); }
+    void print(const char* text) { ::printf("%s", text); }
+};
+
+inline HostSerial Serial;
+
+// Heap figures for logs; the host has no fixed heap to report
+class HostEsp {
+public:
+    uint32_t getFreeHeap() const { return 0; }
+    uint32_t getFreePsram() const { return 0; }
+};
+
+inline HostEsp ESP;
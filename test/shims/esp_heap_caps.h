@@ -0,0 +1,15 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF capability allocator; every cap is plain heap
+
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void* heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+inline void heap_caps_free(void* ptr) { free(ptr); }
@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF high resolution timer
+
+#include <Arduino.h>
+
+inline int64_t esp_timer_get_time() { return (int64_t)micros(); }
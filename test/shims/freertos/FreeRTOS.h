@@ -0,0 +1,34 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS critical sections and types used by the tested sources
+
+#include <cstdint>
+
+struct portMUX_TYPE {
+    bool locked;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED portMUX_TYPE{false}
+
+inline void portENTER_CRITICAL(portMUX_TYPE* mux) {
+    while (__atomic_test_and_set(&mux->locked, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+inline void portEXIT_CRITICAL(portMUX_TYPE* mux) {
+    __atomic_clear(&mux->locked, __ATOMIC_RELEASE);
+}
+
+// Ticks are milliseconds on the host
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFu)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+// Nothing runs in interrupt context on the host
+inline bool xPortInIsrContext() { return false; }
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
@@ -0,0 +1,47 @@
+#pragma once
+
+// Host stand-in for FreeRTOS mutexes and binary semaphores. Both are a flag
+// guarded by a std::mutex; a mutex starts given, a binary semaphore taken.
+
+#include "FreeRTOS.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+struct HostSemaphore {
+    explicit HostSemaphore(bool given) : available(given) {}
+    std::mutex lock;
+    std::condition_variable changed;
+    bool available;
+};
+
+typedef HostSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostSemaphore(true); }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return new HostSemaphore(false); }
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) { delete semaphore; }
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    std::unique_lock<std::mutex> guard(semaphore->lock);
+    auto ready = [semaphore] { return semaphore->available; };
+    if (ticks == portMAX_DELAY) {
+        semaphore->changed.wait(guard, ready);
+    } else if (!semaphore->changed.wait_for(guard, std::chrono::milliseconds(ticks), ready)) {
+        return pdFALSE;
+    }
+    semaphore->available = false;
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    std::lock_guard<std::mutex> guard(semaphore->lock);
+    if (semaphore->available) return pdFALSE;
+    semaphore->available = true;
+    semaphore->changed.notify_one();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* woken) {
+    if (woken) *woken = pdFALSE;
+    return xSemaphoreGive(semaphore);
+}
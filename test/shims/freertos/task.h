@@ -0,0 +1,12 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS task calls the tested sources make. There is
+// one task, the test itself, and nothing ever notifies it.
+
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdTRUE; }
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
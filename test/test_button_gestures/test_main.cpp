@@ -0,0 +1,182 @@
+#include <unity.h>
+#include <vector>
+#include "hardware/ButtonGestures.h"
+
+// Same layout as Input: DOWN, CENTER, UP; CENTER + DOWN is the power-off chord
+enum { DOWN = 0, CENTER = 1, UP = 2 };
+
+namespace {
+
+ButtonGestures::Config config() {
+    ButtonGestures::Config config;
+    config.debounce_us = 5000;
+    config.repeat_mask = (1u << UP) | (1u << DOWN);
+    config.chord_mask = (1u << CENTER) | (1u << DOWN);
+    config.chord_hold_us = 2000000;
+    config.chord_window_us = 50000;
+    return config;
+}
+
+ButtonGestures* gestures;
+std::vector<ButtonEvent> events;
+
+void drain() {
+    ButtonEvent event;
+    while (gestures->nextEvent(event)) {
+        events.push_back(event);
+    }
+}
+
+// Synthetic trace step: an edge at time_ms
+void edge(uint8_t button, bool pressed, uint32_t time_ms) {
+    gestures->feed({button, pressed, time_ms * 1000});
+    drain();
+}
+
+void pollAt(uint32_t time_ms) {
+    gestures->poll(time_ms * 1000);
+    drain();
+}
+
+size_t count(ButtonEventType type, uint8_t button) {
+    size_t n = 0;
+    for (const ButtonEvent& event : events) {
+        if (event.type == type && event.button == button) n++;
+    }
+    return n;
+}
+
+}  // namespace
+
+void setUp() {
+    gestures = new ButtonGestures(3, config());
+    for (uint8_t i = 0; i < 3; i++) {
+        gestures->reset(i, false, 0);
+    }
+    events.clear();
+}
+
+void tearDown() {
+    delete gestures;
+}
+
+void test_non_chord_press_is_immediate() {
+    edge(UP, true, 100);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_TRUE(events[0].type == ButtonEventType::PRESS);
+    TEST_ASSERT_EQUAL(UP, events[0].button);
+}
+
+void test_chord_button_press_waits_for_window() {
+    edge(CENTER, true, 100);
+    TEST_ASSERT_EQUAL(0, events.size());
+    pollAt(110);  // Debounce window over; the chord window is next
+    TEST_ASSERT_EQUAL(40000, gestures->nextDeadlineUs(110000));
+
+    pollAt(149);
+    TEST_ASSERT_EQUAL(0, events.size());
+    pollAt(150);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_TRUE(events[0].type == ButtonEventType::PRESS);
+    TEST_ASSERT_EQUAL(CENTER, events[0].button);
+    TEST_ASSERT_EQUAL(100000, events[0].time_us);  // Original press time
+
+    edge(CENTER, false, 300);
+    TEST_ASSERT_EQUAL(1, count(ButtonEventType::RELEASE, CENTER));
+}
+
+void test_quick_tap_reports_press_before_release() {
+    edge(DOWN, true, 100);
+    edge(DOWN, false, 120);
+    TEST_ASSERT_EQUAL(2, events.size());
+    TEST_ASSERT_TRUE(events[0].type == ButtonEventType::PRESS);
+    TEST_ASSERT_TRUE(events[1].type == ButtonEventType::RELEASE);
+}
+
+void test_chord_emits_no_press_or_release() {
+    // CENTER then DOWN 30 ms later, held past the chord time, then released
+    edge(CENTER, true, 100);
+    edge(DOWN, true, 130);
+    for (uint32_t t = 140; t <= 2200; t += 10) {
+        pollAt(t);
+    }
+    edge(DOWN, false, 2300);
+    edge(CENTER, false, 2310);
+    pollAt(2400);
+
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_TRUE(events[0].type == ButtonEventType::CHORD);
+    TEST_ASSERT_EQUAL((1u << CENTER) | (1u << DOWN), events[0].button);
+    TEST_ASSERT_EQUAL(2130000, events[0].time_us);
+}
+
+void test_chord_suppresses_repeat_of_held_down() {
+    edge(DOWN, true, 100);
+    edge(CENTER, true, 110);
+    for (uint32_t t = 120; t <= 1500; t += 10) {
+        pollAt(t);
+    }
+    TEST_ASSERT_EQUAL(0, count(ButtonEventType::REPEAT, DOWN));
+    TEST_ASSERT_EQUAL(0, count(ButtonEventType::PRESS, DOWN));
+    TEST_ASSERT_EQUAL(0, count(ButtonEventType::LONG_PRESS, DOWN));
+}
+
+void test_late_second_button_still_forms_chord() {
+    // CENTER acts on its own once the window passes; DOWN arriving later
+    // completes the chord without a DOWN press
+    edge(CENTER, true, 100);
+    pollAt(160);
+    edge(DOWN, true, 400);
+    pollAt(2400);
+    edge(CENTER, false, 2500);
+    edge(DOWN, false, 2510);
+
+    TEST_ASSERT_EQUAL(1, count(ButtonEventType::PRESS, CENTER));
+    TEST_ASSERT_EQUAL(0, count(ButtonEventType::PRESS, DOWN));
+    TEST_ASSERT_EQUAL(1, count(ButtonEventType::CHORD, (1u << CENTER) | (1u << DOWN)));
+    TEST_ASSERT_EQUAL(1, count(ButtonEventType::RELEASE, CENTER));
+    TEST_ASSERT_EQUAL(0, count(ButtonEventType::RELEASE, DOWN));
+}
+
+void test_other_button_flushes_pending_press_in_order() {
+    edge(CENTER, true, 100);
+    edge(UP, true, 120);
+    TEST_ASSERT_EQUAL(2, events.size());
+    TEST_ASSERT_EQUAL(CENTER, events[0].button);
+    TEST_ASSERT_EQUAL(UP, events[1].button);
+}
+
+void test_held_down_repeats() {
+    edge(DOWN, true, 100);
+    for (uint32_t t = 110; t <= 1000; t += 10) {
+        pollAt(t);
+    }
+    TEST_ASSERT_EQUAL(1, count(ButtonEventType::PRESS, DOWN));
+    // First repeat at 600 ms, then every 150 ms: 600, 750, 900
+    TEST_ASSERT_EQUAL(3, count(ButtonEventType::REPEAT, DOWN));
+}
+
+void test_bounce_is_debounced() {
+    edge(UP, true, 100);
+    gestures->feed({UP, false, 101000});
+    gestures->feed({UP, true, 102000});
+    gestures->feed({UP, false, 103000});
+    gestures->feed({UP, true, 104000});
+    pollAt(110);
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_TRUE(gestures->isPressed(UP));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_non_chord_press_is_immediate);
+    RUN_TEST(test_chord_button_press_waits_for_window);
+    RUN_TEST(test_quick_tap_reports_press_before_release);
+    RUN_TEST(test_chord_emits_no_press_or_release);
+    RUN_TEST(test_chord_suppresses_repeat_of_held_down);
+    RUN_TEST(test_late_second_button_still_forms_chord);
+    RUN_TEST(test_other_button_flushes_pending_press_in_order);
+    RUN_TEST(test_held_down_repeats);
+    RUN_TEST(test_bounce_is_debounced);
+    return UNITY_END();
+}
@@ -0,0 +1,263 @@
+#include <unity.h>
+#include <lvgl.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "Style.h"
+#include "hardware/DisplayInterface.h"
+#include "hardware/FramebufferBackend.h"
+#include "ui/InsightData.h"
+#include "ui/examples/HelloWorldCard.h"
+#include "ui/renderers/AreaChartRenderer.h"
+#include "ui/renderers/LineGraphRenderer.h"
+
+// Renders real cards through DisplayInterface on the headless backend and
+// compares each frame with a PNG checked in next to this file. PngWriter is
+// deterministic, so an unchanged frame matches its golden byte for byte.
+//
+// A missing golden is recorded and the test ignored; review the new PNG and
+// check it in. A mismatch writes <name>.actual.png beside the golden.
+
+static const uint16_t WIDTH = 240;
+static const uint16_t HEIGHT = 135;
+static const uint16_t BUFFER_ROWS = 34;  // As in main.cpp, so frames flush in the same stripes
+static const char* GOLDEN_DIR = "test/test_card_golden/";
+
+static FramebufferBackend* backend = nullptr;
+static DisplayInterface* display = nullptr;
+
+// A year of daily points with spikes that decimation must keep
+static const size_t DAYS = 365;
+static const size_t SPIKE_DAYS[] = {17, 123, 250, 364};
+static const size_t SPIKE_COUNT = sizeof(SPIKE_DAYS) / sizeof(SPIKE_DAYS[0]);
+
+void setUp() {
+    // A failed assertion skips the card's destructor, so clear what it left
+    lv_obj_clean(lv_screen_active());
+    backend->resetFrameStats();
+}
+
+void tearDown() {
+    // Cards delete their objects asynchronously
+    lv_timer_handler();
+}
+
+static bool collect(void* ctx, const uint8_t* data, size_t length) {
+    std::vector<uint8_t>* out = static_cast<std::vector<uint8_t>*>(ctx);
+    out->insert(out->end(), data, data + length);
+    return true;
+}
+
+static bool readFile(const std::string& path, std::vector<uint8_t>* out) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        out->insert(out->end(), chunk, chunk + read);
+    }
+    fclose(file);
+    return true;
+}
+
+static bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+}
+
+// Render the active screen as one full frame
+static void renderFrame(const char* name) {
+    uint32_t flushes = backend->flushCount();
+    uint32_t render_us = display->renderFrameNow();
+    Serial.printf("[Golden] %s: %lu us, %lu flushes\n", name,
+                  (unsigned long)render_us, (unsigned long)(backend->flushCount() - flushes));
+}
+
+// Compare the last frame with <name>.png
+static void assertFrameMatchesGolden(const char* name) {
+    std::vector<uint8_t> png;
+    TEST_ASSERT_TRUE(backend->writePng(collect, &png));
+
+    std::string path = std::string(GOLDEN_DIR) + name;
+    std::vector<uint8_t> golden;
+    if (!readFile(path + ".png", &golden)) {
+        TEST_ASSERT_TRUE(writeFile(path + ".png", png));
+        TEST_IGNORE_MESSAGE("Recorded a missing golden image; review it and check it in");
+    }
+    if (png != golden) {
+        writeFile(path + ".actual.png", png);
+        TEST_FAIL_MESSAGE("Frame differs from its golden image; see the .actual.png beside it");
+    }
+}
+
+// One daily series of a trends result; compare_label is left out when empty
+static std::string seriesJson(const char* label, const char* compare_label, const std::vector<double>& values) {
+    std::string json = std::string("{\"label\":\"") + label + "\",";
+    if (compare_label[0] != '\0') {
+        json += std::string("\"compare_label\":\"") + compare_label + "\",";
+    }
+    json += "\"data\":[";
+    for (size_t i = 0; i < values.size(); i++) {
+        char value[32];
+        snprintf(value, sizeof(value), "%s%g", i > 0 ? "," : "", values[i]);
+        json += value;
+    }
+    json += "],\"days\":[";
+    for (size_t i = 0; i < values.size(); i++) {
+        char day[24];
+        snprintf(day, sizeof(day), "%s\"2024-%02u-%02u\"", i > 0 ? "," : "",
+                 (unsigned)(1 + i / 28 % 12), (unsigned)(1 + i % 28));
+        json += day;
+    }
+    return json + "]}";
+}
+
+// Trends response with one daily series
+static std::string trendsJson(const std::vector<double>& values) {
+    return "{\"results\":[{\"name\":\"Year\",\"query\":{\"display\":\"ActionsLineGraph\"},\"result\":[" +
+           seriesJson("Pageviews", "", values) + "]}]}";
+}
+
+// The first series colour drawn over the chart background and grid, which are near black
+static bool isSeriesPixel(uint16_t pixel) {
+    return (pixel & 0x1F) >= 12;
+}
+
+void test_hello_world_card_matches_golden() {
+    HelloWorldCard card(lv_screen_active());
+    renderFrame("hello_world_card");
+    assertFrameMatchesGolden("hello_world_card");
+}
+
+void test_line_graph_keeps_every_spike() {
+    std::vector<double> values(DAYS);
+    for (size_t i = 0; i < DAYS; i++) {
+        values[i] = 100 + (double)((i * 37) % 20);  // Low, noisy baseline
+    }
+    for (size_t spike : SPIKE_DAYS) {
+        values[spike] = 1000;
+    }
+    std::string json = trendsJson(values);
+    InsightParser parser(json.c_str());
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::LINE_GRAPH);
+    InsightData data;
+    data.extract(parser);
+    TEST_ASSERT_EQUAL(LineGraphRenderer::MAX_DISPLAY_POINTS, data.series.pointCount);
+
+    // Chart-sized container, as InsightCard's content area
+    lv_obj_t* container = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(container);
+    lv_obj_set_size(container, 230, 90);
+    lv_obj_center(container);
+    LineGraphRenderer renderer;
+    renderer.createElements(container);
+    lv_obj_update_layout(container);
+    renderer.updateDisplay(data);
+    renderFrame("line_graph_year_spikes");
+
+    // Columns with the line in the top fifth of the chart, where only spikes reach
+    lv_area_t chart;
+    lv_obj_get_coords(container, &chart);
+    int32_t chart_width = lv_area_get_width(&chart);
+    int32_t band_bottom = chart.y1 + lv_area_get_height(&chart) / 5;
+    std::vector<int32_t> spike_columns;
+    bool in_spike = false;
+    for (int32_t x = chart.x1; x <= chart.x2; x++) {
+        bool lit = false;
+        for (int32_t y = chart.y1; y <= band_bottom && !lit; y++) {
+            lit = isSeriesPixel(backend->pixels()[y * WIDTH + x]);
+        }
+        if (lit && !in_spike) spike_columns.push_back(x);
+        in_spike = lit;
+    }
+
+    // One spike per source spike, each where its day falls on the x-axis
+    TEST_ASSERT_EQUAL(SPIKE_COUNT, spike_columns.size());
+    for (size_t i = 0; i < SPIKE_COUNT; i++) {
+        int32_t expected = chart.x1 + (int32_t)(SPIKE_DAYS[i] * (chart_width - 1) / (DAYS - 1));
+        TEST_ASSERT_INT_WITHIN(4, expected, spike_columns[i]);
+    }
+
+    assertFrameMatchesGolden("line_graph_year_spikes");
+    renderer.clearElements();
+}
+
+void test_area_chart_compare_matches_golden() {
+    const size_t days = 30;
+    std::vector<double> current(days);
+    std::vector<double> previous(days);
+    std::vector<double> breakdown(days, 1000);
+    for (size_t i = 0; i < days; i++) {
+        current[i] = 10 + (double)i;
+        previous[i] = 25 - (double)(i % 10);
+    }
+    // A breakdown series between the two periods, which the chart does not draw
+    std::string json = "{\"results\":[{\"name\":\"Month\",\"compare\":true,"
+                       "\"query\":{\"display\":\"ActionsAreaGraph\"},\"result\":[" +
+                       seriesJson("Chrome", "current", current) + "," +
+                       seriesJson("Safari", "current", breakdown) + "," +
+                       seriesJson("Chrome", "previous", previous) + "]}]}";
+    InsightParser parser(json.c_str());
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::AREA_CHART);
+    InsightData data;
+    data.extract(parser);
+    TEST_ASSERT_EQUAL(days, data.series.pointCount);
+
+    lv_obj_t* container = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(container);
+    lv_obj_set_size(container, 230, 90);
+    lv_obj_center(container);
+    AreaChartRenderer renderer;
+    renderer.createElements(container);
+    lv_obj_update_layout(container);
+    renderer.updateDisplay(data);
+    renderFrame("area_chart_compare");
+
+    // The current peak sits just under the headroom, so its line reaches the
+    // top fifth; scaled against the breakdown it would hug the baseline
+    lv_area_t chart;
+    lv_obj_get_coords(container, &chart);
+    int32_t band_bottom = chart.y1 + lv_area_get_height(&chart) / 5;
+    bool lit = false;
+    for (int32_t y = chart.y1; y <= band_bottom && !lit; y++) {
+        for (int32_t x = chart.x1; x <= chart.x2 && !lit; x++) {
+            lit = isSeriesPixel(backend->pixels()[y * WIDTH + x]);
+        }
+    }
+    TEST_ASSERT_TRUE(lit);
+
+    assertFrameMatchesGolden("area_chart_compare");
+    renderer.clearElements();
+}
+
+void test_backend_records_frame_timings() {
+    HelloWorldCard card(lv_screen_active());
+
+    const uint32_t frames = 10;
+    for (uint32_t i = 0; i < frames; i++) {
+        display->renderFrameNow();
+    }
+
+    const FramebufferBackend::FrameStats& stats = backend->frameStats();
+    TEST_ASSERT_EQUAL(frames, stats.frames);
+    TEST_ASSERT_GREATER_THAN(0, stats.worstUs);
+    TEST_ASSERT_LESS_OR_EQUAL(stats.worstUs, stats.lastUs);
+    Serial.printf("[Golden] %lu frames: avg %lu us, worst %lu us\n", (unsigned long)stats.frames,
+                  (unsigned long)(stats.totalUs / stats.frames), (unsigned long)stats.worstUs);
+}
+
+int main() {
+    backend = new FramebufferBackend(WIDTH, HEIGHT);
+    display = new DisplayInterface(backend, WIDTH, HEIGHT, BUFFER_ROWS);
+    display->begin();
+    Style::init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_hello_world_card_matches_golden);
+    RUN_TEST(test_line_graph_keeps_every_spike);
+    RUN_TEST(test_area_chart_compare_matches_golden);
+    RUN_TEST(test_backend_records_frame_timings);
+    return UNITY_END();
+}
@@ -0,0 +1,75 @@
+#include <unity.h>
+#include <string>
+#include <utility>
+#include "ui/CardReconcile.h"
+
+// Keys as CardController builds them: (card type, config value)
+using Key = std::pair<int, std::string>;
+
+enum { INSIGHT = 0, FRIEND = 1, POMODORO = 6 };
+
+void setUp() {}
+void tearDown() {}
+
+void test_reorder_recreates_nothing() {
+    std::vector<Key> live = {{INSIGHT, "abc"}, {INSIGHT, "def"}, {FRIEND, ""}, {POMODORO, ""}};
+    std::vector<Key> wanted = {{POMODORO, ""}, {INSIGHT, "def"}, {FRIEND, ""}, {INSIGHT, "abc"}};
+
+    CardReconcilePlan plan = planCardReconcile(live, wanted);
+
+    // Only factories fetch insight data, so no creation means no network requests
+    TEST_ASSERT_EQUAL(0, plan.created);
+    TEST_ASSERT_EQUAL(0, plan.removed);
+    TEST_ASSERT_EQUAL(3, plan.reuse[0]);
+    TEST_ASSERT_EQUAL(1, plan.reuse[1]);
+    TEST_ASSERT_EQUAL(2, plan.reuse[2]);
+    TEST_ASSERT_EQUAL(0, plan.reuse[3]);
+}
+
+void test_add_and_remove_touch_only_changed_cards() {
+    std::vector<Key> live = {{INSIGHT, "abc"}, {INSIGHT, "def"}, {FRIEND, ""}};
+    std::vector<Key> wanted = {{INSIGHT, "abc"}, {INSIGHT, "xyz"}, {FRIEND, ""}};
+
+    CardReconcilePlan plan = planCardReconcile(live, wanted);
+
+    TEST_ASSERT_EQUAL(1, plan.created);
+    TEST_ASSERT_EQUAL(1, plan.removed);
+    TEST_ASSERT_EQUAL(0, plan.reuse[0]);
+    TEST_ASSERT_EQUAL(CardReconcilePlan::CREATE, plan.reuse[1]);
+    TEST_ASSERT_EQUAL(2, plan.reuse[2]);
+    TEST_ASSERT_TRUE(plan.kept[0]);
+    TEST_ASSERT_FALSE(plan.kept[1]);
+    TEST_ASSERT_TRUE(plan.kept[2]);
+}
+
+void test_duplicates_match_one_to_one() {
+    std::vector<Key> live = {{INSIGHT, "abc"}, {INSIGHT, "abc"}};
+    std::vector<Key> wanted = {{INSIGHT, "abc"}, {INSIGHT, "abc"}, {INSIGHT, "abc"}};
+
+    CardReconcilePlan plan = planCardReconcile(live, wanted);
+
+    TEST_ASSERT_EQUAL(0, plan.reuse[0]);
+    TEST_ASSERT_EQUAL(1, plan.reuse[1]);
+    TEST_ASSERT_EQUAL(CardReconcilePlan::CREATE, plan.reuse[2]);
+    TEST_ASSERT_EQUAL(1, plan.created);
+    TEST_ASSERT_EQUAL(0, plan.removed);
+}
+
+void test_same_config_different_type_is_not_reused() {
+    std::vector<Key> live = {{FRIEND, ""}};
+    std::vector<Key> wanted = {{POMODORO, ""}};
+
+    CardReconcilePlan plan = planCardReconcile(live, wanted);
+
+    TEST_ASSERT_EQUAL(1, plan.created);
+    TEST_ASSERT_EQUAL(1, plan.removed);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_reorder_recreates_nothing);
+    RUN_TEST(test_add_and_remove_touch_only_changed_cards);
+    RUN_TEST(test_duplicates_match_one_to_one);
+    RUN_TEST(test_same_config_different_type_is_not_reused);
+    return UNITY_END();
+}
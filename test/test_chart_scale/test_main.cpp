@@ -0,0 +1,80 @@
+#include <unity.h>
+#include "ui/renderers/ChartScale.h"
+
+// Where the top of the data lands: headroom keeps it below the chart edge.
+// Unity compares floats by default, so tolerances are in float precision.
+static const double TOP = ChartScale::Y_MAX / (1.0 + ChartScale::HEADROOM);
+
+static double toChart(double value, double offset, double scale) {
+    return (value - offset) * scale;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_positive_range_starts_at_zero() {
+    double offset, scale;
+    ChartScale::compute(40.0, 100.0, &offset, &scale);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0, offset);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0, toChart(0.0, offset, scale));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, TOP, toChart(100.0, offset, scale));
+}
+
+void test_negative_range_keeps_zero_on_top() {
+    double offset, scale;
+    ChartScale::compute(-50.0, -10.0, &offset, &scale);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -50.0, offset);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0, toChart(-50.0, offset, scale));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, TOP, toChart(0.0, offset, scale));
+    TEST_ASSERT_TRUE(toChart(-10.0, offset, scale) < toChart(0.0, offset, scale));
+}
+
+void test_all_zero_draws_along_baseline() {
+    double offset, scale;
+    ChartScale::compute(0.0, 0.0, &offset, &scale);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0, offset);
+    TEST_ASSERT_TRUE(scale > 0.0);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0, toChart(0.0, offset, scale));
+}
+
+void test_mixed_sign_range_places_zero_inside() {
+    double offset, scale;
+    ChartScale::compute(-20.0, 80.0, &offset, &scale);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -20.0, offset);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0, toChart(-20.0, offset, scale));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, TOP * 0.2, toChart(0.0, offset, scale));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, TOP, toChart(80.0, offset, scale));
+}
+
+void test_values_stay_under_headroom_bound() {
+    static const double ranges[][2] = {
+        {0, 1}, {0, 7}, {3, 3}, {-3, -3}, {-1e9, 1e9}, {0.001, 0.002}, {-5, 0}, {12345, 987654},
+    };
+    for (const auto& range : ranges) {
+        double offset, scale;
+        ChartScale::compute(range[0], range[1], &offset, &scale);
+        for (int step = 0; step <= 100; step++) {
+            double value = range[0] + (range[1] - range[0]) * step / 100.0;
+            double y = toChart(value, offset, scale);
+            TEST_ASSERT_TRUE(y >= -1e-6);
+            TEST_ASSERT_TRUE(y <= TOP + 1e-6);
+        }
+        // The highest of the data and zero sits exactly at the bound
+        double top = range[1] > 0 ? range[1] : 0.0;
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, TOP, toChart(top, offset, scale));
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_positive_range_starts_at_zero);
+    RUN_TEST(test_negative_range_keeps_zero_on_top);
+    RUN_TEST(test_all_zero_draws_along_baseline);
+    RUN_TEST(test_mixed_sign_range_places_zero_inside);
+    RUN_TEST(test_values_stay_under_headroom_bound);
+    return UNITY_END();
+}
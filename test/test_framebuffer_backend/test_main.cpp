@@ -0,0 +1,216 @@
+#include <unity.h>
+#include <vector>
+#include "hardware/FramebufferBackend.h"
+
+// Golden scene: 3x2 blocks of known RGB565 colours over a black 16x8 screen,
+// flushed in the stripes LVGL would send
+static const uint16_t WIDTH = 16;
+static const uint16_t HEIGHT = 8;
+static const uint16_t RED = 0xF800;
+static const uint16_t GREEN = 0x07E0;
+static const uint16_t BLUE = 0x001F;
+static const uint16_t GREY = 0x8410;
+
+void setUp() {}
+void tearDown() {}
+
+static bool collect(void* ctx, const uint8_t* data, size_t length) {
+    std::vector<uint8_t>* out = static_cast<std::vector<uint8_t>*>(ctx);
+    out->insert(out->end(), data, data + length);
+    return true;
+}
+
+static bool failAfterSignature(void* ctx, const uint8_t*, size_t) {
+    size_t* calls = static_cast<size_t*>(ctx);
+    return (*calls)++ == 0;
+}
+
+static uint32_t be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint32_t crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static void flushBlock(FramebufferBackend& fb, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color) {
+    std::vector<uint16_t> block((size_t)w * h, color);
+    fb.flush(x, y, w, h, (uint8_t*)block.data());
+}
+
+static void drawScene(FramebufferBackend& fb) {
+    flushBlock(fb, 0, 0, WIDTH, 4, 0x0000);
+    flushBlock(fb, 0, 4, WIDTH, 4, 0x0000);
+    flushBlock(fb, 1, 1, 3, 2, RED);
+    flushBlock(fb, 6, 3, 3, 2, GREEN);
+    flushBlock(fb, 13, 6, 3, 2, BLUE);
+    flushBlock(fb, 0, 7, 2, 1, GREY);
+}
+
+static uint16_t sceneAt(uint16_t x, uint16_t y) {
+    if (x >= 1 && x < 4 && y >= 1 && y < 3) return RED;
+    if (x >= 6 && x < 9 && y >= 3 && y < 5) return GREEN;
+    if (x >= 13 && y >= 6) return BLUE;
+    if (x < 2 && y == 7) return GREY;
+    return 0x0000;
+}
+
+// Decode a PngWriter image (stored deflate blocks only), checking every CRC and the Adler-32
+static bool decodeStoredPng(const std::vector<uint8_t>& png, uint32_t* width, uint32_t* height,
+                            std::vector<uint8_t>* rgb) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (png.size() < 8 || memcmp(png.data(), signature, 8) != 0) return false;
+
+    std::vector<uint8_t> zlib;
+    bool ended = false;
+    size_t pos = 8;
+    while (pos + 12 <= png.size() && !ended) {
+        uint32_t length = be32(&png[pos]);
+        const uint8_t* type = &png[pos + 4];
+        if (pos + 12 + length > png.size()) return false;
+        if (crc32(type, 4 + length) != be32(&png[pos + 8 + length])) return false;
+        const uint8_t* data = &png[pos + 8];
+        if (memcmp(type, "IHDR", 4) == 0) {
+            if (length != 13 || data[8] != 8 || data[9] != 2) return false;
+            *width = be32(data);
+            *height = be32(data + 4);
+        } else if (memcmp(type, "IDAT", 4) == 0) {
+            zlib.insert(zlib.end(), data, data + length);
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            ended = true;
+        }
+        pos += 12 + length;
+    }
+    if (!ended || pos != png.size() || zlib.size() < 6) return false;
+
+    std::vector<uint8_t> raw;
+    size_t z = 2;
+    bool final_block = false;
+    while (!final_block) {
+        if (z + 5 > zlib.size() || (zlib[z] & 0x06) != 0) return false;  // Stored blocks only
+        final_block = zlib[z] & 1;
+        uint16_t len = zlib[z + 1] | (zlib[z + 2] << 8);
+        uint16_t nlen = zlib[z + 3] | (zlib[z + 4] << 8);
+        if ((uint16_t)~len != nlen || z + 5 + len > zlib.size()) return false;
+        raw.insert(raw.end(), &zlib[z + 5], &zlib[z + 5] + len);
+        z += 5 + len;
+    }
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    if (z + 4 != zlib.size() || be32(&zlib[z]) != ((b << 16) | a)) return false;
+
+    size_t row_bytes = 1 + (size_t)*width * 3;
+    if (raw.size() != row_bytes * *height) return false;
+    rgb->clear();
+    for (uint32_t y = 0; y < *height; y++) {
+        if (raw[y * row_bytes] != 0) return false;  // Filter: none
+        rgb->insert(rgb->end(), &raw[y * row_bytes + 1], &raw[(y + 1) * row_bytes]);
+    }
+    return true;
+}
+
+void test_flushes_compose_into_framebuffer() {
+    FramebufferBackend fb(WIDTH, HEIGHT);
+    TEST_ASSERT_TRUE(fb.begin());
+    drawScene(fb);
+
+    TEST_ASSERT_EQUAL(6, fb.flushCount());
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            TEST_ASSERT_EQUAL_HEX16(sceneAt(x, y), fb.pixels()[y * WIDTH + x]);
+        }
+    }
+}
+
+void test_out_of_bounds_flush_is_ignored() {
+    FramebufferBackend fb(WIDTH, HEIGHT);
+    TEST_ASSERT_TRUE(fb.begin());
+    flushBlock(fb, 14, 0, 4, 1, RED);
+    flushBlock(fb, 0, 7, 1, 2, RED);
+    flushBlock(fb, -1, 0, 2, 1, RED);
+
+    TEST_ASSERT_EQUAL(0, fb.flushCount());
+    for (size_t i = 0; i < (size_t)WIDTH * HEIGHT; i++) {
+        TEST_ASSERT_EQUAL_HEX16(0x0000, fb.pixels()[i]);
+    }
+}
+
+void test_png_matches_golden_scene() {
+    FramebufferBackend fb(WIDTH, HEIGHT);
+    TEST_ASSERT_TRUE(fb.begin());
+    drawScene(fb);
+
+    std::vector<uint8_t> png;
+    TEST_ASSERT_TRUE(fb.writePng(collect, &png));
+
+    uint32_t width = 0, height = 0;
+    std::vector<uint8_t> rgb;
+    TEST_ASSERT_TRUE(decodeStoredPng(png, &width, &height, &rgb));
+    TEST_ASSERT_EQUAL(WIDTH, width);
+    TEST_ASSERT_EQUAL(HEIGHT, height);
+
+    // RGB565 widens by bit replication, so full-scale channels stay full scale
+    for (uint16_t y = 0; y < HEIGHT; y++) {
+        for (uint16_t x = 0; x < WIDTH; x++) {
+            const uint8_t* px = &rgb[((size_t)y * WIDTH + x) * 3];
+            uint8_t expected[3] = {0, 0, 0};
+            switch (sceneAt(x, y)) {
+                case RED: expected[0] = 0xFF; break;
+                case GREEN: expected[1] = 0xFF; break;
+                case BLUE: expected[2] = 0xFF; break;
+                case GREY: expected[0] = 0x84; expected[1] = 0x82; expected[2] = 0x84; break;
+            }
+            TEST_ASSERT_EQUAL_HEX8(expected[0], px[0]);
+            TEST_ASSERT_EQUAL_HEX8(expected[1], px[1]);
+            TEST_ASSERT_EQUAL_HEX8(expected[2], px[2]);
+        }
+    }
+}
+
+void test_png_rejects_bad_input_and_sink_failure() {
+    uint16_t pixel = 0;
+    std::vector<uint8_t> png;
+    TEST_ASSERT_FALSE(PngWriter::write(&pixel, 0, 1, collect, &png));
+    TEST_ASSERT_FALSE(PngWriter::write(&pixel, PngWriter::MAX_WIDTH + 1, 1, collect, &png));
+
+    FramebufferBackend fb(WIDTH, HEIGHT);
+    TEST_ASSERT_FALSE(fb.writePng(collect, &png));  // Not begun: no framebuffer
+    TEST_ASSERT_TRUE(fb.begin());
+    size_t calls = 0;
+    TEST_ASSERT_FALSE(fb.writePng(failAfterSignature, &calls));
+}
+
+void test_frame_stats_track_render_times() {
+    FramebufferBackend fb(WIDTH, HEIGHT);
+    fb.frameRendered(900);
+    fb.frameRendered(2500);
+    fb.frameRendered(1200);
+
+    TEST_ASSERT_EQUAL(3, fb.frameStats().frames);
+    TEST_ASSERT_EQUAL(4600, (uint32_t)fb.frameStats().totalUs);
+    TEST_ASSERT_EQUAL(2500, fb.frameStats().worstUs);
+    TEST_ASSERT_EQUAL(1200, fb.frameStats().lastUs);
+
+    fb.resetFrameStats();
+    TEST_ASSERT_EQUAL(0, fb.frameStats().frames);
+    TEST_ASSERT_EQUAL(0, fb.frameStats().worstUs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_flushes_compose_into_framebuffer);
+    RUN_TEST(test_out_of_bounds_flush_is_ignored);
+    RUN_TEST(test_png_matches_golden_scene);
+    RUN_TEST(test_png_rejects_bad_input_and_sink_failure);
+    RUN_TEST(test_frame_stats_track_render_times);
+    return UNITY_END();
+}
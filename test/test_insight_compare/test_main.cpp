@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <math.h>
+#include "posthog/parsers/InsightParser.h"
+#include "ui/renderers/AreaChartRenderer.h"
+#include "ui/renderers/ChartScale.h"
+
+// Trends responses trimmed to what the parser keeps after filtering
+static const char* COMPARE_PREVIOUS_SECOND = R"({"results":[{"name":"Signups","compare":true,
+    "query":{"display":"ActionsAreaGraph"},
+    "result":[{"label":"Signups","compare_label":"current","data":[1,2,3],"days":["2024-05-01","2024-05-02","2024-05-03"]},
+              {"label":"Signups","compare_label":"previous","data":[3,2,1],"days":["2024-04-28","2024-04-29","2024-04-30"]}]}]})";
+
+static const char* COMPARE_PREVIOUS_FIRST = R"({"results":[{"name":"Signups","compare":true,
+    "query":{"display":"ActionsLineGraph"},
+    "result":[{"label":"Signups","compare_label":"previous","data":[3,2,1],"days":["2024-04-28","2024-04-29","2024-04-30"]},
+              {"label":"Signups","compare_label":"current","data":[1,2,3],"days":["2024-05-01","2024-05-02","2024-05-03"]}]}]})";
+
+static const char* BREAKDOWN_COMPARE_FALSE = R"({"results":[{"name":"Pageviews by browser","compare":false,
+    "query":{"display":"ActionsLineGraph"},
+    "result":[{"label":"Chrome","data":[5,6,7],"days":["2024-05-01","2024-05-02","2024-05-03"]},
+              {"label":"Safari","data":[1,1,2],"days":["2024-05-01","2024-05-02","2024-05-03"]}]}]})";
+
+static const char* COMPARE_WITHOUT_PREVIOUS = R"({"results":[{"name":"Signups","compare":true,
+    "query":{"display":"ActionsLineGraph"},
+    "result":[{"label":"Chrome","compare_label":"current","data":[5,6,7],"days":["2024-05-01","2024-05-02","2024-05-03"]},
+              {"label":"Safari","compare_label":"current","data":[1,1,2],"days":["2024-05-01","2024-05-02","2024-05-03"]}]}]})";
+
+// Breakdown compare: both current periods come before the previous one
+static const char* BREAKDOWN_BETWEEN_PERIODS = R"({"results":[{"name":"Pageviews","compare":true,
+    "query":{"display":"ActionsAreaGraph"},
+    "result":[{"label":"Chrome","compare_label":"current","data":[10,20,30],"days":["2024-05-01","2024-05-02","2024-05-03"]},
+              {"label":"Safari","compare_label":"current","data":[1000,1000,1000],"days":["2024-05-01","2024-05-02","2024-05-03"]},
+              {"label":"Chrome","compare_label":"previous","data":[5,15,25],"days":["2024-04-28","2024-04-29","2024-04-30"]}]}]})";
+
+void setUp() {}
+void tearDown() {}
+
+void test_previous_period_found_after_current() {
+    InsightParser parser(COMPARE_PREVIOUS_SECOND);
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::AREA_CHART);
+
+    size_t current = 9, previous = 9;
+    TEST_ASSERT_TRUE(parser.getCompareSeries(&current, &previous));
+    TEST_ASSERT_EQUAL(0, current);
+    TEST_ASSERT_EQUAL(1, previous);
+}
+
+void test_previous_period_found_before_current() {
+    InsightParser parser(COMPARE_PREVIOUS_FIRST);
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::AREA_CHART);
+
+    size_t current = 9, previous = 9;
+    TEST_ASSERT_TRUE(parser.getCompareSeries(&current, &previous));
+    TEST_ASSERT_EQUAL(1, current);
+    TEST_ASSERT_EQUAL(0, previous);
+}
+
+void test_compare_false_is_a_line_graph() {
+    InsightParser parser(BREAKDOWN_COMPARE_FALSE);
+    TEST_ASSERT_TRUE(parser.isValid());
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::LINE_GRAPH);
+    TEST_ASSERT_EQUAL(2, parser.getSeriesCount());
+
+    // Breakdown series are not a previous period
+    size_t current = 9, previous = 9;
+    TEST_ASSERT_FALSE(parser.getCompareSeries(&current, &previous));
+    TEST_ASSERT_EQUAL(0, current);
+    TEST_ASSERT_EQUAL(0, previous);
+}
+
+void test_compare_without_previous_series_has_no_comparison() {
+    InsightParser parser(COMPARE_WITHOUT_PREVIOUS);
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::AREA_CHART);
+
+    size_t current = 9, previous = 9;
+    TEST_ASSERT_FALSE(parser.getCompareSeries(&current, &previous));
+    TEST_ASSERT_EQUAL(0, current);
+    TEST_ASSERT_EQUAL(0, previous);
+}
+
+void test_area_range_covers_only_the_two_periods() {
+    InsightParser parser(BREAKDOWN_BETWEEN_PERIODS);
+    size_t current = 9, previous = 9;
+    TEST_ASSERT_TRUE(parser.getCompareSeries(&current, &previous));
+    TEST_ASSERT_EQUAL(0, current);
+    TEST_ASSERT_EQUAL(2, previous);
+
+    double min_value = -1, max_value = -1;
+    TEST_ASSERT_TRUE(parser.getSeriesValueRange(previous, &min_value, &max_value));
+    TEST_ASSERT_EQUAL(5, min_value);
+    TEST_ASSERT_EQUAL(25, max_value);
+    TEST_ASSERT_FALSE(parser.getSeriesValueRange(3, &min_value, &max_value));
+
+    // Safari's 1000s sit between the periods but are not drawn, so the
+    // current peak of 30 sets the top of the chart
+    SeriesSet set;
+    AreaChartRenderer::prepareSeries(parser, set);
+    TEST_ASSERT_EQUAL(3, set.pointCount);
+    double offset, scale;
+    ChartScale::compute(0, 30, &offset, &scale);
+    TEST_ASSERT_EQUAL(lround(30 * scale), set.y[2]);
+    TEST_ASSERT_EQUAL(lround(25 * scale) - lround(30 * scale), set.compareDelta[2]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_previous_period_found_after_current);
+    RUN_TEST(test_previous_period_found_before_current);
+    RUN_TEST(test_compare_false_is_a_line_graph);
+    RUN_TEST(test_compare_without_previous_series_has_no_comparison);
+    RUN_TEST(test_area_range_covers_only_the_two_periods);
+    return UNITY_END();
+}
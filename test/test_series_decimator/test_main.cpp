@@ -0,0 +1,143 @@
+#include <unity.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "ui/renderers/SeriesDecimator.h"
+
+// A year of daily points onto the 230 px line graph, as a trends insight sends them
+static const size_t DAYS = 365;
+static const size_t WIDTH = 230;
+static const size_t SPIKE_DAY = 123;
+static const size_t DIP_DAY = 300;
+static const int32_t SPIKE = 99999;
+static const int32_t DIP = -5000;
+
+static std::vector<int32_t> yearWithOutliers() {
+    std::vector<int32_t> values(DAYS);
+    for (size_t i = 0; i < DAYS; i++) {
+        values[i] = 1000 + (int32_t)((i * 37) % 200);  // Noisy but bounded baseline
+    }
+    values[SPIKE_DAY] = SPIKE;
+    values[DIP_DAY] = DIP;
+    return values;
+}
+
+static size_t indexOf(const std::vector<int32_t>& values, size_t count, int32_t value) {
+    return std::find(values.begin(), values.begin() + count, value) - values.begin();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_year_decimates_to_chart_width_keeping_outliers() {
+    std::vector<int32_t> source = yearWithOutliers();
+    std::vector<int32_t> values = source;
+
+    size_t kept = SeriesDecimator::minMax(values.data(), DAYS, WIDTH);
+
+    TEST_ASSERT_EQUAL(WIDTH, kept);
+    size_t spike_at = indexOf(values, kept, SPIKE);
+    size_t dip_at = indexOf(values, kept, DIP);
+    TEST_ASSERT_TRUE(spike_at < kept);
+    TEST_ASSERT_TRUE(dip_at < kept);
+    TEST_ASSERT_TRUE(spike_at < dip_at);  // Still in time order
+
+    // Everything else is a real baseline value
+    for (size_t i = 0; i < kept; i++) {
+        if (i == spike_at || i == dip_at) continue;
+        TEST_ASSERT_TRUE(values[i] >= 1000 && values[i] < 1200);
+    }
+}
+
+void test_kept_pairs_are_bucket_extremes() {
+    std::vector<int32_t> source = yearWithOutliers();
+    std::vector<int32_t> values = source;
+
+    size_t kept = SeriesDecimator::minMax(values.data(), DAYS, WIDTH);
+
+    const size_t buckets = WIDTH / 2;
+    for (size_t b = 0; b < buckets; b++) {
+        auto start = source.begin() + b * DAYS / buckets;
+        auto end = source.begin() + (b + 1) * DAYS / buckets;
+        TEST_ASSERT_EQUAL(*std::min_element(start, end), std::min(values[2 * b], values[2 * b + 1]));
+        TEST_ASSERT_EQUAL(*std::max_element(start, end), std::max(values[2 * b], values[2 * b + 1]));
+    }
+    TEST_ASSERT_EQUAL(2 * buckets, kept);
+}
+
+void test_series_that_fit_are_untouched() {
+    std::vector<int32_t> source = yearWithOutliers();
+    std::vector<int32_t> values = source;
+    std::vector<int32_t> other = source;
+    std::vector<uint16_t> x(WIDTH);
+
+    TEST_ASSERT_EQUAL(WIDTH, SeriesDecimator::minMax(values.data(), WIDTH, WIDTH));
+    TEST_ASSERT_TRUE(std::equal(values.begin(), values.end(), source.begin()));
+    TEST_ASSERT_EQUAL(100, SeriesDecimator::minMaxPair(values.data(), other.data(), 100, WIDTH, x.data()));
+    TEST_ASSERT_EQUAL(99, x[99]);
+}
+
+void test_pair_keeps_outliers_of_either_series_aligned() {
+    // Current period carries the spike, previous period the dip
+    std::vector<int32_t> current = yearWithOutliers();
+    std::vector<int32_t> previous = current;
+    current[DIP_DAY] = 1100;
+    previous[SPIKE_DAY] = 1100;
+    std::vector<int32_t> current_source = current;
+    std::vector<int32_t> previous_source = previous;
+    std::vector<uint16_t> x(WIDTH);
+
+    size_t kept = SeriesDecimator::minMaxPair(current.data(), previous.data(), DAYS, WIDTH, x.data());
+
+    TEST_ASSERT_EQUAL(WIDTH, kept);
+    TEST_ASSERT_TRUE(indexOf(current, kept, SPIKE) < kept);
+    TEST_ASSERT_TRUE(indexOf(previous, kept, DIP) < kept);
+    for (size_t i = 0; i < kept; i++) {
+        TEST_ASSERT_EQUAL(current_source[x[i]], current[i]);
+        TEST_ASSERT_EQUAL(previous_source[x[i]], previous[i]);
+    }
+}
+
+// Mean time to reduce a year to the chart width, copy of the source included
+template <typename Decimate>
+static double microsPerSeries(Decimate decimate) {
+    const int runs = 2000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        TEST_ASSERT_EQUAL(WIDTH, decimate());
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / runs;
+}
+
+void test_year_decimation_time() {
+    const std::vector<int32_t> source = yearWithOutliers();
+    std::vector<int32_t> a(DAYS), b(DAYS);
+    std::vector<uint16_t> x(WIDTH);
+
+    double single_us = microsPerSeries([&]() {
+        std::copy(source.begin(), source.end(), a.begin());
+        return SeriesDecimator::minMax(a.data(), DAYS, WIDTH);
+    });
+    double pair_us = microsPerSeries([&]() {
+        std::copy(source.begin(), source.end(), a.begin());
+        std::copy(source.begin(), source.end(), b.begin());
+        return SeriesDecimator::minMaxPair(a.data(), b.data(), DAYS, WIDTH, x.data());
+    });
+    printf("[Bench] %u -> %u points: minMax %.2f us, minMaxPair %.2f us\n",
+           (unsigned)DAYS, (unsigned)WIDTH, single_us, pair_us);
+
+    // One linear pass; a generous bound that still catches an accidental quadratic
+    TEST_ASSERT_TRUE(single_us < 50.0);
+    TEST_ASSERT_TRUE(pair_us < 50.0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_year_decimates_to_chart_width_keeping_outliers);
+    RUN_TEST(test_kept_pairs_are_bucket_extremes);
+    RUN_TEST(test_series_that_fit_are_untouched);
+    RUN_TEST(test_pair_keeps_outliers_of_either_series_aligned);
+    RUN_TEST(test_year_decimation_time);
+    return UNITY_END();
+}
@@ -0,0 +1,152 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "ui/renderers/SeriesPacker.h"
+#include "ui/renderers/ChartScale.h"
+
+// Trends responses with one series object per event or breakdown value
+static std::string trendsJson(const std::vector<std::vector<double>>& series) {
+    std::string json = "{\"results\":[{\"name\":\"Trends\",\"query\":{\"display\":\"ActionsLineGraph\"},\"result\":[";
+    for (size_t s = 0; s < series.size(); s++) {
+        if (s > 0) json += ",";
+        json += "{\"label\":\"Series " + std::to_string(s) + "\",\"data\":[";
+        for (size_t i = 0; i < series[s].size(); i++) {
+            if (i > 0) json += ",";
+            char value[32];
+            snprintf(value, sizeof(value), "%g", series[s][i]);
+            json += value;
+        }
+        json += "]";
+        if (s == 0) {
+            // Only the first series' days are read; the rest would just fill the document
+            json += ",\"days\":[";
+            for (size_t i = 0; i < series[s].size(); i++) {
+                if (i > 0) json += ",";
+                char day[16];
+                snprintf(day, sizeof(day), "\"2024-%02u-%02u\"", (unsigned)(1 + i / 28 % 12), (unsigned)(1 + i % 28));
+                json += day;
+            }
+            json += "]";
+        }
+        json += "}";
+    }
+    return json + "]}]}";
+}
+
+// Chart units for value under the scale ChartScale picks for [min, max]
+static int32_t chartValue(double value, double min_value, double max_value) {
+    double offset, scale;
+    ChartScale::compute(min_value, max_value, &offset, &scale);
+    return (int32_t)lround((value - offset) * scale);
+}
+
+static bool pack(const std::vector<std::vector<double>>& series, SeriesSet& set, size_t max_points = 230) {
+    std::string json = trendsJson(series);
+    InsightParser parser(json.c_str());
+    TEST_ASSERT_TRUE(parser.isValid());
+    TEST_ASSERT_TRUE(parser.getInsightType() == InsightParser::InsightType::LINE_GRAPH);
+    return SeriesPacker::packLines(parser, set, max_points);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_single_series() {
+    SeriesSet set;
+    TEST_ASSERT_TRUE(pack({{0, 5, 10, 5}}, set));
+
+    TEST_ASSERT_EQUAL(1, set.seriesCount);
+    TEST_ASSERT_EQUAL(4, set.pointCount);
+    TEST_ASSERT_EQUAL(4, set.y.size());
+    TEST_ASSERT_EQUAL_STRING("Series 0", set.labels[0]);
+    TEST_ASSERT_EQUAL(0, set.series(0)[0]);
+    TEST_ASSERT_EQUAL(chartValue(10, 0, 10), set.series(0)[2]);
+}
+
+void test_three_series_pack_back_to_back_over_one_range() {
+    SeriesSet set;
+    TEST_ASSERT_TRUE(pack({{-10, 0, 10}, {5, 15, 25}, {40, 20, 0}}, set));
+
+    TEST_ASSERT_EQUAL(3, set.seriesCount);
+    TEST_ASSERT_EQUAL(3, set.pointCount);
+    TEST_ASSERT_EQUAL(9, set.y.size());
+    TEST_ASSERT_EQUAL_STRING("Series 2", set.labels[2]);
+
+    // Every series is scaled by the range of all three
+    TEST_ASSERT_EQUAL(0, set.series(0)[0]);
+    TEST_ASSERT_EQUAL(chartValue(0, -10, 40), set.series(0)[1]);
+    TEST_ASSERT_EQUAL(chartValue(15, -10, 40), set.series(1)[1]);
+    TEST_ASSERT_EQUAL(chartValue(40, -10, 40), set.series(2)[0]);
+    TEST_ASSERT_TRUE(set.series(2) == set.y.data() + 6);
+}
+
+void test_series_beyond_the_cap_are_dropped_from_set_and_range() {
+    std::vector<std::vector<double>> series;
+    for (size_t s = 0; s < SeriesSet::MAX_SERIES + 2; s++) {
+        series.push_back({(double)s, (double)s + 1});
+    }
+    series.back() = {1000, -1000};  // Would flatten every other series if it counted
+
+    SeriesSet set;
+    TEST_ASSERT_TRUE(pack(series, set));
+
+    double top = (double)SeriesSet::MAX_SERIES;
+    TEST_ASSERT_EQUAL(SeriesSet::MAX_SERIES, set.seriesCount);
+    TEST_ASSERT_EQUAL(SeriesSet::MAX_SERIES * 2, set.y.size());
+    TEST_ASSERT_EQUAL(0, set.series(0)[0]);
+    TEST_ASSERT_EQUAL(chartValue(top, 0, top), set.series(SeriesSet::MAX_SERIES - 1)[1]);
+}
+
+void test_long_series_decimate_together() {
+    std::vector<std::vector<double>> series(3, std::vector<double>(300, 10));
+    series[2][250] = 500;  // Spike in the last series must survive its compaction
+
+    SeriesSet set;
+    TEST_ASSERT_TRUE(pack(series, set, 230));
+
+    TEST_ASSERT_EQUAL(230, set.pointCount);
+    TEST_ASSERT_EQUAL(3 * 230, set.y.size());
+    int32_t peak = 0;
+    for (uint16_t i = 0; i < set.pointCount; i++) {
+        TEST_ASSERT_EQUAL(chartValue(10, 0, 500), set.series(0)[i]);
+        peak = std::max(peak, set.series(2)[i]);
+    }
+    TEST_ASSERT_EQUAL(chartValue(500, 0, 500), peak);
+}
+
+void test_uneven_series_are_cut_or_padded_to_the_first() {
+    SeriesSet set;
+    TEST_ASSERT_TRUE(pack({{-10, 0, 10, 20}, {1, 2, 3, 4, 5, 6}, {7, 8}}, set));
+
+    TEST_ASSERT_EQUAL(3, set.seriesCount);
+    TEST_ASSERT_EQUAL(4, set.pointCount);
+    TEST_ASSERT_EQUAL(chartValue(4, -10, 20), set.series(1)[3]);
+    TEST_ASSERT_EQUAL(chartValue(8, -10, 20), set.series(2)[1]);
+    TEST_ASSERT_EQUAL(chartValue(0, -10, 20), set.series(2)[2]);  // Padded on the baseline
+    TEST_ASSERT_EQUAL(chartValue(0, -10, 20), set.series(2)[3]);
+}
+
+void test_unusable_input_leaves_set_empty() {
+    std::string json = "{\"results\":[{\"name\":\"Number\",\"query\":{\"display\":\"BoldNumber\"},"
+                       "\"result\":[{\"aggregated_value\":42}]}]}";
+    InsightParser parser(json.c_str());
+    SeriesSet set;
+    set.seriesCount = 2;
+    TEST_ASSERT_FALSE(SeriesPacker::packLines(parser, set, 230));
+    TEST_ASSERT_TRUE(set.empty());
+    TEST_ASSERT_EQUAL(0, set.y.size());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_single_series);
+    RUN_TEST(test_three_series_pack_back_to_back_over_one_range);
+    RUN_TEST(test_series_beyond_the_cap_are_dropped_from_set_and_range);
+    RUN_TEST(test_long_series_decimate_together);
+    RUN_TEST(test_uneven_series_are_cut_or_padded_to_the_first);
+    RUN_TEST(test_unusable_input_leaves_set_empty);
+    return UNITY_END();
+}
@@ -0,0 +1,156 @@
+#include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include "ui/UICallback.h"
+
+// Count every heap operation in the process so dispatch paths can be compared.
+// Kept out of line so GCC does not flag the inlined malloc/free as mismatched.
+static std::atomic<uint32_t> heap_ops(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    heap_ops.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+__attribute__((noinline)) void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    heap_ops.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+    if (ptr) heap_ops.fetch_add(1, std::memory_order_relaxed);
+    free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept {
+    if (ptr) heap_ops.fetch_add(1, std::memory_order_relaxed);
+    free(ptr);
+}
+
+namespace {
+
+// Dispatches per timed run; enough to swamp timer resolution on the host
+constexpr uint32_t ITERATIONS = 200000;
+
+// What a typical card update captures: this, a value and a short label
+struct Capture {
+    void* owner;
+    double value;
+    char label[24];
+};
+
+volatile double sink;
+
+struct Result {
+    double nsPerDispatch;
+    double heapOpsPerDispatch;
+    double heapOpsPerSecond;
+};
+
+template <typename Dispatch>
+Result measure(Dispatch dispatch) {
+    uint32_t ops_before = heap_ops.load();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        dispatch(i);
+    }
+    double elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    uint32_t ops = heap_ops.load() - ops_before;
+
+    Result result;
+    result.nsPerDispatch = elapsed_ns / ITERATIONS;
+    result.heapOpsPerDispatch = (double)ops / ITERATIONS;
+    result.heapOpsPerSecond = ops / (elapsed_ns / 1e9);
+    return result;
+}
+
+void report(const char* name, const Result& result) {
+    printf("  %-22s %8.1f ns/dispatch  %5.2f heap ops/dispatch  %10.0f heap ops/s\n",
+           name, result.nsPerDispatch, result.heapOpsPerDispatch, result.heapOpsPerSecond);
+}
+
+} // namespace
+
+void setUp() {
+    UICallbackPool::begin();
+}
+
+void tearDown() {}
+
+void test_pooled_dispatch_does_not_touch_heap() {
+    Capture capture = {nullptr, 1.0, "Pageviews"};
+    Result pooled = measure([&capture](uint32_t i) {
+        capture.value = i;
+        UICallback* callback = UICallbackPool::make([capture]() { sink = capture.value; });
+        callback->execute();
+        UICallbackPool::release(callback);
+    });
+    report("UICallbackPool", pooled);
+
+    TEST_ASSERT_TRUE(pooled.heapOpsPerDispatch == 0.0);
+}
+
+void test_std_function_dispatch_baseline() {
+    // The path globalUIDispatch takes: the closure becomes a std::function,
+    // which is then wrapped again for the queue
+    Capture capture = {nullptr, 1.0, "Pageviews"};
+    Result baseline = measure([&capture](uint32_t i) {
+        capture.value = i;
+        std::function<void()> func = [capture]() { sink = capture.value; };
+        std::function<void()>* queued = new std::function<void()>([func = std::move(func)]() { func(); });
+        (*queued)();
+        delete queued;
+    });
+    report("std::function + new", baseline);
+
+    // Each wrap of the 40-byte capture allocates and frees
+    TEST_ASSERT_TRUE(baseline.heapOpsPerDispatch >= 4.0);
+}
+
+void test_oversize_closure_falls_back_once_and_is_counted() {
+    UICallbackPool::Stats before = UICallbackPool::getStats();
+    struct Big { char bytes[UICallback::INLINE_CAPACITY + 8]; } big = {};
+
+    uint32_t ops_before = heap_ops.load();
+    UICallback* callback = UICallbackPool::make([big]() { sink = big.bytes[0]; });
+    TEST_ASSERT_NOT_NULL(callback);
+    callback->execute();
+    UICallbackPool::release(callback);
+
+    TEST_ASSERT_EQUAL(2, heap_ops.load() - ops_before);  // One new, one delete
+    TEST_ASSERT_EQUAL(before.heapFallbacks + 1, UICallbackPool::getStats().heapFallbacks);
+}
+
+void test_exhausted_pool_falls_back_and_tracks_high_water() {
+    UICallbackPool::Stats before = UICallbackPool::getStats();
+    UICallback* held[UICallbackPool::CAPACITY + 1];
+    for (size_t i = 0; i <= UICallbackPool::CAPACITY; i++) {
+        held[i] = UICallbackPool::acquire();
+        TEST_ASSERT_NOT_NULL(held[i]);
+    }
+
+    UICallbackPool::Stats full = UICallbackPool::getStats();
+    TEST_ASSERT_EQUAL(UICallbackPool::CAPACITY, full.inUse);
+    TEST_ASSERT_EQUAL(UICallbackPool::CAPACITY, full.highWater);
+    TEST_ASSERT_EQUAL(before.poolExhausted + 1, full.poolExhausted);
+
+    for (size_t i = 0; i <= UICallbackPool::CAPACITY; i++) {
+        UICallbackPool::release(held[i]);
+    }
+    TEST_ASSERT_EQUAL(0, UICallbackPool::getStats().inUse);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pooled_dispatch_does_not_touch_heap);
+    RUN_TEST(test_std_function_dispatch_baseline);
+    RUN_TEST(test_oversize_closure_falls_back_once_and_is_counted);
+    RUN_TEST(test_exhausted_pool_falls_back_and_tracks_high_water);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "ui/UIUpdateQueue.h"
+
+namespace {
+
+int owner_a;
+int owner_b;
+std::atomic<int> last_value_a;
+std::atomic<int> last_value_b;
+std::atomic<int> runs_a;
+std::atomic<int> runs_b;
+std::atomic<int> unkeyed_runs;
+
+UIUpdateQueue* queue;
+
+bool pushUnkeyed() {
+    UICallback* callback = UICallbackPool::make([]() { unkeyed_runs++; });
+    return queue->push(callback, UIUpdateKey(), false);
+}
+
+bool pushKeyed(int* owner, int value) {
+    UICallback* callback = UICallbackPool::make([owner, value]() {
+        if (owner == &owner_a) {
+            last_value_a = value;
+            runs_a++;
+        } else {
+            last_value_b = value;
+            runs_b++;
+        }
+    });
+    return queue->push(callback, UIUpdateKey(owner, 1), false);
+}
+
+size_t drain() {
+    size_t count = 0;
+    UICallback* callback;
+    while ((callback = queue->pop()) != nullptr) {
+        callback->execute();
+        UICallbackPool::release(callback);
+        count++;
+    }
+    return count;
+}
+
+}  // namespace
+
+void setUp() {
+    queue = new UIUpdateQueue();
+    last_value_a = 0;
+    last_value_b = 0;
+    runs_a = 0;
+    runs_b = 0;
+    unkeyed_runs = 0;
+}
+
+void tearDown() {
+    delete queue;
+}
+
+void test_keyed_update_coalesces() {
+    TEST_ASSERT_TRUE(pushKeyed(&owner_a, 1));
+    TEST_ASSERT_TRUE(pushUnkeyed());
+    TEST_ASSERT_TRUE(pushKeyed(&owner_a, 2));
+    TEST_ASSERT_EQUAL(2, queue->size());
+
+    drain();
+    TEST_ASSERT_EQUAL(1, runs_a.load());
+    TEST_ASSERT_EQUAL(2, last_value_a.load());
+}
+
+void test_structural_work_survives_keyed_push_when_full() {
+    // Unkeyed work fills its share of the ring; none of it may be dropped
+    const size_t structural = UIUpdateQueue::CAPACITY - UIUpdateQueue::KEYED_RESERVE;
+    for (size_t i = 0; i < structural; i++) {
+        TEST_ASSERT_TRUE(pushUnkeyed());
+    }
+    TEST_ASSERT_FALSE(pushUnkeyed());
+
+    TEST_ASSERT_TRUE(pushKeyed(&owner_a, 7));
+    TEST_ASSERT_TRUE(pushKeyed(&owner_a, 8));
+    TEST_ASSERT_EQUAL(structural + 1, queue->size());
+
+    drain();
+    TEST_ASSERT_EQUAL(structural, unkeyed_runs.load());
+    TEST_ASSERT_EQUAL(1, runs_a.load());
+    TEST_ASSERT_EQUAL(8, last_value_a.load());
+}
+
+void test_keyed_updates_cannot_displace_structural_work() {
+    // Once the ring is full a keyed push is rejected rather than evicting
+    const size_t structural = UIUpdateQueue::CAPACITY - UIUpdateQueue::KEYED_RESERVE;
+    static int owners[UIUpdateQueue::KEYED_RESERVE];
+    for (size_t i = 0; i < structural; i++) {
+        TEST_ASSERT_TRUE(pushUnkeyed());
+    }
+    for (size_t i = 0; i < UIUpdateQueue::KEYED_RESERVE; i++) {
+        UICallback* callback = UICallbackPool::make([]() {});
+        TEST_ASSERT_TRUE(queue->push(callback, UIUpdateKey(&owners[i], 1), false));
+    }
+    TEST_ASSERT_FALSE(pushKeyed(&owner_a, 1));
+
+    drain();
+    TEST_ASSERT_EQUAL(structural, unkeyed_runs.load());
+    TEST_ASSERT_EQUAL(0, runs_a.load());
+}
+
+void test_full_queue_of_keyed_updates_rejects() {
+    // Every slot is someone's newest state, so there is nowhere to put it
+    static int owners[UIUpdateQueue::CAPACITY];
+    for (size_t i = 0; i < UIUpdateQueue::CAPACITY; i++) {
+        UICallback* callback = UICallbackPool::make([]() {});
+        TEST_ASSERT_TRUE(queue->push(callback, UIUpdateKey(&owners[i], 1), false));
+    }
+    TEST_ASSERT_FALSE(pushKeyed(&owner_a, 1));
+    TEST_ASSERT_EQUAL(UIUpdateQueue::CAPACITY, queue->size());
+    drain();
+}
+
+void test_cancel_removes_owner_entries() {
+    pushKeyed(&owner_a, 1);
+    pushUnkeyed();
+    pushKeyed(&owner_b, 2);
+    TEST_ASSERT_EQUAL(1, queue->cancel(&owner_a));
+
+    drain();
+    TEST_ASSERT_EQUAL(0, runs_a.load());
+    TEST_ASSERT_EQUAL(1, runs_b.load());
+    TEST_ASSERT_EQUAL(1, unkeyed_runs.load());
+}
+
+void test_two_producer_flood_keeps_newest_keyed_state() {
+    // Producer A floods plain FIFO work until the ring is full while producer B
+    // keeps publishing newer state for one widget; a consumer drains slowly.
+    const int FLOOD = 20000;
+    const int UPDATES = 5000;
+    std::atomic<bool> producing(true);
+    std::atomic<int> rejected_keyed(0);
+
+    std::thread flooder([&]() {
+        for (int i = 0; i < FLOOD; i++) {
+            pushUnkeyed();
+        }
+    });
+    std::thread publisher([&]() {
+        for (int value = 1; value <= UPDATES; value++) {
+            if (!pushKeyed(&owner_b, value)) {
+                rejected_keyed++;
+            }
+        }
+    });
+    std::thread consumer([&]() {
+        while (producing) {
+            UICallback* callback = queue->pop();
+            if (callback) {
+                callback->execute();
+                UICallbackPool::release(callback);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    flooder.join();
+    publisher.join();
+    producing = false;
+    consumer.join();
+    drain();
+
+    TEST_ASSERT_EQUAL(0, rejected_keyed.load());
+    TEST_ASSERT_EQUAL(UPDATES, last_value_b.load());
+    TEST_ASSERT_EQUAL(0, queue->size());
+}
+
+int main() {
+    UICallbackPool::begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_keyed_update_coalesces);
+    RUN_TEST(test_structural_work_survives_keyed_push_when_full);
+    RUN_TEST(test_keyed_updates_cannot_displace_structural_work);
+    RUN_TEST(test_full_queue_of_keyed_updates_rejects);
+    RUN_TEST(test_cancel_removes_owner_entries);
+    RUN_TEST(test_two_producer_flood_keeps_newest_keyed_state);
+    return UNITY_END();
+}